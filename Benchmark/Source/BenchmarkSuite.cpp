@@ -0,0 +1,175 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#include "BenchmarkSuite.h"
+
+#include <iostream>
+
+
+static constexpr double MinSampleDuration = 0.01; // Minimum duration of one sample in seconds, used for calibration.
+static constexpr int MaxIterationsPerSample = 1 << 24; // Upper limit of the calibrated iterations per sample.
+
+
+//==============================================================================
+// Class BenchmarkSuite
+//==============================================================================
+
+BenchmarkSuite::BenchmarkSuite(int numSamples, const juce::String& filter)
+    :   m_numSamples(juce::jmax(1, numSamples)),
+        m_filter(filter),
+        m_sink(0)
+{
+}
+
+void BenchmarkSuite::Add(const juce::String& name, BenchmarkFunction function)
+{
+    jassert(std::none_of(m_benchmarks.begin(), m_benchmarks.end(), 
+                         [&name](const auto& benchmark) { return benchmark.first == name; })); // Names must be unique!
+
+    m_benchmarks.emplace_back(name, std::move(function));
+}
+
+void BenchmarkSuite::Run()
+{
+    m_results.clear();
+
+    for (const auto& benchmark : m_benchmarks)
+    {
+        if (m_filter.isNotEmpty() && !benchmark.first.containsIgnoreCase(m_filter))
+            continue;
+
+        std::cerr << benchmark.first << "..." << std::endl;
+
+        // Double the number of iterations until one sample takes long enough to be measured reliably.
+        // This also serves as warm-up.
+        int numIterations(1);
+        while ((Measure(benchmark.second, numIterations) < MinSampleDuration * 1e9) && 
+               (numIterations < MaxIterationsPerSample))
+        {
+            numIterations *= 2;
+        }
+
+        std::vector<double> samples;
+        samples.reserve(static_cast<size_t>(m_numSamples));
+        for (int i = 0; i < m_numSamples; i++)
+            samples.push_back(Measure(benchmark.second, numIterations) / numIterations);
+
+        std::sort(samples.begin(), samples.end());
+
+        Result result;
+        result.m_name = benchmark.first;
+        result.m_medianNsPerIteration = samples[samples.size() / 2];
+        result.m_minNsPerIteration = samples.front();
+        result.m_iterationsPerSample = numIterations;
+        result.m_numSamples = m_numSamples;
+        m_results.push_back(result);
+    }
+
+    // Makes the accumulated values observable, so that no benchmark can be optimized away.
+    if (m_sink == 0)
+        std::cerr << "(no benchmark produced any output)" << std::endl;
+}
+
+const std::vector<BenchmarkSuite::Result>& BenchmarkSuite::GetResults() const
+{
+    return m_results;
+}
+
+juce::var BenchmarkSuite::ToJson() const
+{
+    juce::Array<juce::var> results;
+    for (const auto& result : m_results)
+    {
+        auto resultObject = new juce::DynamicObject();
+        resultObject->setProperty("name", result.m_name);
+        resultObject->setProperty("medianNs", result.m_medianNsPerIteration);
+        resultObject->setProperty("minNs", result.m_minNsPerIteration);
+        resultObject->setProperty("iterations", result.m_iterationsPerSample);
+        results.add(juce::var(resultObject));
+    }
+
+    auto rootObject = new juce::DynamicObject();
+    rootObject->setProperty("version", ProjectInfo::versionString);
+    rootObject->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+    rootObject->setProperty("samples", m_numSamples);
+    rootObject->setProperty("results", results);
+
+    return juce::var(rootObject);
+}
+
+int BenchmarkSuite::CompareWithBaseline(const juce::var& baseline, double thresholdPercent) const
+{
+    auto baselineResults = baseline.getProperty("results", juce::var());
+    if (!baselineResults.isArray())
+    {
+        std::cerr << "Baseline contains no results." << std::endl;
+        return 0;
+    }
+
+    int numRegressions(0);
+    for (const auto& result : m_results)
+    {
+        const juce::var* baselineResult = nullptr;
+        for (const auto& candidate : *baselineResults.getArray())
+        {
+            if (candidate.getProperty("name", juce::var()).toString() == result.m_name)
+            {
+                baselineResult = &candidate;
+                break;
+            }
+        }
+
+        if (baselineResult == nullptr)
+        {
+            std::cerr << result.m_name << ": not in baseline" << std::endl;
+            continue;
+        }
+
+        double baselineNs = baselineResult->getProperty("medianNs", 0.0);
+        if (baselineNs <= 0.0)
+            continue;
+
+        double threshold = baselineResult->getProperty("threshold", thresholdPercent);
+        double changePercent = (result.m_medianNsPerIteration - baselineNs) * 100.0 / baselineNs;
+        bool regressed = (changePercent > threshold);
+        if (regressed)
+            numRegressions++;
+
+        std::cerr << result.m_name << ": " 
+                  << juce::String(baselineNs, 1) << " ns -> " << juce::String(result.m_medianNsPerIteration, 1) << " ns ("
+                  << (changePercent >= 0.0 ? "+" : "") << juce::String(changePercent, 1) << "%)"
+                  << (regressed ? " REGRESSION" : "") << std::endl;
+    }
+
+    return numRegressions;
+}
+
+double BenchmarkSuite::Measure(const BenchmarkFunction& function, int numIterations)
+{
+    auto startTicks = juce::Time::getHighResolutionTicks();
+    m_sink += function(numIterations);
+    auto endTicks = juce::Time::getHighResolutionTicks();
+
+    return juce::Time::highResolutionTicksToSeconds(endTicks - startTicks) * 1e9;
+}
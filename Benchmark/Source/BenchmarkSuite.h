@@ -0,0 +1,132 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+
+/**
+ * Runs a set of named microbenchmarks and reports their results as JSON.
+ * Each benchmark is a function which executes the measured code a given number of times. 
+ * It is first calibrated to run for at least MinSampleDuration per sample, and then sampled 
+ * a number of times, of which the median time per iteration is reported.
+ * Results can be compared against a baseline, which is simply a previously written results file.
+ */
+class BenchmarkSuite
+{
+public:
+    /**
+     * Measured code of a benchmark.
+     *
+     * @param[in] numIterations Number of times to execute the measured code.
+     * @return  Any value derived from the results of the measured code, which is accumulated
+     *          so that the compiler can not optimize the measured code away.
+     */
+    using BenchmarkFunction = std::function<std::size_t(int numIterations)>;
+
+    /**
+     * Result of one benchmark.
+     */
+    struct Result
+    {
+        juce::String m_name;
+        double m_medianNsPerIteration = 0.0;
+        double m_minNsPerIteration = 0.0;
+        int m_iterationsPerSample = 0;
+        int m_numSamples = 0;
+    };
+
+    /**
+     * @param[in] numSamples    Number of samples taken of each benchmark.
+     * @param[in] filter        Only benchmarks whose name contains this text are run. Empty to run all.
+     */
+    BenchmarkSuite(int numSamples, const juce::String& filter);
+
+    /**
+     * Add a benchmark to the suite.
+     *
+     * @param[in] name      Unique name of the benchmark, i.e. "Encode/OcaFloat32".
+     * @param[in] function  Measured code. See BenchmarkFunction.
+     */
+    void Add(const juce::String& name, BenchmarkFunction function);
+
+    /**
+     * Run all added benchmarks which match the filter, in the order they were added.
+     * The name of each benchmark is logged to stderr as it runs.
+     */
+    void Run();
+
+    /**
+     * Get the results of the last Run.
+     *
+     * @return  One result per benchmark that was run.
+     */
+    const std::vector<Result>& GetResults() const;
+
+    /**
+     * Create the JSON representation of the results of the last Run.
+     *
+     * @return  Object containing the "version", "date", "samples" and "results" of the run.
+     */
+    juce::var ToJson() const;
+
+    /**
+     * Compare the results of the last Run against a baseline, and log the relative change of each
+     * benchmark to stderr. Baseline results may define their own "threshold" in percent, which then 
+     * takes precedence over the given one, i.e. for benchmarks which are known to be noisy.
+     *
+     * @param[in] baseline          Contents of a results file, as created by ToJson.
+     * @param[in] thresholdPercent  Increase of the median time in percent which counts as a regression.
+     * @return  The number of benchmarks which regressed. Benchmarks missing in the baseline are ignored.
+     */
+    int CompareWithBaseline(const juce::var& baseline, double thresholdPercent) const;
+
+private:
+    /**
+     * Measure the time it takes to run a benchmark function.
+     *
+     * @param[in] function      Measured code.
+     * @param[in] numIterations Number of iterations to pass to the function.
+     * @return  The elapsed time in nanoseconds.
+     */
+    double Measure(const BenchmarkFunction& function, int numIterations);
+
+    // Benchmarks in the order they were added.
+    std::vector<std::pair<juce::String, BenchmarkFunction>> m_benchmarks;
+
+    // Results of the last Run.
+    std::vector<Result> m_results;
+
+    // Number of samples taken of each benchmark.
+    int m_numSamples;
+
+    // Only benchmarks whose name contains this text are run.
+    juce::String m_filter;
+
+    // Accumulates the values returned by all benchmark functions. See BenchmarkFunction.
+    std::size_t m_sink;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BenchmarkSuite)
+};
@@ -0,0 +1,421 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+
+#include "BenchmarkSuite.h"
+#include "../../Source/AES70.h"
+#include "../../Source/AES70Codec.h"
+#include "../../Source/AES70Schema.h"
+#include "../../Source/CommandModel.h"
+#include "../../Source/BinaryProjectFile.h"
+#include "../../Source/ConfigFileLoader.h"
+#include "../../Source/ConfigFileWriter.h"
+#include "../../Source/LatestValueStore.h"
+#include "../../Source/TimingWheel.h"
+
+
+static constexpr int DefaultNumSamples = 15; // Default number of samples taken of each benchmark.
+static constexpr int DefaultNumPages = 1000; // Default number of pages used for the load and save benchmarks.
+static constexpr double DefaultThresholdPercent = 10.0; // Default increase of the median time which counts as a regression.
+
+static constexpr int ExitCodeRegression = 1; // Exit code if any benchmark regressed compared to the baseline.
+static constexpr int ExitCodeInvalidArguments = 2; // Exit code if the arguments or the baseline file are invalid.
+
+
+/**
+ * Helper method to create a command node, as a StringGeneratorPage would store it in the CommandModel.
+ *
+ * @param[in] pageNumber    Number of the page, used for its name, ONo and handle.
+ * @return  Node of type CommandModel::CommandType for an OcaGain SetGain command.
+ */
+static juce::ValueTree CreateCommandNode(int pageNumber)
+{
+    juce::ValueTree command(CommandModel::CommandType);
+    command.setProperty(CommandModel::Name, "Page " + juce::String(pageNumber), nullptr);
+    command.setProperty(CommandModel::Class, AES70::Schema::GetInstance().GetClassText(AES70::OCA_GAIN), nullptr);
+    command.setProperty(CommandModel::Ono, juce::String(10000 + pageNumber), nullptr);
+    command.setProperty(CommandModel::Property, "4,1: Gain", nullptr);
+    command.setProperty(CommandModel::Command, "2: SetGain", nullptr);
+    command.setProperty(CommandModel::Handle, juce::String(pageNumber), nullptr);
+    command.setProperty(CommandModel::Status, "0: OK", nullptr);
+    command.setProperty(CommandModel::CmdValue, "-6.5", nullptr);
+
+    return command;
+}
+
+/**
+ * Helper method to create a command set with the given number of pages.
+ *
+ * @param[in] numPages  Number of command nodes to add.
+ * @return  Node of type CommandModel::CommandSetType.
+ */
+static juce::ValueTree CreateCommandSet(int numPages)
+{
+    juce::ValueTree commandSet(CommandModel::CommandSetType);
+    for (int i = 1; i <= numPages; i++)
+        commandSet.appendChild(CreateCommandNode(i), nullptr);
+
+    return commandSet;
+}
+
+/**
+ * Add the benchmarks of all hot paths of the string generation and decoding to the suite.
+ *
+ * @param[in] suite     Suite to add the benchmarks to.
+ * @param[in] numPages  Number of pages used for the load and save benchmarks.
+ * @param[in] tempDir   Directory in which files for the load benchmarks are created.
+ */
+static void AddBenchmarks(BenchmarkSuite& suite, int numPages, const juce::File& tempDir)
+{
+    // Property lists of all standard classes, as requested whenever a class is selected.
+    for (int classIdx = AES70::OCA_ROOT; classIdx < AES70::OCA_MAX_CLASS_IDX; classIdx++)
+    {
+        std::shared_ptr<AES70::OcaRoot> object(AES70::OcaRoot::Create(classIdx));
+        if (!object)
+            continue;
+
+        auto className = AES70::Schema::GetInstance().GetClass(classIdx)->m_name;
+        suite.Add("GetProperties/" + className, [object](int numIterations)
+        {
+            std::size_t ret(0);
+            for (int i = 0; i < numIterations; i++)
+                ret += object->GetProperties().size();
+            return ret;
+        });
+    }
+
+    // Class lookups, as done for every command when loading config files and resolving commands.
+    std::vector<juce::String> classTexts;
+    for (int classIdx = AES70::OCA_ROOT; classIdx <= AES70::Schema::GetInstance().GetNumClasses(); classIdx++)
+        classTexts.push_back(AES70::Schema::GetInstance().GetClassText(classIdx));
+    suite.Add("Schema/GetClassIdxFromName", [classTexts](int numIterations)
+    {
+        std::size_t ret(0);
+        for (int i = 0; i < numIterations; i++)
+            ret += static_cast<std::size_t>(AES70::OcaRoot::GetClassIdxFromName(classTexts[static_cast<std::size_t>(i) % classTexts.size()]));
+        return ret;
+    });
+
+    // Encoding of values of all supported data types, from the value strings stored in the CommandModel.
+    static const std::vector<std::pair<int, juce::String>> valuesPerDataType = {
+        { NanoOcp1::OCP1DATATYPE_BOOLEAN, "1: True" },
+        { NanoOcp1::OCP1DATATYPE_INT32, "-123456" },
+        { NanoOcp1::OCP1DATATYPE_UINT8, "2: Valid" },
+        { NanoOcp1::OCP1DATATYPE_UINT16, "3" },
+        { NanoOcp1::OCP1DATATYPE_UINT32, "4000000000" },
+        { NanoOcp1::OCP1DATATYPE_UINT64, "10000000000" },
+        { NanoOcp1::OCP1DATATYPE_FLOAT32, "-6.5" },
+        { NanoOcp1::OCP1DATATYPE_FLOAT64, "-6.25" },
+        { NanoOcp1::OCP1DATATYPE_STRING, "Benchmark string value" },
+        { NanoOcp1::OCP1DATATYPE_BLOB, "0102030405060708" },
+        { AES70::MakeListDataType(NanoOcp1::OCP1DATATYPE_STRING), "Off|Low|Medium|High" },
+        { AES70::MakeListDataType(NanoOcp1::OCP1DATATYPE_UINT32), "10001|10002|10003|10004|10005|10006|10007|10008" },
+        { AES70::MakeMapDataType(NanoOcp1::OCP1DATATYPE_UINT16, NanoOcp1::OCP1DATATYPE_STRING), "1=Off|2=Low|3=Medium|4=High" }
+    };
+    for (const auto& dataTypeAndValue : valuesPerDataType)
+    {
+        auto dataType = dataTypeAndValue.first;
+        auto valueString = dataTypeAndValue.second;
+        suite.Add("Encode/" + AES70::Schema::GetDataTypeName(dataType), [dataType, valueString](int numIterations)
+        {
+            std::size_t ret(0);
+            for (int i = 0; i < numIterations; i++)
+                ret += AES70::OcaRoot::CreateParamDataFromString(valueString, dataType).size();
+            return ret;
+        });
+
+        auto paramData = AES70::OcaRoot::CreateParamDataFromString(valueString, dataType);
+        suite.Add("Decode/" + AES70::Schema::GetDataTypeName(dataType), [dataType, paramData](int numIterations)
+        {
+            std::vector<int> dataTypes{ dataType };
+            juce::StringArray valueStrings;
+            std::size_t ret(0);
+            for (int i = 0; i < numIterations; i++)
+                ret += AES70::OcaRoot::CreateStringsFromParamData(paramData.data(), paramData.size(), dataTypes, valueStrings) ? 1 : 0;
+            return ret;
+        });
+    }
+
+    // Encoding of the largest possible blob, from hex text and from a memory-mapped file.
+    juce::MemoryBlock largeBlob(0xffff);
+    for (std::size_t i = 0; i < largeBlob.getSize(); i++)
+        largeBlob[i] = static_cast<char>(i);
+    auto blobFile = tempDir.getChildFile("Blob.bin");
+    blobFile.replaceWithData(largeBlob.getData(), largeBlob.getSize());
+    for (const auto& namedValue : { std::make_pair(juce::String("Encode/OcaBlob/64KB/Hex"), juce::String::toHexString(largeBlob.getData(), static_cast<int>(largeBlob.getSize()), 0)),
+                                    std::make_pair(juce::String("Encode/OcaBlob/64KB/File"), "@" + blobFile.getFullPathName()) })
+    {
+        auto valueString = namedValue.second;
+        suite.Add(namedValue.first, [valueString](int numIterations)
+        {
+            std::size_t ret(0);
+            for (int i = 0; i < numIterations; i++)
+                ret += AES70::OcaRoot::CreateParamDataFromString(valueString, NanoOcp1::OCP1DATATYPE_BLOB).size();
+            return ret;
+        });
+    }
+
+    // Typed encoding and decoding of a Response with value, minimum and maximum, i.e. OcaGain's GetGain.
+    suite.Add("Codec/Float32x3", [](int numIterations)
+    {
+        std::size_t ret(0);
+        float value(0.0f), minValue(0.0f), maxValue(0.0f);
+        for (int i = 0; i < numIterations; i++)
+        {
+            auto paramData = AES70::Encode(-6.5f, -120.0f, 10.0f);
+            ret += AES70::Decode(paramData.data(), paramData.size(), value, minValue, maxValue) ? paramData.size() : 0;
+        }
+        return ret;
+    });
+
+    // Construction of a complete Command PDU.
+    suite.Add("Ocp1CommandResponseRequired", [](int numIterations)
+    {
+        auto paramData = NanoOcp1::DataFromFloat(-6.5f);
+        std::size_t ret(0);
+        for (int i = 0; i < numIterations; i++)
+        {
+            NanoOcp1::Ocp1CommandDefinition commandDefinition(10001, NanoOcp1::OCP1DATATYPE_FLOAT32, 4, 2, 1, paramData);
+            std::uint32_t handle;
+            NanoOcp1::Ocp1CommandResponseRequired command(commandDefinition, handle);
+            ret += command.GetMemoryBlock().getSize();
+        }
+        return ret;
+    });
+
+    // Command, Response and Notification strings of a command node, as shown on pages and in the command table.
+    suite.Add("CommandModel/CreateBinaryStrings", [](int numIterations)
+    {
+        auto command = CreateCommandNode(1);
+        juce::MemoryBlock commandMemBlock, responseMemBlock, notificationMemBlock;
+        std::size_t ret(0);
+        for (int i = 0; i < numIterations; i++)
+        {
+            CommandModel::CreateBinaryStrings(command, commandMemBlock, responseMemBlock, notificationMemBlock);
+            ret += commandMemBlock.getSize();
+        }
+        return ret;
+    });
+
+    // Hex formatting of a PDU, as done for every displayed binary string.
+    suite.Add("HexFormat", [](int numIterations)
+    {
+        juce::MemoryBlock commandMemBlock, responseMemBlock, notificationMemBlock;
+        CommandModel::CreateBinaryStrings(CreateCommandNode(1), commandMemBlock, responseMemBlock, notificationMemBlock);
+        std::size_t ret(0);
+        for (int i = 0; i < numIterations; i++)
+            ret += static_cast<std::size_t>(juce::String::toHexString(commandMemBlock.getData(), static_cast<int>(commandMemBlock.getSize())).length());
+        return ret;
+    });
+
+    // Parsing of inbound PDUs, as received from a device.
+    juce::MemoryBlock responsePdu = NanoOcp1::Ocp1Response(1, 0, 1, NanoOcp1::DataFromFloat(-6.5f)).GetMemoryBlock();
+    juce::MemoryBlock notificationPdu = NanoOcp1::Ocp1Notification(10001, 4, 1, 1, NanoOcp1::DataFromFloat(-6.5f)).GetMemoryBlock();
+    for (const auto& namedPdu : { std::make_pair(juce::String("Parse/Response"), responsePdu),
+                                  std::make_pair(juce::String("Parse/Notification"), notificationPdu) })
+    {
+        auto pdu = namedPdu.second;
+        suite.Add(namedPdu.first, [pdu](int numIterations)
+        {
+            std::size_t ret(0);
+            for (int i = 0; i < numIterations; i++)
+            {
+                auto message = NanoOcp1::Ocp1Message::UnmarshalOcp1Message(pdu);
+                ret += (message != nullptr) ? 1 : 0;
+            }
+            return ret;
+        });
+    }
+
+    // In-place ingest of Notifications into the LatestValueStore, as done for the MonitorPage, 
+    // cycling through 128 subscribed sensor readings.
+    suite.Add("Ingest/Notification", [](int numIterations)
+    {
+        std::vector<juce::MemoryBlock> pdus;
+        for (std::uint32_t ono = 0; ono < 128; ono++)
+            pdus.push_back(NanoOcp1::Ocp1Notification(10001 + ono, 4, 1, 1, NanoOcp1::DataFromFloat(-6.5f)).GetMemoryBlock());
+
+        LatestValueStore store;
+        std::size_t ret(0);
+        for (int i = 0; i < numIterations; i++)
+        {
+            const auto& pdu = pdus[static_cast<std::size_t>(i) % pdus.size()];
+            AES70::ForEachNotification(pdu.getData(), pdu.getSize(), [&](const AES70::NotificationView& notification)
+            {
+                auto key = LatestValueStore::MakeKey(notification.m_emitterOno, notification.m_propDefLevel, notification.m_propIndex);
+                ret += store.Write(key, notification.m_valueData, notification.m_valueDataSize) ? 1 : 0;
+            });
+        }
+        return ret;
+    });
+
+    // Deadline tracking of Commands awaiting their Response, with 10000 in flight at any time:
+    // each iteration schedules one deadline, answers the oldest Command before its deadline, and advances by one tick.
+    suite.Add("TimingWheel/10000InFlight", [](int numIterations)
+    {
+        static constexpr int NumInFlight = 10000;
+        TimingWheel wheel(10);
+        std::vector<TimingWheel::TimerId> timerIds(NumInFlight, TimingWheel::InvalidTimerId);
+        std::size_t ret(0);
+        for (int i = 0; i < numIterations; i++)
+        {
+            auto nowMs = static_cast<std::uint64_t>(i) * 10;
+            auto& timerId = timerIds[static_cast<std::size_t>(i % NumInFlight)];
+            ret += wheel.Cancel(timerId) ? 1 : 0;
+            timerId = wheel.Schedule(static_cast<std::uint64_t>(i), nowMs + 3000000);
+            ret += static_cast<std::size_t>(wheel.Advance(nowMs, nullptr));
+        }
+        return ret;
+    });
+
+    // Saving and loading of config files, in both formats.
+    auto commandSet = CreateCommandSet(numPages);
+    auto commands = CommandModel::GetCommandProperties(commandSet);
+    auto pages = juce::String(numPages) + "Pages";
+    suite.Add("Xml/Save/" + pages, [commands](int numIterations)
+    {
+        std::size_t ret(0);
+        for (int i = 0; i < numIterations; i++)
+        {
+            juce::MemoryOutputStream stream;
+            ConfigFileWriter::WriteXml(ProjectInfo::versionString, "01.01.2024", commands, stream);
+            ret += stream.getDataSize();
+        }
+        return ret;
+    });
+    suite.Add("Binary/Save/" + pages, [commands](int numIterations)
+    {
+        std::size_t ret(0);
+        for (int i = 0; i < numIterations; i++)
+        {
+            juce::MemoryOutputStream stream;
+            BinaryProjectFile::Write(ProjectInfo::versionString, "01.01.2024", commands, stream);
+            ret += stream.getDataSize();
+        }
+        return ret;
+    });
+
+    auto xmlFile = tempDir.getChildFile("Benchmark.xml");
+    auto binaryFile = tempDir.getChildFile("Benchmark" + BinaryProjectFile::FileExtension);
+    {
+        juce::FileOutputStream xmlStream(xmlFile);
+        ConfigFileWriter::WriteXml(ProjectInfo::versionString, "01.01.2024", commands, xmlStream);
+
+        juce::FileOutputStream binaryStream(binaryFile);
+        BinaryProjectFile::Write(ProjectInfo::versionString, "01.01.2024", commands, binaryStream);
+    }
+    for (const auto& namedFile : { std::make_pair(juce::String("Xml/Load/"), xmlFile),
+                                   std::make_pair(juce::String("Binary/Load/"), binaryFile) })
+    {
+        auto file = namedFile.second;
+        suite.Add(namedFile.first + pages, [file](int numIterations)
+        {
+            std::size_t ret(0);
+            for (int i = 0; i < numIterations; i++)
+                ret += static_cast<std::size_t>(ConfigFileLoader::ReadConfigFile(file).getNumChildren());
+            return ret;
+        });
+    }
+}
+
+/**
+ * Prints the command line usage to stderr.
+ */
+static void PrintUsage()
+{
+    std::cerr << "Usage: AES70_OCP1_Benchmark [options]" << std::endl
+              << "  --output <file>       Write the results as JSON to the given file instead of stdout." << std::endl
+              << "  --baseline <file>     Compare the results against a previously written results file." << std::endl
+              << "  --threshold <percent> Increase of the median time which counts as a regression (default: "
+              << DefaultThresholdPercent << ")." << std::endl
+              << "  --samples <n>         Number of samples per benchmark (default: " << DefaultNumSamples << ")." << std::endl
+              << "  --pages <n>           Number of pages for the load and save benchmarks (default: " << DefaultNumPages << ")." << std::endl
+              << "  --filter <text>       Only run benchmarks whose name contains the given text." << std::endl;
+}
+
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+    if (args.containsOption("--help|-h"))
+    {
+        PrintUsage();
+        return 0;
+    }
+
+    auto numSamples = args.containsOption("--samples") ? args.getValueForOption("--samples").getIntValue() : DefaultNumSamples;
+    auto numPages = args.containsOption("--pages") ? args.getValueForOption("--pages").getIntValue() : DefaultNumPages;
+    auto thresholdPercent = args.containsOption("--threshold") ? args.getValueForOption("--threshold").getDoubleValue() : DefaultThresholdPercent;
+    if (numSamples <= 0 || numPages <= 0 || thresholdPercent < 0.0)
+    {
+        PrintUsage();
+        return ExitCodeInvalidArguments;
+    }
+
+    juce::var baseline;
+    if (args.containsOption("--baseline"))
+    {
+        auto baselineFile = args.getFileForOption("--baseline");
+        if (baselineFile.existsAsFile())
+            baseline = juce::JSON::parse(baselineFile);
+
+        if (!baseline.isObject())
+        {
+            std::cerr << "Invalid baseline file: " << baselineFile.getFullPathName() << std::endl;
+            return ExitCodeInvalidArguments;
+        }
+    }
+
+    auto tempDir = juce::File::getSpecialLocation(juce::File::tempDirectory).getNonexistentChildFile("AES70_OCP1_Benchmark", juce::String(), false);
+    tempDir.createDirectory();
+
+    BenchmarkSuite suite(numSamples, args.getValueForOption("--filter"));
+    AddBenchmarks(suite, numPages, tempDir);
+    suite.Run();
+
+    tempDir.deleteRecursively();
+
+    auto json = juce::JSON::toString(suite.ToJson());
+    if (args.containsOption("--output"))
+    {
+        auto outputFile = args.getFileForOption("--output");
+        if (!outputFile.replaceWithText(json))
+        {
+            std::cerr << "Could not write " << outputFile.getFullPathName() << std::endl;
+            return ExitCodeInvalidArguments;
+        }
+    }
+    else
+    {
+        std::cout << json << std::endl;
+    }
+
+    if (baseline.isObject() && suite.CompareWithBaseline(baseline, thresholdPercent) > 0)
+        return ExitCodeRegression;
+
+    return 0;
+}
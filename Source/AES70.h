@@ -32,7 +32,8 @@ namespace AES70
 {
 
 /**
- * Supported AES70 classes.
+ * Standard AES70 classes, as compiled into the Schema (See AES70Schema.h).
+ * Proprietary classes loaded from schema files get the indexes following OCA_AGENT.
  * NOTE: The assigned index numbers are arbitrary, are not defined in AES70, 
  *       are in no way related to their ClassID as defined in AES70.
  */
@@ -60,31 +61,6 @@ enum ClassIdx
     OCA_MAX_CLASS_IDX,
 };
 
-/**
- * Class IDs and names for all supported AES70 classes.
- */
-static const std::map<int, juce::String> MapOfClassNamesAndIds = {
-    { OCA_ROOT,                 "1: OcaRoot" },
-    { OCA_WORKER,               "1.1: OcaWorker" },
-    { OCA_ACTUATOR,             "1.1.1: OcaActuator" },
-    { OCA_BASIC_ACTUATOR,       "1.1.1.1: OcaBasicActuator" },
-    { OCA_INT32_ACTUATOR,       "1.1.1.1.4: OcaInt32Actuator" },
-    { OCA_STRING_ACTUATOR,      "1.1.1.1.12: OcaStringActuator" },
-    { OCA_MUTE,                 "1.1.1.2: OcaMute" },
-    { OCA_SWITCH,               "1.1.1.4: OcaSwitch" },
-    { OCA_GAIN,                 "1.1.1.5: OcaGain" },
-    { OCA_DELAY,                "1.1.1.7: OcaDelay" },
-    { OCA_SENSOR,               "1.1.2: OcaSensor" },
-    { OCA_BASIC_SENSOR,         "1.1.2.1: OcaBasicSensor" },
-    { OCA_BOOLEAN_SENSOR,       "1.1.2.1.1: OcaBooleanSensor" },
-    { OCA_INT32_SENSOR,         "1.1.2.1.4: OcaInt32Sensor" },
-    { OCA_FLOAT32_SENSOR,       "1.1.2.1.10: OcaFloat32Sensor" },
-    { OCA_STRING_SENSOR,        "1.1.2.1.12: OcaStringSensor" },
-    { OCA_LEVEL_SENSOR,         "1.1.2.2: OcaLevelSensor" },
-    { OCA_AUDIO_LEVEL_SENSOR,   "1.1.2.2.1: OcaAudioLevelSensor" },
-    { OCA_AGENT,                "1.2: OcaAgent" }
-};
-
 /**
  * AES70 Property
  */
@@ -99,16 +75,22 @@ struct Property
 };
 
 /**
- * OcaRoot
+ * An AES70 object. Its class, and with it the properties it has, is looked up in the Schema.
  */
 struct OcaRoot
 {
+    /**
+     * @param[in] classIdx  Index of the AES70 class within the Schema, based on the ClassIdx enum.
+     */
+    explicit OcaRoot(int classIdx = OCA_ROOT);
+    virtual ~OcaRoot() = default;
+
     /**
      * Factory method to create an OcaRoot-related object.
      *
-     * @param[in] classIdx  Index of AES70 class based on the ClassIdx enum.
-     * @return  A pointer to an OcaRoot-related object. NOTE: Ownership of the object
-     *          is responsibility of the caller of the method. 
+     * @param[in] classIdx  Index of AES70 class within the Schema, based on the ClassIdx enum.
+     * @return  A pointer to an OcaRoot-related object, or nullptr if the Schema has no such class. 
+     *          NOTE: Ownership of the object is responsibility of the caller of the method. 
      */
     static OcaRoot* Create(int classIdx);
 
@@ -123,12 +105,72 @@ struct OcaRoot
     /**
      * Helper method to obtain the AES70 class index which matches the class' name. 
      *
-     * @param[in] className Name of AES70 class.
-     * @return  Index of the corresponding AES70 class within the ClassIdx enum,
+     * @param[in] className Name of AES70 class, as given by Schema::GetClassText.
+     * @return  Index of the corresponding AES70 class within the Schema,
      *          or zero if no such class could be found.
      */
     static int GetClassIdxFromName(const juce::String& className);
 
+    /**
+     * Obtain the byte array used to represent a value in a AES70 OCP.1 message, based on the value's
+     * string representation as stored in config files (See StringGeneratorContainer::GetComponentValueAsString).
+     * Texts of ComboBox items such as "1: True" are interpreted by their leading number. For the value strings
+     * of blobs, lists and maps see ValueCodec.
+     *
+     * @param[in] valueString   String representation of the value.
+     * @param[in] dataType      NanoOcp1 data type of the property, i.e. NanoOcp1::OCP1DATATYPE_FLOAT32,
+     *                          or a list or map data type (See MakeListDataType).
+     * @param[out] errorMessage Optional description of why the value could not be encoded, i.e. because
+     *                          the file of a blob cannot be read (See ValueCodec::m_validate).
+     * @return  Byte array that can be used as parameter data for an OCP.1 message.
+     *          Empty if the data type is not supported, or the value could not be encoded.
+     */
+    static std::vector<std::uint8_t> CreateParamDataFromString(const juce::String& valueString, int dataType, juce::String* errorMessage = nullptr);
+
+    /**
+     * Obtain the byte array of several parameters of a AES70 OCP.1 message, i.e. the value, minimum and 
+     * maximum returned by OcaGain's GetGain. The array is sized exactly from the data types and values 
+     * up front, and each parameter is encoded directly into it.
+     *
+     * @param[in] valueStrings  String representations of the values, see CreateParamDataFromString.
+     * @param[in] dataTypes     NanoOcp1 data type of each value.
+     * @param[out] errorMessage Optional description of why a value could not be encoded, see CreateParamDataFromString.
+     * @return  Byte array that can be used as parameter data for an OCP.1 message.
+     *          Empty if any value could not be encoded.
+     */
+    static std::vector<std::uint8_t> CreateParamDataFromStrings(const juce::StringArray& valueStrings, 
+                                                                const std::vector<int>& dataTypes, 
+                                                                juce::String* errorMessage = nullptr);
+
+    /**
+     * Obtain the string representations of the parameters of a AES70 OCP.1 message, i.e. of a Response
+     * received from a device. This is the inverse of CreateParamDataFromStrings.
+     *
+     * @param[in] data          Pointer to the first byte of the parameter data.
+     * @param[in] size          Number of bytes of parameter data.
+     * @param[in] dataTypes     NanoOcp1 data type of each parameter.
+     * @param[out] valueStrings String representation of each parameter.
+     * @return  True if all parameters could be decoded. False if the data is too short, 
+     *          or a data type is not supported.
+     */
+    static bool CreateStringsFromParamData(const std::uint8_t* data, std::size_t size, const std::vector<int>& dataTypes, juce::StringArray& valueStrings);
+
+    /**
+     * Get the number of bytes used to represent a value in a AES70 OCP.1 message.
+     *
+     * @param[in] valueString   String representation of the value, see CreateParamDataFromString.
+     * @param[in] dataType      NanoOcp1 data type of the value.
+     * @return  Number of bytes. Zero if the data type is not supported.
+     */
+    static std::size_t GetParamDataSize(const juce::String& valueString, int dataType);
+
+    /**
+     * Get the index of this object's AES70 class within the Schema.
+     *
+     * @return  The class index, or zero for objects whose class is not in the Schema.
+     */
+    int GetClassIdx() const;
+
     /**
      * Definition level of the AES70 class, where OcaRoot is at level 1 and the level
      * increases with depth in the inheritance tree.
@@ -145,225 +187,8 @@ struct OcaRoot
      */
     virtual std::vector<Property> GetProperties() const;
 
-    /**
-     * Create a component which can be used to represent an AES70 class property on a GUI.
-     * 
-     * @param[in] prop  The class property, whose definition level, index, and data type define 
-     *                  how to best represent and allow users to set this property on a GUI.
-     * @param[in] onChangeFunction  Method which shall be called whenever the value on the created component changes.
-     * @return  A pointer to a juce::Component to be used on the GUI. 
-     *          NOTE: Ownership of the object is responsibility of the caller of the method. 
-     */
-    virtual juce::Component* CreateComponentForProperty(const Property& prop, const std::function<void()>& onChangeFunction);
-
-    /**
-     * Read the user value of the given GUI component, and obtain the byte array used to represent 
-     * this value in a AES70 OCP.1 message, based on the data type of the property.
-     * 
-     * @param[in] component The GUI component.
-     * @param[in] prop      The class property, whose definition level, index, and data type define 
-     *                      how the user value shall be interpreted for transmission.
-     * @return  Byte array that can be used as parameter data for an OCP.1 message.
-     */
-    virtual std::vector<std::uint8_t> CreateParamDataForComponent(const juce::Component* component, const AES70::Property& prop);
-};
-
-/**
- * OcaWorker
- */
-struct OcaWorker : public OcaRoot
-{
-    int DefLevel() const override;
-    std::vector<Property> GetProperties() const override;
-    juce::Component* CreateComponentForProperty(const Property& prop, const std::function<void()>& onChangeFunction) override;
-    std::vector<std::uint8_t> CreateParamDataForComponent(const juce::Component* component, const AES70::Property& prop) override;
-};
-
-/**
- * OcaActuator
- */
-struct OcaActuator : public OcaWorker
-{
-    int DefLevel() const override
-    {
-        return OcaWorker::DefLevel() + 1;
-    }
-};
-
-/**
- * OcaSwitch
- */
-struct OcaSwitch : public OcaActuator
-{
-    int DefLevel() const override;
-    std::vector<Property> GetProperties() const override;
-    juce::Component* CreateComponentForProperty(const Property& prop, const std::function<void()>& onChangeFunction) override;
-    std::vector<std::uint8_t> CreateParamDataForComponent(const juce::Component* component, const AES70::Property& prop) override;
-};
-
-/**
- * OcaMute
- */
-struct OcaMute : public OcaActuator
-{
-    int DefLevel() const override;
-    std::vector<Property> GetProperties() const override;
-    juce::Component* CreateComponentForProperty(const Property& prop, const std::function<void()>& onChangeFunction) override;
-    std::vector<std::uint8_t> CreateParamDataForComponent(const juce::Component* component, const AES70::Property& prop) override;
-};
-
-/**
- * OcaGain
- */
-struct OcaGain : public OcaActuator
-{
-    int DefLevel() const override;
-    std::vector<Property> GetProperties() const override;
-    juce::Component* CreateComponentForProperty(const Property& prop, const std::function<void()>& onChangeFunction) override;
-    std::vector<std::uint8_t> CreateParamDataForComponent(const juce::Component* component, const AES70::Property& prop) override;
-};
-
-/**
- * OcaDelay
- */
-struct OcaDelay : public OcaActuator
-{
-    int DefLevel() const override;
-    std::vector<Property> GetProperties() const override;
-    juce::Component* CreateComponentForProperty(const Property& prop, const std::function<void()>& onChangeFunction) override;
-    std::vector<std::uint8_t> CreateParamDataForComponent(const juce::Component* component, const AES70::Property& prop) override;
-};
-
-/**
- * OcaBasicActuator
- */
-struct OcaBasicActuator : public OcaActuator
-{
-    int DefLevel() const override
-    {
-        return OcaActuator::DefLevel() + 1;
-    }
-};
-
-/**
- * OcaStringActuator
- */
-struct OcaStringActuator : public OcaBasicActuator
-{
-    int DefLevel() const override;
-    std::vector<Property> GetProperties() const override;
-    juce::Component* CreateComponentForProperty(const Property& prop, const std::function<void()>& onChangeFunction) override;
-    std::vector<std::uint8_t> CreateParamDataForComponent(const juce::Component* component, const AES70::Property& prop) override;
-};
-
-/**
- * OcaInt32Actuator
- */
-struct OcaInt32Actuator : public OcaBasicActuator
-{
-    int DefLevel() const override;
-    std::vector<Property> GetProperties() const override;
-    juce::Component* CreateComponentForProperty(const Property& prop, const std::function<void()>& onChangeFunction) override;
-    std::vector<std::uint8_t> CreateParamDataForComponent(const juce::Component* component, const AES70::Property& prop) override;
-};
-
-/**
- * OcaSensor
- */
-struct OcaSensor : public OcaWorker
-{
-    int DefLevel() const override;
-    std::vector<Property> GetProperties() const override;
-    juce::Component* CreateComponentForProperty(const Property& prop, const std::function<void()>& onChangeFunction) override;
-    std::vector<std::uint8_t> CreateParamDataForComponent(const juce::Component* component, const AES70::Property& prop) override;
-};
-
-/**
- * OcaBasicSensor
- */
-struct OcaBasicSensor : public OcaSensor
-{
-    int DefLevel() const override
-    {
-        return OcaSensor::DefLevel() + 1;
-    }
-};
-
-/**
- * OcaBooleanSensor
- */
-struct OcaBooleanSensor : public OcaBasicSensor
-{
-    int DefLevel() const override;
-    std::vector<Property> GetProperties() const override;
-    juce::Component* CreateComponentForProperty(const Property& prop, const std::function<void()>& onChangeFunction) override;
-    std::vector<std::uint8_t> CreateParamDataForComponent(const juce::Component* component, const AES70::Property& prop) override;
-};
-
-/**
- * OcaInt32Sensor
- */
-struct OcaInt32Sensor : public OcaBasicSensor
-{
-    int DefLevel() const override;
-    std::vector<Property> GetProperties() const override;
-    juce::Component* CreateComponentForProperty(const Property& prop, const std::function<void()>& onChangeFunction) override;
-    std::vector<std::uint8_t> CreateParamDataForComponent(const juce::Component* component, const AES70::Property& prop) override;
-};
-
-/**
- * OcaFloat32Sensor
- */
-struct OcaFloat32Sensor : public OcaBasicSensor
-{
-    int DefLevel() const override;
-    std::vector<Property> GetProperties() const override;
-    juce::Component* CreateComponentForProperty(const Property& prop, const std::function<void()>& onChangeFunction) override;
-    std::vector<std::uint8_t> CreateParamDataForComponent(const juce::Component* component, const AES70::Property& prop) override;
-};
-
-/**
- * OcaStringSensor
- */
-struct OcaStringSensor : public OcaBasicSensor
-{
-    int DefLevel() const override;
-    std::vector<Property> GetProperties() const override;
-    juce::Component* CreateComponentForProperty(const Property& prop, const std::function<void()>& onChangeFunction) override;
-    std::vector<std::uint8_t> CreateParamDataForComponent(const juce::Component* component, const AES70::Property& prop) override;
-};
-
-/**
- * OcaLevelSensor
- */
-struct OcaLevelSensor : public OcaSensor
-{
-    int DefLevel() const override;
-    std::vector<Property> GetProperties() const override;
-    juce::Component* CreateComponentForProperty(const Property& prop, const std::function<void()>& onChangeFunction) override;
-    std::vector<std::uint8_t> CreateParamDataForComponent(const juce::Component* component, const AES70::Property& prop) override;
-};
-
-/**
- * OcaAudioLevelSensor
- */
-struct OcaAudioLevelSensor : public OcaLevelSensor
-{
-    int DefLevel() const override;
-    std::vector<Property> GetProperties() const override;
-    juce::Component* CreateComponentForProperty(const Property& prop, const std::function<void()>& onChangeFunction) override;
-    std::vector<std::uint8_t> CreateParamDataForComponent(const juce::Component* component, const AES70::Property& prop) override;
-};
-
-/**
- * OcaAgent
- */
-struct OcaAgent : public OcaRoot
-{
-    int DefLevel() const override;
-    std::vector<Property> GetProperties() const override;
-    juce::Component* CreateComponentForProperty(const Property& prop, const std::function<void()>& onChangeFunction) override;
-    std::vector<std::uint8_t> CreateParamDataForComponent(const juce::Component* component, const AES70::Property& prop) override;
+protected:
+    int m_classIdx; // Index of the AES70 class within the Schema.
 };
 
 /**
@@ -371,10 +196,10 @@ struct OcaAgent : public OcaRoot
  */
 struct OcaCustomClass : public OcaRoot
 {
+    OcaCustomClass();
+
     int DefLevel() const override;
     std::vector<Property> GetProperties() const override;
-    juce::Component* CreateComponentForProperty(const Property& prop, const std::function<void()>& onChangeFunction) override;
-    std::vector<std::uint8_t> CreateParamDataForComponent(const juce::Component* component, const AES70::Property& prop) override;
 
     Property m_customProp; // User-defined property
 };
@@ -0,0 +1,632 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#include "AES70Codec.h"
+#include "Ocp1Message.h"
+#include <array>
+#include <atomic>
+
+
+namespace AES70
+{
+
+static constexpr juce::juce_wchar ItemSeparator = '|';      // Separates items of list and map value strings.
+static constexpr juce::juce_wchar KeyValueSeparator = '=';  // Separates key and value of map entries.
+static constexpr juce::juce_wchar BlobFilePrefix = '@';     // Marks blob value strings holding a file path.
+static constexpr std::size_t MaxCount = 0xffff;             // Maximum number of items or bytes, as given by the Uint16 count.
+
+/**
+ * Helper method to call a function for each item of a list or map value string.
+ * The items are passed as they are found, without collecting them first.
+ *
+ * @param[in] valueString   Items separated by ItemSeparator. Empty for no items.
+ * @param[in] callback      Function called with each item, in order.
+ */
+template <typename Callback>
+static void ForEachItem(const juce::String& valueString, Callback&& callback)
+{
+    if (valueString.isEmpty())
+        return;
+
+    auto itemStart = valueString.getCharPointer();
+    for (auto pos = itemStart; ; ++pos)
+    {
+        if (pos.isEmpty() || *pos == ItemSeparator)
+        {
+            callback(juce::String(itemStart, pos));
+            if (pos.isEmpty())
+                return;
+
+            itemStart = pos + 1;
+        }
+    }
+}
+
+/**
+ * Helper method to count the items of a list or map value string.
+ *
+ * @param[in] valueString   Items separated by ItemSeparator. Empty for no items.
+ * @return  Number of items, which may exceed MaxCount.
+ */
+static std::size_t CountItems(const juce::String& valueString)
+{
+    if (valueString.isEmpty())
+        return 0;
+
+    std::size_t numItems(1);
+    for (auto pos = valueString.getCharPointer(); !pos.isEmpty(); ++pos)
+    {
+        if (*pos == ItemSeparator)
+            numItems++;
+    }
+
+    return numItems;
+}
+
+/**
+ * Helper method to get the number of items of a list or map value string.
+ *
+ * @param[in] valueString   Items separated by ItemSeparator. Empty for no items.
+ * @return  Number of items, limited to MaxCount.
+ */
+static std::size_t GetNumItems(const juce::String& valueString)
+{
+    return std::min(CountItems(valueString), MaxCount);
+}
+
+/**
+ * Helper method to split a map entry of a value string into its key and value.
+ *
+ * @param[in] entry     Key and value separated by KeyValueSeparator.
+ * @param[out] key      The text before the KeyValueSeparator.
+ * @param[out] value    The text after the KeyValueSeparator. Empty if there is none.
+ */
+static void SplitEntry(const juce::String& entry, juce::String& key, juce::String& value)
+{
+    auto separatorIdx = entry.indexOfChar(KeyValueSeparator);
+    key = (separatorIdx < 0) ? entry : entry.substring(0, separatorIdx);
+    value = (separatorIdx < 0) ? juce::String() : entry.substring(separatorIdx + 1);
+}
+
+/**
+ * Helper method to get the file referred to by a blob value string, if any.
+ *
+ * @param[in] valueString   String representation of a blob.
+ * @return  The file following the BlobFilePrefix, relative to the working directory unless the path is absolute.
+ *          juce::File() if the value string holds hex text instead.
+ */
+static juce::File GetBlobFile(const juce::String& valueString)
+{
+    if (!valueString.startsWithChar(BlobFilePrefix))
+        return {};
+
+    return juce::File::getCurrentWorkingDirectory().getChildFile(valueString.substring(1).trim());
+}
+
+/**
+ * Helper method to get the number of hex digits of a blob value string.
+ *
+ * @param[in] valueString   Bytes as hex text. Any other characters such as spaces are ignored.
+ * @return  Number of hex digits.
+ */
+static std::size_t GetNumHexDigits(const juce::String& valueString)
+{
+    std::size_t numHexDigits(0);
+    for (auto pos = valueString.getCharPointer(); !pos.isEmpty(); ++pos)
+    {
+        if (juce::CharacterFunctions::getHexDigitValue(*pos) >= 0)
+            numHexDigits++;
+    }
+
+    return numHexDigits;
+}
+
+/**
+ * Helper method to convert the string representation of a value, as stored in config files, to its C++ type.
+ * Texts of ComboBox items such as "1: True" are interpreted by their leading number.
+ *
+ * @param[in] valueString   String representation of the value.
+ * @return  The value.
+ */
+template <typename T>
+static T FromValueString(const juce::String& valueString)
+{
+    if constexpr (std::is_same<T, bool>::value)
+        return valueString.getIntValue() != 0;
+    else if constexpr (std::is_floating_point<T>::value)
+        return static_cast<T>(valueString.getDoubleValue());
+    else if constexpr (std::is_integral<T>::value)
+        return static_cast<T>(valueString.getLargeIntValue());
+    else
+        return valueString;
+}
+
+/**
+ * Helper method to convert a value to the string representation stored in config files.
+ *
+ * @param[in] value     The value.
+ * @return  String representation of the value.
+ */
+template <typename T>
+static juce::String ToValueString(const T& value)
+{
+    if constexpr (std::is_same<T, bool>::value)
+        return value ? "1" : "0";
+    else if constexpr (std::is_same<T, std::int8_t>::value || std::is_same<T, std::uint8_t>::value)
+        return juce::String(static_cast<int>(value));
+    else if constexpr (std::is_arithmetic<T>::value)
+        return juce::String(value);
+    else
+        return value;
+}
+
+/**
+ * ValueCodec forwarding to the Codec of the C++ type T.
+ */
+template <typename T>
+struct ValueCodecOf
+{
+    static bool Validate(const juce::String& valueString, juce::String& errorMessage)
+    {
+        // Only strings are limited in length by their Uint16 count of characters.
+        if constexpr (std::is_same<T, juce::String>::value)
+        {
+            if (static_cast<std::size_t>(valueString.length()) > MaxCount)
+            {
+                errorMessage = "String is longer than " + juce::String(MaxCount) + " characters";
+                return false;
+            }
+        }
+        else
+            juce::ignoreUnused(valueString, errorMessage);
+
+        return true;
+    }
+
+    static std::size_t Size(const juce::String& valueString)
+    {
+        if constexpr (Codec<T>::FixedSize != 0)
+        {
+            juce::ignoreUnused(valueString);
+            return Codec<T>::FixedSize;
+        }
+        else
+            return Codec<T>::Size(FromValueString<T>(valueString));
+    }
+
+    static std::uint8_t* Encode(const juce::String& valueString, std::uint8_t* dest, std::uint8_t* end)
+    {
+        juce::ignoreUnused(end);
+        jassert(dest + Size(valueString) <= end);
+        return Codec<T>::Encode(FromValueString<T>(valueString), dest);
+    }
+
+    static bool Decode(const std::uint8_t*& src, const std::uint8_t* end, juce::String& valueString)
+    {
+        T value{};
+        if (!Codec<T>::Decode(src, end, value))
+            return false;
+
+        valueString = ToValueString(value);
+        return true;
+    }
+
+    static constexpr ValueCodec Instance = { &Validate, &Size, &Encode, &Decode };
+};
+
+/**
+ * ValueCodec of OcaBlob. The bytes are written straight from the hex text, or from a memory-mapped 
+ * view of the file, to the destination. Blobs are limited to MaxCount bytes, longer ones fail to validate and encode.
+ */
+template <>
+struct ValueCodecOf<Blob>
+{
+    static bool Validate(const juce::String& valueString, juce::String& errorMessage)
+    {
+        auto file = GetBlobFile(valueString);
+        if (file == juce::File())
+        {
+            if (GetNumHexDigits(valueString) / 2 > MaxCount)
+            {
+                errorMessage = "Blob is longer than " + juce::String(MaxCount) + " bytes";
+                return false;
+            }
+
+            return true;
+        }
+
+        if (!file.existsAsFile())
+        {
+            errorMessage = "Blob file " + file.getFullPathName() + " does not exist";
+            return false;
+        }
+        if (!file.hasReadAccess())
+        {
+            errorMessage = "Blob file " + file.getFullPathName() + " cannot be read";
+            return false;
+        }
+        if (file.getSize() > static_cast<juce::int64>(MaxCount))
+        {
+            errorMessage = "Blob file " + file.getFullPathName() + " is larger than " + juce::String(MaxCount) + " bytes";
+            return false;
+        }
+
+        return true;
+    }
+
+    static std::size_t GetNumBytes(const juce::String& valueString)
+    {
+        auto file = GetBlobFile(valueString);
+        if (file != juce::File())
+            return static_cast<std::size_t>(std::min<juce::int64>(file.getSize(), MaxCount));
+
+        return std::min(GetNumHexDigits(valueString) / 2, MaxCount);
+    }
+
+    static std::size_t Size(const juce::String& valueString)
+    {
+        return Codec<std::uint16_t>::FixedSize + GetNumBytes(valueString);
+    }
+
+    static std::uint8_t* Encode(const juce::String& valueString, std::uint8_t* dest, std::uint8_t* end)
+    {
+        if (end - dest < static_cast<std::ptrdiff_t>(Codec<std::uint16_t>::FixedSize))
+            return nullptr;
+
+        auto bytes = dest + Codec<std::uint16_t>::FixedSize;
+        auto maxNumBytes = std::min(static_cast<std::size_t>(end - bytes), MaxCount);
+        std::size_t numBytes(0);
+
+        auto file = GetBlobFile(valueString);
+        if (file != juce::File())
+        {
+            // The file might have changed since it was validated and sized.
+            juce::MemoryMappedFile mappedFile(file, juce::MemoryMappedFile::readOnly);
+            if (!file.existsAsFile() || (mappedFile.getSize() > maxNumBytes) || (file.getSize() > 0 && mappedFile.getData() == nullptr))
+                return nullptr;
+
+            numBytes = mappedFile.getSize();
+            if (numBytes > 0)
+                std::memcpy(bytes, mappedFile.getData(), numBytes);
+        }
+        else
+        {
+            if (GetNumHexDigits(valueString) / 2 > maxNumBytes)
+                return nullptr;
+
+            // Pairs of hex digits, ignoring any other characters such as spaces.
+            int highNibble(-1);
+            for (auto pos = valueString.getCharPointer(); !pos.isEmpty() && numBytes < maxNumBytes; ++pos)
+            {
+                auto nibble = juce::CharacterFunctions::getHexDigitValue(*pos);
+                if (nibble < 0)
+                    continue;
+
+                if (highNibble < 0)
+                {
+                    highNibble = nibble;
+                }
+                else
+                {
+                    bytes[numBytes++] = static_cast<std::uint8_t>((highNibble << 4) | nibble);
+                    highNibble = -1;
+                }
+            }
+        }
+
+        Codec<std::uint16_t>::Encode(static_cast<std::uint16_t>(numBytes), dest);
+        return bytes + numBytes;
+    }
+
+    static bool Decode(const std::uint8_t*& src, const std::uint8_t* end, juce::String& valueString)
+    {
+        std::uint16_t numBytes(0);
+        auto pos = src;
+        if (!Codec<std::uint16_t>::Decode(pos, end, numBytes) || (static_cast<std::size_t>(end - pos) < numBytes))
+            return false;
+
+        valueString = juce::String::toHexString(pos, numBytes, 0);
+        src = pos + numBytes;
+        return true;
+    }
+
+    static constexpr ValueCodec Instance = { &Validate, &Size, &Encode, &Decode };
+};
+
+/**
+ * ValueCodec of OcaList with items of the C++ type T. Each item is encoded directly from its
+ * substring of the value string, without building a std::vector<T> first.
+ */
+template <typename T>
+struct ListValueCodecOf
+{
+    static bool Validate(const juce::String& valueString, juce::String& errorMessage)
+    {
+        if (CountItems(valueString) > MaxCount)
+        {
+            errorMessage = "List has more than " + juce::String(MaxCount) + " items";
+            return false;
+        }
+
+        bool valid(true);
+        ForEachItem(valueString, [&](const juce::String& item)
+        {
+            valid = valid && ValueCodecOf<T>::Validate(item, errorMessage);
+        });
+        return valid;
+    }
+
+    static std::size_t Size(const juce::String& valueString)
+    {
+        auto numItems = GetNumItems(valueString);
+        if constexpr (Codec<T>::FixedSize != 0)
+            return Codec<std::uint16_t>::FixedSize + numItems * Codec<T>::FixedSize;
+
+        std::size_t size(Codec<std::uint16_t>::FixedSize);
+        std::size_t itemIdx(0);
+        ForEachItem(valueString, [&](const juce::String& item)
+        {
+            if (itemIdx++ < numItems)
+                size += ValueCodecOf<T>::Size(item);
+        });
+        return size;
+    }
+
+    static std::uint8_t* Encode(const juce::String& valueString, std::uint8_t* dest, std::uint8_t* end)
+    {
+        auto numItems = GetNumItems(valueString);
+        dest = Codec<std::uint16_t>::Encode(static_cast<std::uint16_t>(numItems), dest);
+
+        std::size_t itemIdx(0);
+        ForEachItem(valueString, [&](const juce::String& item)
+        {
+            if ((dest != nullptr) && (itemIdx++ < numItems))
+                dest = ValueCodecOf<T>::Encode(item, dest, end);
+        });
+        return dest;
+    }
+
+    static bool Decode(const std::uint8_t*& src, const std::uint8_t* end, juce::String& valueString)
+    {
+        std::uint16_t numItems(0);
+        auto pos = src;
+        if (!Codec<std::uint16_t>::Decode(pos, end, numItems))
+            return false;
+
+        juce::String items, item;
+        for (std::uint16_t i = 0; i < numItems; i++)
+        {
+            if (!ValueCodecOf<T>::Decode(pos, end, item))
+                return false;
+
+            if (i > 0)
+                items << ItemSeparator;
+            items << item;
+        }
+
+        valueString = items;
+        src = pos;
+        return true;
+    }
+
+    static constexpr ValueCodec Instance = { &Validate, &Size, &Encode, &Decode };
+};
+
+/**
+ * ValueCodec of OcaMap with keys of the C++ type K and values of the C++ type V.
+ * Like ListValueCodecOf, each entry is encoded directly from its substring of the value string.
+ */
+template <typename K, typename V>
+struct MapValueCodecOf
+{
+    static bool Validate(const juce::String& valueString, juce::String& errorMessage)
+    {
+        if (CountItems(valueString) > MaxCount)
+        {
+            errorMessage = "Map has more than " + juce::String(MaxCount) + " entries";
+            return false;
+        }
+
+        bool valid(true);
+        juce::String key, value;
+        ForEachItem(valueString, [&](const juce::String& entry)
+        {
+            SplitEntry(entry, key, value);
+            valid = valid && ValueCodecOf<K>::Validate(key, errorMessage) && ValueCodecOf<V>::Validate(value, errorMessage);
+        });
+        return valid;
+    }
+
+    static std::size_t Size(const juce::String& valueString)
+    {
+        auto numEntries = GetNumItems(valueString);
+        std::size_t size(Codec<std::uint16_t>::FixedSize);
+        std::size_t entryIdx(0);
+        juce::String key, value;
+        ForEachItem(valueString, [&](const juce::String& entry)
+        {
+            if (entryIdx++ < numEntries)
+            {
+                SplitEntry(entry, key, value);
+                size += ValueCodecOf<K>::Size(key) + ValueCodecOf<V>::Size(value);
+            }
+        });
+        return size;
+    }
+
+    static std::uint8_t* Encode(const juce::String& valueString, std::uint8_t* dest, std::uint8_t* end)
+    {
+        auto numEntries = GetNumItems(valueString);
+        dest = Codec<std::uint16_t>::Encode(static_cast<std::uint16_t>(numEntries), dest);
+
+        std::size_t entryIdx(0);
+        juce::String key, value;
+        ForEachItem(valueString, [&](const juce::String& entry)
+        {
+            if ((dest != nullptr) && (entryIdx++ < numEntries))
+            {
+                SplitEntry(entry, key, value);
+                dest = ValueCodecOf<K>::Encode(key, dest, end);
+                if (dest != nullptr)
+                    dest = ValueCodecOf<V>::Encode(value, dest, end);
+            }
+        });
+        return dest;
+    }
+
+    static bool Decode(const std::uint8_t*& src, const std::uint8_t* end, juce::String& valueString)
+    {
+        std::uint16_t numEntries(0);
+        auto pos = src;
+        if (!Codec<std::uint16_t>::Decode(pos, end, numEntries))
+            return false;
+
+        juce::String entries, key, value;
+        for (std::uint16_t i = 0; i < numEntries; i++)
+        {
+            if (!ValueCodecOf<K>::Decode(pos, end, key) || !ValueCodecOf<V>::Decode(pos, end, value))
+                return false;
+
+            if (i > 0)
+                entries << ItemSeparator;
+            entries << key << KeyValueSeparator << value;
+        }
+
+        valueString = entries;
+        src = pos;
+        return true;
+    }
+
+    static constexpr ValueCodec Instance = { &Validate, &Size, &Encode, &Decode };
+};
+
+/**
+ * C++ type matching each NanoOcp1 data type. Unsupported data types, such as OCP1DATATYPE_BIT_STRING, map to void.
+ */
+template <int DataType> struct TypeOfDataType { using Type = void; };
+template <> struct TypeOfDataType<NanoOcp1::OCP1DATATYPE_BOOLEAN> { using Type = bool; };
+template <> struct TypeOfDataType<NanoOcp1::OCP1DATATYPE_INT8> { using Type = std::int8_t; };
+template <> struct TypeOfDataType<NanoOcp1::OCP1DATATYPE_INT16> { using Type = std::int16_t; };
+template <> struct TypeOfDataType<NanoOcp1::OCP1DATATYPE_INT32> { using Type = std::int32_t; };
+template <> struct TypeOfDataType<NanoOcp1::OCP1DATATYPE_INT64> { using Type = std::int64_t; };
+template <> struct TypeOfDataType<NanoOcp1::OCP1DATATYPE_UINT8> { using Type = std::uint8_t; };
+template <> struct TypeOfDataType<NanoOcp1::OCP1DATATYPE_UINT16> { using Type = std::uint16_t; };
+template <> struct TypeOfDataType<NanoOcp1::OCP1DATATYPE_UINT32> { using Type = std::uint32_t; };
+template <> struct TypeOfDataType<NanoOcp1::OCP1DATATYPE_UINT64> { using Type = std::uint64_t; };
+template <> struct TypeOfDataType<NanoOcp1::OCP1DATATYPE_FLOAT32> { using Type = float; };
+template <> struct TypeOfDataType<NanoOcp1::OCP1DATATYPE_FLOAT64> { using Type = double; };
+template <> struct TypeOfDataType<NanoOcp1::OCP1DATATYPE_STRING> { using Type = juce::String; };
+template <> struct TypeOfDataType<NanoOcp1::OCP1DATATYPE_BLOB> { using Type = Blob; };
+
+static constexpr int NumDataTypes = NanoOcp1::OCP1DATATYPE_BLOB + 1;
+static_assert(NumDataTypes - 1 <= DataTypeKeyMask, "Map key data types must fit into the bits reserved for them");
+
+/**
+ * The ValueCodecs of each NanoOcp1 data type, with the C++ type of the data type applied to 
+ * the ValueCodec template CodecOf. Unsupported data types have no entry.
+ */
+template <template <typename> class CodecOf, typename T>
+static constexpr const ValueCodec* GetInstanceOf()
+{
+    if constexpr (std::is_void<T>::value)
+        return nullptr;
+    else
+        return &CodecOf<T>::Instance;
+}
+
+template <template <typename> class CodecOf, int... DataTypes>
+static constexpr std::array<const ValueCodec*, NumDataTypes> MakeValueCodecTable(std::integer_sequence<int, DataTypes...>)
+{
+    return { GetInstanceOf<CodecOf, typename TypeOfDataType<DataTypes>::Type>()... };
+}
+
+template <template <typename> class CodecOf>
+static constexpr std::array<const ValueCodec*, NumDataTypes> MakeValueCodecTable()
+{
+    return MakeValueCodecTable<CodecOf>(std::make_integer_sequence<int, NumDataTypes>());
+}
+
+/**
+ * MapValueCodecOf with a given key type, as ValueCodec template of the value type.
+ */
+template <typename K>
+struct MapValueCodecsWithKey
+{
+    template <typename V>
+    using Of = MapValueCodecOf<K, V>;
+
+    static constexpr std::array<const ValueCodec*, NumDataTypes> Create()
+    {
+        if constexpr (std::is_void<K>::value)
+            return {};
+        else
+            return MakeValueCodecTable<Of>();
+    }
+};
+
+template <int... KeyDataTypes>
+static constexpr std::array<std::array<const ValueCodec*, NumDataTypes>, NumDataTypes> MakeMapValueCodecTable(std::integer_sequence<int, KeyDataTypes...>)
+{
+    return { MapValueCodecsWithKey<typename TypeOfDataType<KeyDataTypes>::Type>::Create()... };
+}
+
+static constexpr auto ValueCodecs = MakeValueCodecTable<ValueCodecOf>();
+static constexpr auto ListValueCodecs = MakeValueCodecTable<ListValueCodecOf>();
+static constexpr auto MapValueCodecs = MakeMapValueCodecTable(std::make_integer_sequence<int, NumDataTypes>());
+
+const ValueCodec* GetValueCodec(int dataType)
+{
+    if (IsMapDataType(dataType))
+    {
+        auto keyDataType = GetKeyDataType(dataType);
+        auto valueDataType = GetItemDataType(dataType);
+        if (IsListDataType(dataType) || keyDataType >= NumDataTypes || valueDataType >= NumDataTypes)
+            return nullptr;
+
+        return MapValueCodecs[static_cast<std::size_t>(keyDataType)][static_cast<std::size_t>(valueDataType)];
+    }
+
+    if (IsListDataType(dataType))
+    {
+        auto itemDataType = GetItemDataType(dataType);
+        if (GetKeyDataType(dataType) != 0 || itemDataType >= NumDataTypes)
+            return nullptr;
+
+        return ListValueCodecs[static_cast<std::size_t>(itemDataType)];
+    }
+
+    if (dataType < 0 || dataType >= NumDataTypes)
+        return nullptr;
+
+    return ValueCodecs[static_cast<std::size_t>(dataType)];
+}
+
+std::uint32_t NextInternalHandle()
+{
+    // Counts through the lower 31 bits, so that the handles stay within the internal range when wrapping around.
+    static std::atomic<std::uint32_t> counter(0);
+    return FirstInternalHandle | (counter++ & ~FirstInternalHandle);
+}
+
+} // namespace AES70
@@ -0,0 +1,748 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <map>
+#include <type_traits>
+
+
+namespace AES70
+{
+
+/**
+ * OCP.1 OcaBlob: a Uint16 byte count, followed by the bytes. 
+ * Encoded exactly like an OcaList of Uint8, so both share Codec<std::vector<std::uint8_t>>.
+ */
+using Blob = std::vector<std::uint8_t>;
+
+/**
+ * Unsigned integer type with the given number of bytes, used to reinterpret values for byte swapping.
+ */
+template <std::size_t NumBytes> struct UnsignedOfSize;
+template <> struct UnsignedOfSize<1> { using Type = std::uint8_t; };
+template <> struct UnsignedOfSize<2> { using Type = std::uint16_t; };
+template <> struct UnsignedOfSize<4> { using Type = std::uint32_t; };
+template <> struct UnsignedOfSize<8> { using Type = std::uint64_t; };
+
+/**
+ * Encoding and decoding of a C++ type in the OCP.1 wire format. Each specialization provides:
+ *
+ *  - FixedSize:    Number of bytes of every encoded value, or zero if the size depends on the value.
+ *  - Size(value):  Number of bytes of the encoded value.
+ *  - Encode(value, dest):      Write the value to dest, which must hold Size(value) bytes. 
+ *                              Returns the pointer following the written bytes.
+ *  - Decode(src, end, value):  Read a value from src, which is advanced past the read bytes. 
+ *                              Returns false if the bytes up to end do not hold a complete value.
+ *
+ * Specializations exist for bool, all integer types of 1 to 8 bytes, float and double (big-endian, 
+ * of fixed size), juce::String (OcaString), Blob (OcaBlob), std::vector (OcaList) and std::map (OcaMap).
+ */
+template <typename T, typename Enable = void>
+struct Codec;
+
+/**
+ * Codec of bool, integer and floating point types.
+ */
+template <typename T>
+struct Codec<T, std::enable_if_t<std::is_arithmetic<T>::value>>
+{
+    static constexpr std::size_t FixedSize = std::is_same<T, bool>::value ? 1 : sizeof(T);
+    using Bits = typename UnsignedOfSize<FixedSize>::Type;
+
+    static constexpr std::size_t Size(const T&)
+    {
+        return FixedSize;
+    }
+
+    static std::uint8_t* Encode(const T& value, std::uint8_t* dest)
+    {
+        Bits bits(0);
+        if constexpr (std::is_same<T, bool>::value)
+            bits = static_cast<Bits>(value);
+        else
+            std::memcpy(&bits, &value, FixedSize);
+
+        for (std::size_t i = 0; i < FixedSize; i++)
+            dest[i] = static_cast<std::uint8_t>(static_cast<std::uint64_t>(bits) >> (8 * (FixedSize - 1 - i)));
+
+        return dest + FixedSize;
+    }
+
+    static bool Decode(const std::uint8_t*& src, const std::uint8_t* end, T& value)
+    {
+        // The codecs of all other types begin by decoding a count with this one, which guards them as well.
+        if ((src > end) || (static_cast<std::size_t>(end - src) < FixedSize))
+            return false;
+
+        std::uint64_t bits(0);
+        for (std::size_t i = 0; i < FixedSize; i++)
+            bits = (bits << 8) | src[i];
+
+        if constexpr (std::is_same<T, bool>::value)
+        {
+            value = (bits != 0);
+        }
+        else
+        {
+            auto sizedBits = static_cast<Bits>(bits);
+            std::memcpy(&value, &sizedBits, FixedSize);
+        }
+
+        src += FixedSize;
+        return true;
+    }
+};
+
+/**
+ * Codec of OcaString: a Uint16 count of characters, followed by the UTF-8 encoded characters.
+ */
+template <>
+struct Codec<juce::String>
+{
+    static constexpr std::size_t FixedSize = 0;
+
+    static std::size_t Size(const juce::String& value)
+    {
+        return Codec<std::uint16_t>::FixedSize + value.getNumBytesAsUTF8();
+    }
+
+    static std::uint8_t* Encode(const juce::String& value, std::uint8_t* dest)
+    {
+        auto numBytes = value.getNumBytesAsUTF8();
+        dest = Codec<std::uint16_t>::Encode(static_cast<std::uint16_t>(value.length()), dest);
+        std::memcpy(dest, value.toRawUTF8(), numBytes);
+        return dest + numBytes;
+    }
+
+    static bool Decode(const std::uint8_t*& src, const std::uint8_t* end, juce::String& value)
+    {
+        std::uint16_t numChars(0);
+        auto pos = src;
+        if (!Codec<std::uint16_t>::Decode(pos, end, numChars))
+            return false;
+
+        // The number of bytes per character is given by the leading byte of each UTF-8 sequence.
+        auto charsBegin = pos;
+        for (std::uint16_t i = 0; i < numChars; i++)
+        {
+            if (pos >= end)
+                return false;
+
+            auto leadingByte = *pos;
+            pos += (leadingByte < 0x80) ? 1 : (leadingByte < 0xe0) ? 2 : (leadingByte < 0xf0) ? 3 : 4;
+        }
+        if (pos > end)
+            return false;
+
+        value = juce::String::fromUTF8(reinterpret_cast<const char*>(charsBegin), static_cast<int>(pos - charsBegin));
+        src = pos;
+        return true;
+    }
+};
+
+/**
+ * Codec of OcaBlob, and of OcaList of Uint8: a Uint16 byte count, followed by the bytes.
+ */
+template <>
+struct Codec<Blob>
+{
+    static constexpr std::size_t FixedSize = 0;
+
+    static std::size_t Size(const Blob& value)
+    {
+        return Codec<std::uint16_t>::FixedSize + value.size();
+    }
+
+    static std::uint8_t* Encode(const Blob& value, std::uint8_t* dest)
+    {
+        jassert(value.size() <= std::numeric_limits<std::uint16_t>::max());
+        dest = Codec<std::uint16_t>::Encode(static_cast<std::uint16_t>(value.size()), dest);
+        if (!value.empty())
+            std::memcpy(dest, value.data(), value.size());
+        return dest + value.size();
+    }
+
+    static bool Decode(const std::uint8_t*& src, const std::uint8_t* end, Blob& value)
+    {
+        std::uint16_t numBytes(0);
+        auto pos = src;
+        if (!Codec<std::uint16_t>::Decode(pos, end, numBytes) || (static_cast<std::size_t>(end - pos) < numBytes))
+            return false;
+
+        value.assign(pos, pos + numBytes);
+        src = pos + numBytes;
+        return true;
+    }
+};
+
+/**
+ * Codec of OcaList: a Uint16 count of items, followed by the items.
+ */
+template <typename T>
+struct Codec<std::vector<T>>
+{
+    static constexpr std::size_t FixedSize = 0;
+
+    static std::size_t Size(const std::vector<T>& value)
+    {
+        if constexpr (Codec<T>::FixedSize != 0)
+            return Codec<std::uint16_t>::FixedSize + value.size() * Codec<T>::FixedSize;
+
+        std::size_t size(Codec<std::uint16_t>::FixedSize);
+        for (const auto& item : value)
+            size += Codec<T>::Size(item);
+        return size;
+    }
+
+    static std::uint8_t* Encode(const std::vector<T>& value, std::uint8_t* dest)
+    {
+        jassert(value.size() <= std::numeric_limits<std::uint16_t>::max());
+        dest = Codec<std::uint16_t>::Encode(static_cast<std::uint16_t>(value.size()), dest);
+        for (const auto& item : value)
+            dest = Codec<T>::Encode(item, dest);
+        return dest;
+    }
+
+    static bool Decode(const std::uint8_t*& src, const std::uint8_t* end, std::vector<T>& value)
+    {
+        std::uint16_t numItems(0);
+        auto pos = src;
+        if (!Codec<std::uint16_t>::Decode(pos, end, numItems))
+            return false;
+
+        value.clear();
+        value.reserve(numItems);
+        for (std::uint16_t i = 0; i < numItems; i++)
+        {
+            T item{};
+            if (!Codec<T>::Decode(pos, end, item))
+                return false;
+            value.push_back(std::move(item));
+        }
+
+        src = pos;
+        return true;
+    }
+};
+
+/**
+ * Codec of OcaMap: a Uint16 count of entries, followed by key and value of each entry.
+ */
+template <typename K, typename V>
+struct Codec<std::map<K, V>>
+{
+    static constexpr std::size_t FixedSize = 0;
+
+    static std::size_t Size(const std::map<K, V>& value)
+    {
+        if constexpr (Codec<K>::FixedSize != 0 && Codec<V>::FixedSize != 0)
+            return Codec<std::uint16_t>::FixedSize + value.size() * (Codec<K>::FixedSize + Codec<V>::FixedSize);
+
+        std::size_t size(Codec<std::uint16_t>::FixedSize);
+        for (const auto& entry : value)
+            size += Codec<K>::Size(entry.first) + Codec<V>::Size(entry.second);
+        return size;
+    }
+
+    static std::uint8_t* Encode(const std::map<K, V>& value, std::uint8_t* dest)
+    {
+        jassert(value.size() <= std::numeric_limits<std::uint16_t>::max());
+        dest = Codec<std::uint16_t>::Encode(static_cast<std::uint16_t>(value.size()), dest);
+        for (const auto& entry : value)
+        {
+            dest = Codec<K>::Encode(entry.first, dest);
+            dest = Codec<V>::Encode(entry.second, dest);
+        }
+        return dest;
+    }
+
+    static bool Decode(const std::uint8_t*& src, const std::uint8_t* end, std::map<K, V>& value)
+    {
+        std::uint16_t numEntries(0);
+        auto pos = src;
+        if (!Codec<std::uint16_t>::Decode(pos, end, numEntries))
+            return false;
+
+        value.clear();
+        for (std::uint16_t i = 0; i < numEntries; i++)
+        {
+            K key{};
+            V entryValue{};
+            if (!Codec<K>::Decode(pos, end, key) || !Codec<V>::Decode(pos, end, entryValue))
+                return false;
+            value.emplace(std::move(key), std::move(entryValue));
+        }
+
+        src = pos;
+        return true;
+    }
+};
+
+/**
+ * Encode several values, i.e. all parameters of a method, into one byte array. 
+ * The array is sized exactly from the values up front, and each value is encoded directly into it.
+ *
+ * @param[in] values    The values to encode, in order.
+ * @return  Byte array that can be used as parameter data for an OCP.1 message.
+ */
+template <typename... Ts>
+std::vector<std::uint8_t> Encode(const Ts&... values)
+{
+    std::vector<std::uint8_t> data((Codec<Ts>::Size(values) + ... + 0));
+    auto dest = data.data();
+    ((dest = Codec<Ts>::Encode(values, dest)), ...);
+    juce::ignoreUnused(dest);
+    return data;
+}
+
+/**
+ * Decode several values, i.e. all parameters of a Response, from a byte array.
+ *
+ * @param[in] data      Pointer to the first byte.
+ * @param[in] size      Number of bytes.
+ * @param[out] values   The decoded values, in order.
+ * @return  True if all values could be decoded.
+ */
+template <typename... Ts>
+bool Decode(const std::uint8_t* data, std::size_t size, Ts&... values)
+{
+    auto end = data + size;
+    return (Codec<Ts>::Decode(data, end, values) && ...);
+}
+
+/**
+ * OCP.1 PDU header: SyncVal (1 byte), ProtocolVersion (Uint16), PduSize (Uint32, excluding the SyncVal),
+ * PduType (Uint8) and MessageCount (Uint16).
+ */
+static constexpr std::uint8_t PduSyncValue = 0x3b;
+static constexpr std::size_t PduHeaderSize = 10;
+static constexpr std::uint8_t PduTypeCommandResponseRequired = 1;
+static constexpr std::uint8_t PduTypeNotification = 2;
+static constexpr std::uint8_t PduTypeResponse = 3;
+
+/**
+ * Response message within a received OCP.1 PDU. The parameter data is not copied, but points into
+ * the bytes of the PDU, which must outlive the view (See ForEachResponse).
+ */
+struct ResponseView
+{
+    std::uint32_t m_handle = 0;
+    std::uint8_t m_status = 0;
+    std::uint8_t m_paramCount = 0;
+    const std::uint8_t* m_paramData = nullptr;
+    std::size_t m_paramDataSize = 0;
+
+    /**
+     * Decode the parameters of the Response, i.e. value, minimum and maximum of OcaGain's GetGain.
+     *
+     * @param[out] values   The decoded values, in order.
+     * @return  True if all values could be decoded.
+     */
+    template <typename... Ts>
+    bool DecodeParams(Ts&... values) const
+    {
+        return Decode(m_paramData, m_paramDataSize, values...);
+    }
+};
+
+/**
+ * PropertyChanged Notification message within a received OCP.1 PDU. The value data is not copied, 
+ * but points into the bytes of the PDU, which must outlive the view (See ForEachNotification).
+ */
+struct NotificationView
+{
+    std::uint32_t m_emitterOno = 0;
+    std::uint16_t m_propDefLevel = 0;
+    std::uint16_t m_propIndex = 0;
+    const std::uint8_t* m_valueData = nullptr;
+    std::size_t m_valueDataSize = 0;
+    std::uint8_t m_changeType = 0;
+};
+
+/**
+ * Call a function for each message of a received OCP.1 PDU of the given type. Every OCP.1 message 
+ * begins with its size (Uint32, including itself), which is used to step from one message to the next.
+ *
+ * @param[in] data      Pointer to the first byte of the PDU.
+ * @param[in] size      Number of bytes.
+ * @param[in] pduType   Expected PduType, i.e. PduTypeResponse.
+ * @param[in] callback  Function called with pointers to the first byte after the message size, 
+ *                      and to the end of the message. Returns false if the message is malformed.
+ * @return  False if the data is not a well-formed PDU of the given type.
+ */
+template <typename Callback>
+bool ForEachMessage(const void* data, std::size_t size, std::uint8_t pduType, Callback&& callback)
+{
+    auto pduStart = static_cast<const std::uint8_t*>(data);
+
+    std::uint8_t syncValue(0), receivedPduType(0);
+    std::uint16_t protocolVersion(0), messageCount(0);
+    std::uint32_t pduSize(0);
+    if (!Decode(pduStart, size, syncValue, protocolVersion, pduSize, receivedPduType, messageCount)
+        || (syncValue != PduSyncValue) || (receivedPduType != pduType) 
+        || (std::size_t(pduSize) + 1 < PduHeaderSize) || (std::size_t(pduSize) + 1 > size))
+        return false;
+
+    auto pos = pduStart + PduHeaderSize;
+    auto end = pduStart + pduSize + 1;
+    for (std::uint16_t i = 0; i < messageCount; i++)
+    {
+        std::uint32_t messageSize(0);
+        auto messageStart = pos;
+        if (!Codec<std::uint32_t>::Decode(pos, end, messageSize)
+            || (messageSize < sizeof(std::uint32_t))
+            || (messageSize > static_cast<std::size_t>(end - messageStart))
+            || !callback(pos, messageStart + messageSize))
+            return false;
+
+        pos = messageStart + messageSize;
+    }
+
+    return true;
+}
+
+/**
+ * Call a function for each Response message of a received OCP.1 PDU. The Responses are read 
+ * in place, without unmarshalling the PDU into message objects first.
+ *
+ * @param[in] data      Pointer to the first byte of the PDU.
+ * @param[in] size      Number of bytes.
+ * @param[in] callback  Function called with a ResponseView of each Response, in order.
+ * @return  False if the data is not a well-formed Response PDU.
+ */
+template <typename Callback>
+bool ForEachResponse(const void* data, std::size_t size, Callback&& callback)
+{
+    return ForEachMessage(data, size, PduTypeResponse, [&](const std::uint8_t* pos, const std::uint8_t* end)
+        {
+            // Handle (Uint32), StatusCode (Uint8), ParameterCount (Uint8), parameters.
+            ResponseView response;
+            if (!Decode(pos, static_cast<std::size_t>(end - pos), response.m_handle, response.m_status, response.m_paramCount))
+                return false;
+
+            response.m_paramData = pos + 6;
+            response.m_paramDataSize = static_cast<std::size_t>(end - response.m_paramData);
+            callback(static_cast<const ResponseView&>(response));
+            return true;
+        });
+}
+
+/**
+ * Call a function for each PropertyChanged Notification message of a received OCP.1 PDU. 
+ * The Notifications are read in place, without unmarshalling the PDU into message objects first,
+ * so that high rates of Notifications, i.e. from subscribed sensor readings, can be ingested cheaply.
+ *
+ * @param[in] data      Pointer to the first byte of the PDU.
+ * @param[in] size      Number of bytes.
+ * @param[in] callback  Function called with a NotificationView of each Notification, in order.
+ * @return  False if the data is not a well-formed Notification PDU.
+ */
+template <typename Callback>
+bool ForEachNotification(const void* data, std::size_t size, Callback&& callback)
+{
+    return ForEachMessage(data, size, PduTypeNotification, [&](const std::uint8_t* pos, const std::uint8_t* end)
+        {
+            // TargetONo (Uint32), MethodID (Uint16, Uint16), ParameterCount (Uint8), Context (OcaBlob), 
+            // EventData: EmitterONo (Uint32), EventID (Uint16, Uint16), PropertyID (Uint16, Uint16), 
+            // the new value, and ChangeType (Uint8) as last byte.
+            NotificationView notification;
+            std::uint32_t targetOno(0);
+            std::uint16_t methodDefLevel(0), methodIndex(0), eventDefLevel(0), eventIndex(0);
+            std::uint8_t paramCount(0);
+            if (!Codec<std::uint32_t>::Decode(pos, end, targetOno)
+                || !Codec<std::uint16_t>::Decode(pos, end, methodDefLevel)
+                || !Codec<std::uint16_t>::Decode(pos, end, methodIndex)
+                || !Codec<std::uint8_t>::Decode(pos, end, paramCount))
+                return false;
+
+            // Skip the context without copying it.
+            std::uint16_t contextSize(0);
+            if (!Codec<std::uint16_t>::Decode(pos, end, contextSize) || (contextSize > end - pos))
+                return false;
+            pos += contextSize;
+
+            if (!Codec<std::uint32_t>::Decode(pos, end, notification.m_emitterOno)
+                || !Codec<std::uint16_t>::Decode(pos, end, eventDefLevel)
+                || !Codec<std::uint16_t>::Decode(pos, end, eventIndex)
+                || !Codec<std::uint16_t>::Decode(pos, end, notification.m_propDefLevel)
+                || !Codec<std::uint16_t>::Decode(pos, end, notification.m_propIndex)
+                || (pos >= end))
+                return false;
+
+            notification.m_valueData = pos;
+            notification.m_valueDataSize = static_cast<std::size_t>(end - pos) - 1;
+            notification.m_changeType = *(end - 1);
+            callback(static_cast<const NotificationView&>(notification));
+            return true;
+        });
+}
+
+/**
+ * Handles from FirstInternalHandle upwards are reserved for Commands generated by the application itself,
+ * i.e. by ObjectTreeWalker and SubscriptionManager (See NextInternalHandle). Handles entered by the user
+ * are clamped to 1..LastUserHandle (See ClampUserHandle), so that Responses to either kind can never be confused.
+ */
+static constexpr std::uint32_t FirstInternalHandle = 0x80000000;
+static constexpr std::uint32_t LastUserHandle = FirstInternalHandle - 1;
+
+/**
+ * Clamp a handle entered by the user, or read from a config file, to the range of user-defined handles.
+ *
+ * @param[in] handle    The handle as parsed, i.e. with juce::String::getLargeIntValue.
+ * @return  The handle, limited to 1..LastUserHandle.
+ */
+constexpr std::uint32_t ClampUserHandle(std::int64_t handle)
+{
+    return (handle < 1) ? 1 : (handle > LastUserHandle) ? LastUserHandle : static_cast<std::uint32_t>(handle);
+}
+
+/**
+ * Get a new handle for a Command generated by the application itself. Thread-safe.
+ *
+ * @return  Handle of at least FirstInternalHandle, unique until about 2^31 further calls.
+ */
+std::uint32_t NextInternalHandle();
+
+/**
+ * Handle, target object and method of a Command within an OCP.1 PDU.
+ */
+struct CommandHeader
+{
+    std::uint32_t m_handle = 0;
+    std::uint32_t m_targetOno = 0;
+    std::uint16_t m_methodDefLevel = 0;
+    std::uint16_t m_methodIndex = 0;
+
+    /**
+     * @return  True if the other Command calls the same method of the same object, regardless of the handle.
+     */
+    bool HasSameMethod(const CommandHeader& other) const
+    {
+        return (m_targetOno == other.m_targetOno) && (m_methodDefLevel == other.m_methodDefLevel) 
+            && (m_methodIndex == other.m_methodIndex);
+    }
+};
+
+/**
+ * Get the handle, target object and method of the first Command of an OCP.1 PDU of Commands requiring a Response.
+ *
+ * @param[in] data      Pointer to the first byte of the PDU.
+ * @param[in] size      Number of bytes.
+ * @param[out] header   Handle, which the device will return in its Response, target object and method of the Command.
+ * @return  False if the data is not a well-formed PDU of Commands requiring a Response.
+ */
+inline bool GetCommandHeader(const void* data, std::size_t size, CommandHeader& header)
+{
+    // The Command begins with CommandSize (Uint32), Handle (Uint32), TargetONo (Uint32) 
+    // and MethodID (DefLevel and MethodIndex, both Uint16), right after the PDU header.
+    std::uint8_t syncValue(0), pduType(0);
+    std::uint16_t protocolVersion(0), messageCount(0);
+    std::uint32_t pduSize(0), commandSize(0);
+    return Decode(static_cast<const std::uint8_t*>(data), size, syncValue, protocolVersion, pduSize, pduType, messageCount, 
+                  commandSize, header.m_handle, header.m_targetOno, header.m_methodDefLevel, header.m_methodIndex)
+           && (syncValue == PduSyncValue) && (pduType == PduTypeCommandResponseRequired) && (messageCount > 0);
+}
+
+/**
+ * Call a function with the handle of each Command of an OCP.1 PDU of Commands requiring a Response,
+ * i.e. of a PDU pipelined by PduPipeline.
+ *
+ * @param[in] data      Pointer to the first byte of the PDU.
+ * @param[in] size      Number of bytes.
+ * @param[in] callback  Function called with the handle of each Command, in order.
+ * @return  False if the data is not a well-formed PDU of Commands requiring a Response.
+ */
+template <typename Callback>
+bool ForEachCommandHandle(const void* data, std::size_t size, Callback&& callback)
+{
+    return ForEachMessage(data, size, PduTypeCommandResponseRequired, [&](const std::uint8_t* pos, const std::uint8_t* end)
+        {
+            std::uint32_t handle(0);
+            if (!Codec<std::uint32_t>::Decode(pos, end, handle))
+                return false;
+
+            callback(handle);
+            return true;
+        });
+}
+
+/**
+ * Pipelines the messages of several PDUs of the same PduType, i.e. Commands requiring a Response, into as few PDUs 
+ * as possible, so that a device can process all of them within few network round trips. The header of the first 
+ * PDU added to each pipelined PDU is taken over, with PduSize and MessageCount updated once the PDU is complete.
+ */
+class PduPipeline
+{
+public:
+    /**
+     * @param[in] sendFunction      Function called with each complete pipelined PDU. Returns true if it could be sent.
+     * @param[in] maxMessagesPerPdu Number of messages after which a pipelined PDU is complete.
+     */
+    explicit PduPipeline(std::function<bool(const juce::MemoryBlock&)> sendFunction, int maxMessagesPerPdu = 64)
+        :   m_sendFunction(std::move(sendFunction)),
+            m_maxMessagesPerPdu(maxMessagesPerPdu)
+    {
+        jassert(m_maxMessagesPerPdu > 0 && m_maxMessagesPerPdu <= 0xffff);
+    }
+
+    ~PduPipeline()
+    {
+        jassert(m_numMessages == 0); // Call Flush before destruction!
+    }
+
+    /**
+     * Append the messages of a PDU, and send the pipelined PDU once it is complete.
+     *
+     * @param[in] pdu   PDU with a single message, as created by NanoOcp1.
+     */
+    void Add(const juce::MemoryBlock& pdu)
+    {
+        jassert(pdu.getSize() > PduHeaderSize);
+        if (m_pdu.isEmpty())
+            m_pdu.append(pdu.getData(), PduHeaderSize);
+
+        m_pdu.append(static_cast<const char*>(pdu.getData()) + PduHeaderSize, pdu.getSize() - PduHeaderSize);
+        if (++m_numMessages >= m_maxMessagesPerPdu)
+            Flush();
+    }
+
+    /**
+     * Send the pipelined PDU, even if it is not complete yet.
+     */
+    void Flush()
+    {
+        if (m_numMessages == 0)
+            return;
+
+        // PduSize follows SyncVal and ProtocolVersion, MessageCount follows PduSize and PduType.
+        auto header = static_cast<std::uint8_t*>(m_pdu.getData());
+        Codec<std::uint32_t>::Encode(static_cast<std::uint32_t>(m_pdu.getSize() - 1), header + 3);
+        Codec<std::uint16_t>::Encode(static_cast<std::uint16_t>(m_numMessages), header + 8);
+        m_sendFunction(m_pdu);
+
+        m_pdu.reset();
+        m_numMessages = 0;
+    }
+
+private:
+    std::function<bool(const juce::MemoryBlock&)> m_sendFunction;
+    int m_maxMessagesPerPdu;
+    juce::MemoryBlock m_pdu;
+    int m_numMessages = 0;
+};
+
+/**
+ * NanoOcp1 has no data types for the template types OcaList and OcaMap, so their data types are composed 
+ * from the NanoOcp1 data types of their items: Bits 0 to 7 hold the item (or map value) data type, 
+ * bits 8 to 11 the map key data type. Only lists and maps of NanoOcp1 data types are supported, not nested ones.
+ */
+static constexpr int DataTypeListFlag = 0x1000;
+static constexpr int DataTypeMapFlag = 0x2000;
+static constexpr int DataTypeKeyShift = 8;
+static constexpr int DataTypeItemMask = 0xff;
+static constexpr int DataTypeKeyMask = 0x0f;
+
+constexpr int MakeListDataType(int itemDataType)
+{
+    return DataTypeListFlag | (itemDataType & DataTypeItemMask);
+}
+
+constexpr int MakeMapDataType(int keyDataType, int valueDataType)
+{
+    return DataTypeMapFlag | ((keyDataType & DataTypeKeyMask) << DataTypeKeyShift) | (valueDataType & DataTypeItemMask);
+}
+
+constexpr bool IsListDataType(int dataType)
+{
+    return (dataType & DataTypeListFlag) != 0;
+}
+
+constexpr bool IsMapDataType(int dataType)
+{
+    return (dataType & DataTypeMapFlag) != 0;
+}
+
+constexpr int GetItemDataType(int dataType)
+{
+    return dataType & DataTypeItemMask;
+}
+
+constexpr int GetKeyDataType(int dataType)
+{
+    return (dataType >> DataTypeKeyShift) & DataTypeKeyMask;
+}
+
+/**
+ * Encoding and decoding of values given as strings, as stored in config files (See OcaRoot::CreateParamDataFromString),
+ * for one OCP.1 data type. Each instance forwards to the Codec of the C++ type matching the data type, 
+ * so that the data type only needs to be resolved once (See GetValueCodec) rather than for every value.
+ *
+ * Value strings of the different data types look as follows:
+ *  - Numbers and strings: The value itself. Texts of ComboBox items such as "1: True" count by their leading number.
+ *  - OcaBlob:  The bytes as hex text, i.e. "0a1b2c". Alternatively "@" followed by the path of a file, 
+ *              whose content is copied straight from a memory-mapped view into the encoded data.
+ *  - OcaList:  The items separated by '|', i.e. "Off|Low|High".
+ *  - OcaMap:   The entries separated by '|', each with key and value separated by '=', i.e. "1=Off|2=On".
+ */
+struct ValueCodec
+{
+    /**
+     * Check whether the value can be encoded without losing data. Returns false, with a description of 
+     * the problem in errorMessage, i.e. if the file of a blob cannot be read or exceeds the Uint16 byte count.
+     */
+    bool (*m_validate)(const juce::String& valueString, juce::String& errorMessage);
+
+    /**
+     * Get the number of bytes of the encoded value.
+     */
+    std::size_t (*m_size)(const juce::String& valueString);
+
+    /**
+     * Write the encoded value to dest. At most (end - dest) bytes are written, which only matters
+     * if the value changed since m_size was called, i.e. when the file of a blob was modified.
+     * Returns the pointer following the written bytes, or nullptr if the value could not be 
+     * encoded completely, i.e. because the file of a blob has grown or become unreadable.
+     */
+    std::uint8_t* (*m_encode)(const juce::String& valueString, std::uint8_t* dest, std::uint8_t* end);
+
+    /**
+     * Read an encoded value from src, which is advanced past the read bytes. 
+     * Returns false if the bytes up to end do not hold a complete value.
+     */
+    bool (*m_decode)(const std::uint8_t*& src, const std::uint8_t* end, juce::String& valueString);
+};
+
+/**
+ * Get the ValueCodec of an OCP.1 data type.
+ *
+ * @param[in] dataType  NanoOcp1 data type, i.e. NanoOcp1::OCP1DATATYPE_FLOAT32,
+ *                      or a list or map data type (See MakeListDataType and MakeMapDataType).
+ * @return  Pointer to the ValueCodec, or nullptr if the data type is not supported.
+ */
+const ValueCodec* GetValueCodec(int dataType);
+
+} // namespace AES70
@@ -0,0 +1,97 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#include "AES70Components.h"
+#include "AES70Codec.h"
+#include "AES70Schema.h"
+
+
+namespace AES70Components
+{
+
+juce::Component* CreateComponentForProperty(const AES70::OcaRoot& object, 
+                                            const AES70::Property& prop, 
+                                            const std::function<void()>& onChangeFunction)
+{
+    // Properties which are not in the Schema, such as that of an OcaCustomClass, 
+    // are represented based on their data type alone.
+    AES70::PropertyDefinition typeDefinition;
+    auto definition = AES70::Schema::GetInstance().GetPropertyDefinition(object.GetClassIdx(), prop.m_defLevel, prop.m_index);
+    if (definition == nullptr)
+    {
+        typeDefinition = AES70::Schema::CreateDefinitionForType(prop);
+        definition = &typeDefinition;
+    }
+
+    auto classDefinition = AES70::Schema::GetInstance().GetClass(object.GetClassIdx());
+    auto componentName = (classDefinition != nullptr ? classDefinition->m_name : juce::String("OcaCustomClass")) 
+                         + "." + prop.m_name;
+
+    // Enumerated properties: offer all enumerators.
+    if (!definition->m_items.isEmpty())
+    {
+        auto pComboBox = new juce::ComboBox(componentName);
+        pComboBox->setHasFocusOutline(true);
+        pComboBox->addItemList(definition->m_items, 1);
+        pComboBox->setSelectedId(juce::jmax(1, definition->m_items.indexOf(definition->m_defaultValue) + 1), juce::sendNotification);
+        pComboBox->onChange = [=]()
+        {
+            onChangeFunction();
+        };
+
+        return pComboBox;
+    }
+
+    // Strings, blobs, lists and maps are entered as text (See AES70::ValueCodec).
+    if (prop.m_type == NanoOcp1::OCP1DATATYPE_STRING || prop.m_type == NanoOcp1::OCP1DATATYPE_BLOB
+        || AES70::IsListDataType(prop.m_type) || AES70::IsMapDataType(prop.m_type))
+    {
+        auto pTextEditor = new juce::TextEditor(componentName);
+        pTextEditor->setHasFocusOutline(true);
+        pTextEditor->setIndents(pTextEditor->getLeftIndent(), 0); // Fix for JUCE justification bug
+        pTextEditor->setJustification(juce::Justification(juce::Justification::centredLeft));
+        pTextEditor->setText(definition->m_defaultValue);
+        pTextEditor->onTextChange = [=]()
+        {
+            onChangeFunction();
+        };
+
+        return pTextEditor;
+    }
+
+    // Numeric properties: offer the defined range.
+    auto pSlider = new juce::Slider(juce::Slider::LinearBar, juce::Slider::TextBoxBelow);
+    pSlider->setName(componentName);
+    pSlider->setHasFocusOutline(true);
+    pSlider->setRange(definition->m_minValue, definition->m_maxValue, definition->m_interval);
+    pSlider->setValue(definition->m_defaultValue.getDoubleValue(), juce::dontSendNotification);
+    pSlider->onValueChange = [=]()
+    {
+        onChangeFunction();
+    };
+
+    return pSlider;
+}
+
+} // namespace AES70Components
@@ -0,0 +1,55 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AES70.h"
+
+
+/**
+ * GUI representation of the AES70 class model. The class model itself (See AES70.h) does not depend 
+ * on any GUI code, so that it can be used by headless tools which only link juce_core and NanoOcp.
+ */
+namespace AES70Components
+{
+
+/**
+ * Create a component which can be used to represent an AES70 class property on a GUI.
+ * Values of the created components are read and written as strings, see StringGeneratorContainer.
+ * 
+ * The type of component, and the values it offers, are given by the property's definition in the Schema.
+ * 
+ * @param[in] object    The AES70 object, whose class determines which properties it has.
+ * @param[in] prop      The class property, whose definition level and index identify its definition
+ *                      in the Schema. Properties without definition are represented by data type alone.
+ * @param[in] onChangeFunction  Method which shall be called whenever the value on the created component changes.
+ * @return  A pointer to a juce::Component to be used on the GUI. 
+ *          NOTE: Ownership of the object is responsibility of the caller of the method. 
+ */
+juce::Component* CreateComponentForProperty(const AES70::OcaRoot& object, 
+                                            const AES70::Property& prop, 
+                                            const std::function<void()>& onChangeFunction);
+
+} // namespace AES70Components
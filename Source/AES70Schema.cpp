@@ -0,0 +1,1008 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#include "AES70Schema.h"
+#include "AES70Codec.h"
+
+#include <string_view>
+
+
+namespace AES70
+{
+
+/**
+ * Compiled-in schema entry of a standard AES70 class.
+ */
+struct StandardClassEntry
+{
+    const char* m_name;
+    const char* m_classId;
+    int m_parentIdx;
+};
+
+/**
+ * Compiled-in schema entry of a property of a standard AES70 class.
+ */
+struct StandardPropertyEntry
+{
+    int m_classIdx;
+    int m_index;
+    int m_type;
+    const char* m_name;
+    int m_getMethodIdx;
+    int m_setMethodIdx;
+    double m_minValue;
+    double m_maxValue;
+    double m_interval;
+    const char* m_defaultValue;
+    const char* m_items;        // See Schema::ParseItems.
+};
+
+/**
+ * Compiled-in schema entry of a method of a standard AES70 class.
+ */
+struct StandardMethodEntry
+{
+    int m_classIdx;
+    int m_index;
+    const char* m_name;
+    int m_numParams;
+    MethodParam m_params[3];
+    int m_numReturns;
+    MethodParam m_returns[3];
+};
+
+/**
+ * Standard AES70 classes, in the order of the ClassIdx enum.
+ */
+static constexpr StandardClassEntry StandardClasses[] = {
+    { "OcaRoot",                "1",            0 },
+    { "OcaWorker",              "1.1",          OCA_ROOT },
+    { "OcaActuator",            "1.1.1",        OCA_WORKER },
+    { "OcaBasicActuator",       "1.1.1.1",      OCA_ACTUATOR },
+    { "OcaInt32Actuator",       "1.1.1.1.4",    OCA_BASIC_ACTUATOR },
+    { "OcaStringActuator",      "1.1.1.1.12",   OCA_BASIC_ACTUATOR },
+    { "OcaMute",                "1.1.1.2",      OCA_ACTUATOR },
+    { "OcaSwitch",              "1.1.1.4",      OCA_ACTUATOR },
+    { "OcaGain",                "1.1.1.5",      OCA_ACTUATOR },
+    { "OcaDelay",               "1.1.1.7",      OCA_ACTUATOR },
+    { "OcaSensor",              "1.1.2",        OCA_WORKER },
+    { "OcaBasicSensor",         "1.1.2.1",      OCA_SENSOR },
+    { "OcaBooleanSensor",       "1.1.2.1.1",    OCA_BASIC_SENSOR },
+    { "OcaInt32Sensor",         "1.1.2.1.4",    OCA_BASIC_SENSOR },
+    { "OcaFloat32Sensor",       "1.1.2.1.10",   OCA_BASIC_SENSOR },
+    { "OcaStringSensor",        "1.1.2.1.12",   OCA_BASIC_SENSOR },
+    { "OcaLevelSensor",         "1.1.2.2",      OCA_SENSOR },
+    { "OcaAudioLevelSensor",    "1.1.2.2.1",    OCA_LEVEL_SENSOR },
+    { "OcaAgent",               "1.2",          OCA_ROOT }
+};
+
+static_assert(sizeof(StandardClasses) / sizeof(StandardClasses[0]) == OCA_MAX_CLASS_IDX - 1, 
+              "StandardClasses must contain one entry per ClassIdx");
+
+/**
+ * Properties of the standard AES70 classes, grouped per class in the order of StandardClasses.
+ */
+static constexpr StandardPropertyEntry StandardProperties[] = {
+    // classIdx                 idx type                                name            get set min         max         interval    default         items
+    { OCA_ROOT,                 5,  NanoOcp1::OCP1DATATYPE_STRING,      "Role",         5,  0,  0.0,        0.0,        1.0,        "Some text",    "" },
+    { OCA_WORKER,               1,  NanoOcp1::OCP1DATATYPE_BOOLEAN,     "Enabled",      1,  2,  0.0,        0.0,        1.0,        "1: True",      "1: True|0: False" },
+    { OCA_INT32_ACTUATOR,       1,  NanoOcp1::OCP1DATATYPE_INT32,       "Setting",      1,  2,  -65535.0,   65535.0,    1.0,        "0",            "" },
+    { OCA_STRING_ACTUATOR,      1,  NanoOcp1::OCP1DATATYPE_STRING,      "Setting",      1,  2,  0.0,        0.0,        1.0,        "Some text",    "" },
+    { OCA_STRING_ACTUATOR,      2,  NanoOcp1::OCP1DATATYPE_UINT16,      "MaxLen",       3,  0,  0.0,        1024.0,     1.0,        "0",            "" },
+    { OCA_MUTE,                 1,  NanoOcp1::OCP1DATATYPE_UINT8,       "Mute",         1,  2,  0.0,        0.0,        1.0,        "1: Mute",      "1: Mute|2: Unmute" },
+    { OCA_SWITCH,               1,  NanoOcp1::OCP1DATATYPE_UINT16,      "Position",     1,  2,  0.0,        126.0,      1.0,        "0",            "0..126" },
+    { OCA_GAIN,                 1,  NanoOcp1::OCP1DATATYPE_FLOAT32,     "Gain",         1,  2,  -120.0,     12.0,       0.01,       "0",            "" },
+    { OCA_DELAY,                1,  NanoOcp1::OCP1DATATYPE_FLOAT32,     "DelayTime",    1,  2,  0.0,        65535.0,    0.001,      "0",            "" },
+    { OCA_SENSOR,               1,  NanoOcp1::OCP1DATATYPE_UINT8,       "ReadingState", 1,  0,  0.0,        0.0,        1.0,        "1: Valid",     "0: Unknown|1: Valid|2: UnderRange|3: OverRange|4: Error" },
+    { OCA_BOOLEAN_SENSOR,       1,  NanoOcp1::OCP1DATATYPE_BOOLEAN,     "Reading",      1,  0,  0.0,        0.0,        1.0,        "1: True",      "1: True|0: False" },
+    { OCA_INT32_SENSOR,         1,  NanoOcp1::OCP1DATATYPE_INT32,       "Reading",      1,  0,  -65535.0,   65535.0,    1.0,        "0",            "" },
+    { OCA_FLOAT32_SENSOR,       1,  NanoOcp1::OCP1DATATYPE_FLOAT32,     "Reading",      1,  0,  -65535.0,   65535.0,    0.001,      "0",            "" },
+    { OCA_STRING_SENSOR,        1,  NanoOcp1::OCP1DATATYPE_STRING,      "Reading",      1,  0,  0.0,        0.0,        1.0,        "Some text",    "" },
+    { OCA_STRING_SENSOR,        2,  NanoOcp1::OCP1DATATYPE_UINT16,      "MaxLen",       2,  3,  0.0,        1024.0,     1.0,        "0",            "" },
+    { OCA_LEVEL_SENSOR,         1,  NanoOcp1::OCP1DATATYPE_FLOAT32,     "Reading",      1,  0,  -120.0,     12.0,       0.001,      "0",            "" },
+    { OCA_AUDIO_LEVEL_SENSOR,   1,  NanoOcp1::OCP1DATATYPE_UINT8,       "Law",          1,  2,  0.0,        0.0,        1.0,        "1: VU",        "1: VU|2: Standard VU|3: PPM1|4: PPM2|5: LKFS|6: RMS|7: PEAK" },
+    { OCA_AGENT,                1,  NanoOcp1::OCP1DATATYPE_STRING,      "Label",        1,  2,  0.0,        0.0,        1.0,        "Some text",    "" }
+};
+
+static constexpr std::size_t NumStandardClasses = sizeof(StandardClasses) / sizeof(StandardClasses[0]);
+
+
+//==============================================================================
+// Perfect hashing
+//==============================================================================
+
+static constexpr std::uint32_t HashOffsetBasis = 2166136261u; // FNV-1a 32 bit offset basis.
+static constexpr std::uint32_t HashPrime = 16777619u; // FNV-1a 32 bit prime.
+static constexpr std::uint32_t BucketHashSeed = 0x9e3779b9u; // Seed of the hash which assigns keys to buckets.
+static constexpr std::uint32_t MaxBucketSeed = 0xffff; // Largest seed tried per bucket.
+static constexpr std::size_t MaxLookupKeys = Schema::MaxClassIdx; // Largest number of keys of a lookup table.
+
+/**
+ * Number of buckets of a lookup table, about two keys per bucket.
+ */
+static constexpr std::size_t GetNumBuckets(std::size_t numKeys)
+{
+    return numKeys / 2 + 1;
+}
+
+/**
+ * Number of slots of a lookup table: the power of two keeping at least half of the slots unused.
+ */
+static constexpr std::size_t GetTableSize(std::size_t numKeys)
+{
+    std::size_t tableSize = 16;
+    while (tableSize < 2 * numKeys)
+        tableSize *= 2;
+    return tableSize;
+}
+
+static constexpr std::size_t MaxLookupBuckets = GetNumBuckets(MaxLookupKeys);
+
+static constexpr std::uint32_t HashByte(std::uint32_t hash, std::uint8_t byte)
+{
+    return (hash ^ byte) * HashPrime;
+}
+
+static constexpr std::uint32_t FinalizeHash(std::uint32_t hash)
+{
+    return hash ^ (hash >> 16);
+}
+
+/**
+ * Hash of a class name.
+ */
+static constexpr std::uint32_t HashString(std::string_view key, std::uint32_t seed)
+{
+    auto hash = HashOffsetBasis ^ seed;
+    for (auto c : key)
+        hash = HashByte(hash, static_cast<std::uint8_t>(c));
+    return FinalizeHash(hash);
+}
+
+/**
+ * Hash of a binary ClassID.
+ */
+static constexpr std::uint32_t HashBytes(const std::uint8_t* data, std::size_t size, std::uint32_t seed)
+{
+    auto hash = HashOffsetBasis ^ seed;
+    for (std::size_t i = 0; i < size; i++)
+        hash = HashByte(hash, data[i]);
+    return FinalizeHash(hash);
+}
+
+/**
+ * Hash of a dotted ClassID. Hashes the same bytes as Schema::EncodeClassId would produce,
+ * so that dotted and binary ClassIDs share one lookup table.
+ */
+static constexpr std::uint32_t HashClassId(std::string_view classId, std::uint32_t seed)
+{
+    std::uint16_t numFields = 1;
+    for (auto c : classId)
+        numFields += (c == '.') ? 1 : 0;
+
+    auto hash = HashOffsetBasis ^ seed;
+    hash = HashByte(hash, static_cast<std::uint8_t>(numFields >> 8));
+    hash = HashByte(hash, static_cast<std::uint8_t>(numFields & 0xff));
+
+    std::uint16_t field = 0;
+    for (std::size_t i = 0; i <= classId.size(); i++)
+    {
+        if (i == classId.size() || classId[i] == '.')
+        {
+            hash = HashByte(hash, static_cast<std::uint8_t>(field >> 8));
+            hash = HashByte(hash, static_cast<std::uint8_t>(field & 0xff));
+            field = 0;
+        }
+        else
+        {
+            field = static_cast<std::uint16_t>(field * 10 + (classId[i] - '0'));
+        }
+    }
+
+    return FinalizeHash(hash);
+}
+
+/**
+ * Fill a lookup table such that each key gets a slot of its own (See ClassLookupTable).
+ * Buckets holding the most keys are placed first, while most slots are still unused.
+ *
+ * @param[in] hashOf        Function returning the hash of the key at the given position, using the given seed.
+ * @param[in] numKeys       Number of keys. The key at position i is stored as i + 1.
+ * @param[out] bucketSeeds  Seed per bucket.
+ * @param[in] numBuckets    Number of buckets, see GetNumBuckets.
+ * @param[out] slots        Key per slot.
+ * @param[in] tableSize     Number of slots, see GetTableSize.
+ * @return  True if a seed was found for every bucket.
+ */
+template <typename HashFunction>
+static constexpr bool BuildPerfectHash(HashFunction hashOf, std::size_t numKeys,
+                                       std::uint16_t* bucketSeeds, std::size_t numBuckets,
+                                       std::uint8_t* slots, std::size_t tableSize)
+{
+    if (numKeys > MaxLookupKeys || numBuckets > MaxLookupBuckets)
+        return false;
+
+    std::size_t bucketOfKey[MaxLookupKeys] = {};
+    std::size_t bucketSizes[MaxLookupBuckets] = {};
+    std::size_t maxBucketSize = 0;
+    for (std::size_t key = 0; key < numKeys; key++)
+    {
+        bucketOfKey[key] = hashOf(key, BucketHashSeed) % numBuckets;
+        auto bucketSize = ++bucketSizes[bucketOfKey[key]];
+        maxBucketSize = (bucketSize > maxBucketSize) ? bucketSize : maxBucketSize;
+    }
+
+    for (std::size_t slot = 0; slot < tableSize; slot++)
+        slots[slot] = 0;
+    for (std::size_t bucket = 0; bucket < numBuckets; bucket++)
+        bucketSeeds[bucket] = 0;
+
+    std::size_t bucketKeys[MaxLookupKeys] = {};
+    std::size_t bucketSlots[MaxLookupKeys] = {};
+    for (auto size = maxBucketSize; size > 0; size--)
+    {
+        for (std::size_t bucket = 0; bucket < numBuckets; bucket++)
+        {
+            if (bucketSizes[bucket] != size)
+                continue;
+
+            std::size_t numBucketKeys = 0;
+            for (std::size_t key = 0; key < numKeys; key++)
+            {
+                if (bucketOfKey[key] == bucket)
+                    bucketKeys[numBucketKeys++] = key;
+            }
+
+            // Try seeds until all keys of the bucket land in distinct, unused slots.
+            bool placed = false;
+            for (std::uint32_t seed = 0; seed <= MaxBucketSeed && !placed; seed++)
+            {
+                placed = true;
+                for (std::size_t i = 0; i < numBucketKeys && placed; i++)
+                {
+                    bucketSlots[i] = hashOf(bucketKeys[i], seed) & (tableSize - 1);
+                    placed = (slots[bucketSlots[i]] == 0);
+                    for (std::size_t j = 0; j < i && placed; j++)
+                        placed = (bucketSlots[j] != bucketSlots[i]);
+                }
+
+                if (placed)
+                {
+                    bucketSeeds[bucket] = static_cast<std::uint16_t>(seed);
+                    for (std::size_t i = 0; i < numBucketKeys; i++)
+                        slots[bucketSlots[i]] = static_cast<std::uint8_t>(bucketKeys[i] + 1);
+                }
+            }
+
+            if (!placed)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Look up the slot of a key (See ClassLookupTable).
+ *
+ * @param[in] table     The lookup table.
+ * @param[in] hashOf    Function returning the hash of the key, using the given seed.
+ * @return  The class index stored in the key's slot, which must still be compared with the key.
+ */
+template <typename HashFunction>
+static int LookUp(const ClassLookupTable& table, HashFunction hashOf)
+{
+    if (table.m_slots.empty())
+        return 0;
+
+    auto bucket = hashOf(BucketHashSeed) % table.m_bucketSeeds.size();
+    return table.m_slots[hashOf(table.m_bucketSeeds[bucket]) & (table.m_slots.size() - 1)];
+}
+
+/**
+ * Lookup table over the standard classes, computed at compile time.
+ */
+struct StandardClassLookupTable
+{
+    std::uint16_t m_bucketSeeds[GetNumBuckets(NumStandardClasses)] = {};
+    std::uint8_t m_slots[GetTableSize(NumStandardClasses)] = {};
+    bool m_valid = false;
+
+    template <typename HashFunction>
+    static constexpr StandardClassLookupTable Create(HashFunction hashOf)
+    {
+        StandardClassLookupTable table;
+        table.m_valid = BuildPerfectHash(hashOf, NumStandardClasses, 
+                                         table.m_bucketSeeds, GetNumBuckets(NumStandardClasses), 
+                                         table.m_slots, GetTableSize(NumStandardClasses));
+        return table;
+    }
+
+    ClassLookupTable ToLookupTable() const
+    {
+        return { { std::begin(m_bucketSeeds), std::end(m_bucketSeeds) }, { std::begin(m_slots), std::end(m_slots) } };
+    }
+};
+
+static constexpr auto StandardClassesByName = StandardClassLookupTable::Create(
+    [](std::size_t key, std::uint32_t seed) { return HashString(StandardClasses[key].m_name, seed); });
+static constexpr auto StandardClassesByClassId = StandardClassLookupTable::Create(
+    [](std::size_t key, std::uint32_t seed) { return HashClassId(StandardClasses[key].m_classId, seed); });
+
+static_assert(StandardClassesByName.m_valid, "No perfect hash found for the standard class names");
+static_assert(StandardClassesByClassId.m_valid, "No perfect hash found for the standard ClassIDs");
+
+
+static constexpr MethodParam BooleanValue = { NanoOcp1::OCP1DATATYPE_BOOLEAN, PARAM_ROLE_VALUE };
+static constexpr MethodParam Uint8Value = { NanoOcp1::OCP1DATATYPE_UINT8, PARAM_ROLE_VALUE };
+static constexpr MethodParam Uint16Value = { NanoOcp1::OCP1DATATYPE_UINT16, PARAM_ROLE_VALUE };
+static constexpr MethodParam Uint16Min = { NanoOcp1::OCP1DATATYPE_UINT16, PARAM_ROLE_MIN };
+static constexpr MethodParam Uint16Max = { NanoOcp1::OCP1DATATYPE_UINT16, PARAM_ROLE_MAX };
+static constexpr MethodParam Int32Value = { NanoOcp1::OCP1DATATYPE_INT32, PARAM_ROLE_VALUE };
+static constexpr MethodParam Int32Min = { NanoOcp1::OCP1DATATYPE_INT32, PARAM_ROLE_MIN };
+static constexpr MethodParam Int32Max = { NanoOcp1::OCP1DATATYPE_INT32, PARAM_ROLE_MAX };
+static constexpr MethodParam Float32Value = { NanoOcp1::OCP1DATATYPE_FLOAT32, PARAM_ROLE_VALUE };
+static constexpr MethodParam Float32Min = { NanoOcp1::OCP1DATATYPE_FLOAT32, PARAM_ROLE_MIN };
+static constexpr MethodParam Float32Max = { NanoOcp1::OCP1DATATYPE_FLOAT32, PARAM_ROLE_MAX };
+static constexpr MethodParam StringValue = { NanoOcp1::OCP1DATATYPE_STRING, PARAM_ROLE_VALUE };
+
+/**
+ * Methods of the standard AES70 classes, grouped per class in the order of StandardClasses.
+ * Getters of ranged properties return the property's minimum and maximum along with its value.
+ */
+static constexpr StandardMethodEntry StandardMethods[] = {
+    // classIdx                 idx name                params                  returns
+    { OCA_ROOT,                 5,  "GetRole",          0, {},                  1, { StringValue } },
+    { OCA_WORKER,               1,  "GetEnabled",       0, {},                  1, { BooleanValue } },
+    { OCA_WORKER,               2,  "SetEnabled",       1, { BooleanValue },    0, {} },
+    { OCA_INT32_ACTUATOR,       1,  "GetSetting",       0, {},                  3, { Int32Value, Int32Min, Int32Max } },
+    { OCA_INT32_ACTUATOR,       2,  "SetSetting",       1, { Int32Value },      0, {} },
+    { OCA_STRING_ACTUATOR,      1,  "GetSetting",       0, {},                  1, { StringValue } },
+    { OCA_STRING_ACTUATOR,      2,  "SetSetting",       1, { StringValue },     0, {} },
+    { OCA_STRING_ACTUATOR,      3,  "GetMaxLen",        0, {},                  1, { Uint16Value } },
+    { OCA_MUTE,                 1,  "GetState",         0, {},                  1, { Uint8Value } },
+    { OCA_MUTE,                 2,  "SetState",         1, { Uint8Value },      0, {} },
+    { OCA_SWITCH,               1,  "GetPosition",      0, {},                  3, { Uint16Value, Uint16Min, Uint16Max } },
+    { OCA_SWITCH,               2,  "SetPosition",      1, { Uint16Value },     0, {} },
+    { OCA_GAIN,                 1,  "GetGain",          0, {},                  3, { Float32Value, Float32Min, Float32Max } },
+    { OCA_GAIN,                 2,  "SetGain",          1, { Float32Value },    0, {} },
+    { OCA_DELAY,                1,  "GetDelayTime",     0, {},                  3, { Float32Value, Float32Min, Float32Max } },
+    { OCA_DELAY,                2,  "SetDelayTime",     1, { Float32Value },    0, {} },
+    { OCA_SENSOR,               1,  "GetReadingState",  0, {},                  1, { Uint8Value } },
+    { OCA_BOOLEAN_SENSOR,       1,  "GetReading",       0, {},                  1, { BooleanValue } },
+    { OCA_INT32_SENSOR,         1,  "GetReading",       0, {},                  3, { Int32Value, Int32Min, Int32Max } },
+    { OCA_FLOAT32_SENSOR,       1,  "GetReading",       0, {},                  3, { Float32Value, Float32Min, Float32Max } },
+    { OCA_STRING_SENSOR,        1,  "GetString",        0, {},                  1, { StringValue } },
+    { OCA_STRING_SENSOR,        2,  "GetMaxLen",        0, {},                  1, { Uint16Value } },
+    { OCA_STRING_SENSOR,        3,  "SetMaxLen",        1, { Uint16Value },     0, {} },
+    { OCA_LEVEL_SENSOR,         1,  "GetReading",       0, {},                  3, { Float32Value, Float32Min, Float32Max } },
+    { OCA_AUDIO_LEVEL_SENSOR,   1,  "GetLaw",           0, {},                  1, { Uint8Value } },
+    { OCA_AUDIO_LEVEL_SENSOR,   2,  "SetLaw",           1, { Uint8Value },      0, {} },
+    { OCA_AGENT,                1,  "GetLabel",         0, {},                  1, { StringValue } },
+    { OCA_AGENT,                2,  "SetLabel",         1, { StringValue },     0, {} }
+};
+
+/**
+ * Names of the parameter roles in schema files, in the order of the ParamRole enum.
+ */
+static const juce::StringArray ParamRoleNames = { "value", "min", "max" };
+
+/**
+ * Data types which properties can have.
+ */
+static constexpr int SupportedDataTypes[] = {
+    NanoOcp1::OCP1DATATYPE_BOOLEAN, NanoOcp1::OCP1DATATYPE_INT8, NanoOcp1::OCP1DATATYPE_INT16,
+    NanoOcp1::OCP1DATATYPE_INT32, NanoOcp1::OCP1DATATYPE_INT64, NanoOcp1::OCP1DATATYPE_UINT8,
+    NanoOcp1::OCP1DATATYPE_UINT16, NanoOcp1::OCP1DATATYPE_UINT32, NanoOcp1::OCP1DATATYPE_UINT64,
+    NanoOcp1::OCP1DATATYPE_FLOAT32, NanoOcp1::OCP1DATATYPE_FLOAT64, NanoOcp1::OCP1DATATYPE_STRING,
+    NanoOcp1::OCP1DATATYPE_BLOB
+};
+
+/**
+ * Names of the OcaList and OcaMap template types, as used by GetDataTypeName.
+ */
+static const juce::String ListTypeName("OcaList");
+static const juce::String MapTypeName("OcaMap");
+
+/**
+ * Items offered for boolean properties.
+ */
+static const juce::StringArray BooleanItems = { "1: True", "0: False" };
+
+
+/**
+ * Helper method to check whether a dotted ClassID consists of fields that each fit into a Uint16.
+ *
+ * @param[in] classId   Dotted ClassID, i.e. "1.1.1.5".
+ * @return  True if the ClassID is valid.
+ */
+static bool IsValidClassId(const juce::String& classId)
+{
+    if (classId.isEmpty() || !classId.containsOnly("0123456789."))
+        return false;
+
+    auto fields = juce::StringArray::fromTokens(classId, ".", {});
+    return std::all_of(fields.begin(), fields.end(), 
+                       [](const juce::String& field) { return field.isNotEmpty() && field.getLargeIntValue() <= 0xffff; });
+}
+
+
+//==============================================================================
+// Class Schema
+//==============================================================================
+
+Schema::Schema()
+    :   m_numStandardClasses(0)
+{
+    m_classes.reserve(OCA_MAX_CLASS_IDX - 1);
+    m_properties.reserve(sizeof(StandardProperties) / sizeof(StandardProperties[0]));
+    m_methods.reserve(sizeof(StandardMethods) / sizeof(StandardMethods[0]));
+
+    int classIdx(OCA_ROOT);
+    for (const auto& classEntry : StandardClasses)
+    {
+        AddClass(classEntry.m_name, classEntry.m_classId, classEntry.m_parentIdx);
+
+        for (const auto& propEntry : StandardProperties)
+        {
+            if (propEntry.m_classIdx != classIdx)
+                continue;
+
+            PropertyDefinition definition;
+            definition.m_property = { 0, propEntry.m_index, propEntry.m_type, propEntry.m_name, 
+                                      propEntry.m_getMethodIdx, propEntry.m_setMethodIdx };
+            definition.m_minValue = propEntry.m_minValue;
+            definition.m_maxValue = propEntry.m_maxValue;
+            definition.m_interval = propEntry.m_interval;
+            definition.m_defaultValue = propEntry.m_defaultValue;
+            definition.m_items = ParseItems(propEntry.m_items);
+            AddProperty(std::move(definition));
+        }
+
+        for (const auto& methodEntry : StandardMethods)
+        {
+            if (methodEntry.m_classIdx != classIdx)
+                continue;
+
+            MethodDefinition definition;
+            definition.m_index = methodEntry.m_index;
+            definition.m_name = methodEntry.m_name;
+            definition.m_params.assign(methodEntry.m_params, methodEntry.m_params + methodEntry.m_numParams);
+            definition.m_returns.assign(methodEntry.m_returns, methodEntry.m_returns + methodEntry.m_numReturns);
+            AddMethod(std::move(definition));
+        }
+
+        classIdx++;
+    }
+
+    m_numStandardClasses = GetNumClasses();
+    m_classesByName = StandardClassesByName.ToLookupTable();
+    m_classesByClassId = StandardClassesByClassId.ToLookupTable();
+}
+
+Schema& Schema::GetInstance()
+{
+    static Schema instance;
+    return instance;
+}
+
+bool Schema::LoadFromFile(const juce::File& schemaFile, juce::String& errorMessage)
+{
+    auto schemaXml = juce::XmlDocument::parse(schemaFile);
+    if (!schemaXml)
+    {
+        errorMessage = "Could not parse " + schemaFile.getFullPathName();
+        return false;
+    }
+
+    return LoadFromXml(*schemaXml, errorMessage);
+}
+
+bool Schema::LoadFromXml(const juce::XmlElement& schemaXml, juce::String& errorMessage)
+{
+    if (!schemaXml.hasTagName("AES70Schema"))
+    {
+        errorMessage = "Root element is not AES70Schema";
+        return false;
+    }
+
+    // Appended classes are removed again if any problem is found.
+    auto numClasses = m_classes.size();
+    auto numProperties = m_properties.size();
+    auto numMethods = m_methods.size();
+    auto fail = [&](const juce::String& message)
+    {
+        m_classes.resize(numClasses);
+        m_properties.resize(numProperties);
+        m_methods.resize(numMethods);
+        BuildLookupTables();
+        errorMessage = message;
+        return false;
+    };
+
+    for (auto* classXml : schemaXml.getChildWithTagNameIterator("Class"))
+    {
+        auto name = classXml->getStringAttribute("name");
+        auto classId = classXml->getStringAttribute("id");
+        if (name.isEmpty() || !IsValidClassId(classId))
+            return fail("Class \"" + name + "\" has no valid name or id");
+
+        // The lookup tables are only rebuilt at the end, so check for duplicates among all classes directly.
+        if (std::any_of(m_classes.begin(), m_classes.end(), 
+                        [&](const ClassDefinition& c) { return c.m_name == name || c.m_classId == classId; }))
+            return fail("Class \"" + name + "\" or its id is already defined");
+
+        if (GetNumClasses() >= MaxClassIdx)
+            return fail("Too many classes");
+
+        auto parentId = classXml->getStringAttribute("parent", classId.upToLastOccurrenceOf(".", false, false));
+        auto parentIter = std::find_if(m_classes.begin(), m_classes.end(), 
+                                       [&parentId](const ClassDefinition& c) { return c.m_classId == parentId; });
+        if (parentIter == m_classes.end())
+            return fail("Parent class " + parentId + " of class \"" + name + "\" is not defined");
+
+        AddClass(name, classId, static_cast<int>(std::distance(m_classes.begin(), parentIter)) + 1);
+
+        for (auto* propXml : classXml->getChildWithTagNameIterator("Property"))
+        {
+            PropertyDefinition definition;
+            definition.m_property.m_name = propXml->getStringAttribute("name");
+            definition.m_property.m_index = propXml->getIntAttribute("index");
+            definition.m_property.m_type = GetDataTypeFromName(propXml->getStringAttribute("type"));
+            definition.m_property.m_getMethodIdx = propXml->getIntAttribute("get");
+            definition.m_property.m_setMethodIdx = propXml->getIntAttribute("set");
+            if (definition.m_property.m_index <= 0 || definition.m_property.m_type == 0)
+                return fail("Property \"" + definition.m_property.m_name + "\" of class \"" + name + "\" has no valid index or type");
+
+            // Properties without explicit ranges get the ones of their data type.
+            auto typeDefinition = CreateDefinitionForType(definition.m_property);
+            definition.m_minValue = propXml->getDoubleAttribute("min", typeDefinition.m_minValue);
+            definition.m_maxValue = propXml->getDoubleAttribute("max", typeDefinition.m_maxValue);
+            definition.m_interval = propXml->getDoubleAttribute("interval", typeDefinition.m_interval);
+            definition.m_items = propXml->hasAttribute("items") ? ParseItems(propXml->getStringAttribute("items")) 
+                                                                : typeDefinition.m_items;
+            definition.m_defaultValue = propXml->getStringAttribute("default", 
+                definition.m_items.isEmpty() ? typeDefinition.m_defaultValue : definition.m_items[0]);
+            AddProperty(std::move(definition));
+        }
+
+        for (auto* methodXml : classXml->getChildWithTagNameIterator("Method"))
+        {
+            MethodDefinition definition;
+            definition.m_name = methodXml->getStringAttribute("name");
+            definition.m_index = methodXml->getIntAttribute("index");
+            if (definition.m_index <= 0 
+                || !ParseSignature(methodXml->getStringAttribute("params"), definition.m_params)
+                || !ParseSignature(methodXml->getStringAttribute("returns"), definition.m_returns))
+                return fail("Method \"" + definition.m_name + "\" of class \"" + name + "\" has no valid index or signature");
+
+            AddMethod(std::move(definition));
+        }
+
+        AddMissingPropertyMethods();
+    }
+
+    if (!BuildLookupTables())
+        return fail("Could not build lookup tables");
+
+    return true;
+}
+
+int Schema::GetNumClasses() const
+{
+    return static_cast<int>(m_classes.size());
+}
+
+int Schema::GetNumStandardClasses() const
+{
+    return m_numStandardClasses;
+}
+
+const ClassDefinition* Schema::GetClass(int classIdx) const
+{
+    if (classIdx < 1 || classIdx > GetNumClasses())
+        return nullptr;
+
+    return &m_classes[static_cast<size_t>(classIdx - 1)];
+}
+
+juce::String Schema::GetClassText(int classIdx) const
+{
+    auto classDefinition = GetClass(classIdx);
+    if (classDefinition == nullptr)
+        return {};
+
+    return classDefinition->m_classId + ": " + classDefinition->m_name;
+}
+
+int Schema::GetClassIdxFromText(const juce::String& classText) const
+{
+    auto classIdx = GetClassIdxFromClassId(classText.upToFirstOccurrenceOf(": ", false, false));
+    if (classIdx == 0 || m_classes[static_cast<size_t>(classIdx - 1)].m_name != classText.fromFirstOccurrenceOf(": ", false, false))
+        return 0;
+
+    return classIdx;
+}
+
+int Schema::GetClassIdxFromName(const juce::String& name) const
+{
+    std::string_view key(name.toRawUTF8(), name.getNumBytesAsUTF8());
+    auto classIdx = LookUp(m_classesByName, [key](std::uint32_t seed) { return HashString(key, seed); });
+    if (classIdx == 0 || m_classes[static_cast<size_t>(classIdx - 1)].m_name != name)
+        return 0;
+
+    return classIdx;
+}
+
+int Schema::GetClassIdxFromClassId(const juce::String& classId) const
+{
+    std::string_view key(classId.toRawUTF8(), classId.getNumBytesAsUTF8());
+    auto classIdx = LookUp(m_classesByClassId, [key](std::uint32_t seed) { return HashClassId(key, seed); });
+    if (classIdx == 0 || m_classes[static_cast<size_t>(classIdx - 1)].m_classId != classId)
+        return 0;
+
+    return classIdx;
+}
+
+int Schema::GetClassIdxFromBinaryClassId(const std::uint8_t* data, std::size_t size) const
+{
+    auto classIdx = LookUp(m_classesByClassId, [data, size](std::uint32_t seed) { return HashBytes(data, size, seed); });
+    if (classIdx == 0)
+        return 0;
+
+    const auto& binaryClassId = m_classes[static_cast<size_t>(classIdx - 1)].m_binaryClassId;
+    if (binaryClassId.size() != size || !std::equal(binaryClassId.begin(), binaryClassId.end(), data))
+        return 0;
+
+    return classIdx;
+}
+
+std::vector<Property> Schema::GetProperties(int classIdx) const
+{
+    std::vector<Property> ret;
+    auto classDefinition = GetClass(classIdx);
+    if (classDefinition == nullptr)
+        return ret;
+
+    // Parent properties come first, so collect them before those of the class itself.
+    if (classDefinition->m_parentIdx != 0)
+        ret = GetProperties(classDefinition->m_parentIdx);
+
+    for (int i = 0; i < classDefinition->m_numProperties; i++)
+        ret.push_back(m_properties[static_cast<size_t>(classDefinition->m_firstPropertyIdx + i)].m_property);
+
+    return ret;
+}
+
+const PropertyDefinition* Schema::GetPropertyDefinition(int classIdx, int defLevel, int propIdx) const
+{
+    // Walk up the inheritance tree until reaching the class at the property's definition level.
+    auto classDefinition = GetClass(classIdx);
+    while (classDefinition != nullptr && classDefinition->m_defLevel > defLevel)
+        classDefinition = GetClass(classDefinition->m_parentIdx);
+
+    if (classDefinition == nullptr || classDefinition->m_defLevel != defLevel)
+        return nullptr;
+
+    for (int i = 0; i < classDefinition->m_numProperties; i++)
+    {
+        const auto& definition = m_properties[static_cast<size_t>(classDefinition->m_firstPropertyIdx + i)];
+        if (definition.m_property.m_index == propIdx)
+            return &definition;
+    }
+
+    return nullptr;
+}
+
+const MethodDefinition* Schema::GetMethodDefinition(int classIdx, int defLevel, int methodIdx) const
+{
+    // Walk up the inheritance tree until reaching the class at the method's definition level.
+    auto classDefinition = GetClass(classIdx);
+    while (classDefinition != nullptr && classDefinition->m_defLevel > defLevel)
+        classDefinition = GetClass(classDefinition->m_parentIdx);
+
+    if (classDefinition == nullptr || classDefinition->m_defLevel != defLevel)
+        return nullptr;
+
+    for (int i = 0; i < classDefinition->m_numMethods; i++)
+    {
+        const auto& definition = m_methods[static_cast<size_t>(classDefinition->m_firstMethodIdx + i)];
+        if (definition.m_index == methodIdx)
+            return &definition;
+    }
+
+    return nullptr;
+}
+
+PropertyDefinition Schema::CreateDefinitionForType(const Property& prop)
+{
+    PropertyDefinition definition;
+    definition.m_property = prop;
+    definition.m_defaultValue = "0";
+
+    // Lists and maps are entered as text, with items separated by '|' (See ValueCodec).
+    if (IsListDataType(prop.m_type) || IsMapDataType(prop.m_type))
+    {
+        definition.m_defaultValue = juce::String();
+        return definition;
+    }
+
+    switch (prop.m_type)
+    {
+        case NanoOcp1::OCP1DATATYPE_BOOLEAN:
+            definition.m_items = BooleanItems;
+            definition.m_defaultValue = BooleanItems[0];
+            break;
+        case NanoOcp1::OCP1DATATYPE_INT8:
+            definition.m_minValue = std::numeric_limits<std::int8_t>::min();
+            definition.m_maxValue = std::numeric_limits<std::int8_t>::max();
+            break;
+        case NanoOcp1::OCP1DATATYPE_INT16:
+            definition.m_minValue = std::numeric_limits<std::int16_t>::min();
+            definition.m_maxValue = std::numeric_limits<std::int16_t>::max();
+            break;
+        case NanoOcp1::OCP1DATATYPE_INT32:
+        case NanoOcp1::OCP1DATATYPE_INT64:
+            definition.m_minValue = -65535.0;
+            definition.m_maxValue = 65535.0;
+            break;
+        case NanoOcp1::OCP1DATATYPE_UINT8:
+            definition.m_maxValue = std::numeric_limits<std::uint8_t>::max();
+            break;
+        case NanoOcp1::OCP1DATATYPE_UINT16:
+            definition.m_maxValue = std::numeric_limits<std::uint16_t>::max();
+            break;
+        case NanoOcp1::OCP1DATATYPE_UINT32:
+        case NanoOcp1::OCP1DATATYPE_UINT64:
+            definition.m_maxValue = 0x7fffffff; // TODO: offer full range once sliders display it properly.
+            break;
+        case NanoOcp1::OCP1DATATYPE_FLOAT32:
+        case NanoOcp1::OCP1DATATYPE_FLOAT64:
+            definition.m_minValue = -65535.0;
+            definition.m_maxValue = 65535.0;
+            definition.m_interval = 0.01;
+            break;
+        case NanoOcp1::OCP1DATATYPE_STRING:
+            definition.m_defaultValue = "Some text";
+            break;
+        case NanoOcp1::OCP1DATATYPE_BLOB:
+            definition.m_defaultValue = "00"; // Bytes as hex text.
+            break;
+        default:
+            jassertfalse; // Missing implementation for data type!
+            break;
+    }
+
+    return definition;
+}
+
+std::vector<std::uint8_t> Schema::EncodeClassId(const juce::String& classId)
+{
+    auto fields = juce::StringArray::fromTokens(classId, ".", {});
+
+    std::vector<std::uint8_t> ret;
+    ret.reserve(static_cast<size_t>(2 + 2 * fields.size()));
+    auto appendUint16 = [&ret](int value)
+    {
+        ret.push_back(static_cast<std::uint8_t>((value >> 8) & 0xff));
+        ret.push_back(static_cast<std::uint8_t>(value & 0xff));
+    };
+
+    appendUint16(fields.size());
+    for (const auto& field : fields)
+        appendUint16(field.getIntValue());
+
+    return ret;
+}
+
+int Schema::GetDataTypeFromName(const juce::String& typeName)
+{
+    auto name = typeName.trim();
+    if (name.endsWithChar('>'))
+    {
+        auto itemTypeNames = juce::StringArray::fromTokens(name.fromFirstOccurrenceOf("<", false, false).dropLastCharacters(1), ",", {});
+        auto templateName = name.upToFirstOccurrenceOf("<", false, false);
+        if (templateName == ListTypeName && itemTypeNames.size() == 1)
+        {
+            auto itemType = GetDataTypeFromName(itemTypeNames[0]);
+            if (itemType != 0 && !IsListDataType(itemType) && !IsMapDataType(itemType))
+                return MakeListDataType(itemType);
+        }
+        else if (templateName == MapTypeName && itemTypeNames.size() == 2)
+        {
+            auto keyType = GetDataTypeFromName(itemTypeNames[0]);
+            auto valueType = GetDataTypeFromName(itemTypeNames[1]);
+            if (keyType != 0 && valueType != 0 && GetValueCodec(MakeMapDataType(keyType, valueType)) != nullptr)
+                return MakeMapDataType(keyType, valueType);
+        }
+
+        return 0;
+    }
+
+    for (auto dataType : SupportedDataTypes)
+    {
+        if (NanoOcp1::DataTypeToString(dataType) == name)
+            return dataType;
+    }
+
+    return 0;
+}
+
+juce::String Schema::GetDataTypeName(int dataType)
+{
+    if (IsMapDataType(dataType))
+        return MapTypeName + "<" + NanoOcp1::DataTypeToString(GetKeyDataType(dataType)) + ", " 
+                                 + NanoOcp1::DataTypeToString(GetItemDataType(dataType)) + ">";
+
+    if (IsListDataType(dataType))
+        return ListTypeName + "<" + NanoOcp1::DataTypeToString(GetItemDataType(dataType)) + ">";
+
+    return NanoOcp1::DataTypeToString(dataType);
+}
+
+int Schema::AddClass(const juce::String& name, const juce::String& classId, int parentIdx)
+{
+    ClassDefinition classDefinition;
+    classDefinition.m_name = name;
+    classDefinition.m_classId = classId;
+    classDefinition.m_binaryClassId = EncodeClassId(classId);
+    classDefinition.m_defLevel = juce::StringArray::fromTokens(classId, ".", {}).size();
+    classDefinition.m_parentIdx = parentIdx;
+    classDefinition.m_firstPropertyIdx = static_cast<int>(m_properties.size());
+    classDefinition.m_firstMethodIdx = static_cast<int>(m_methods.size());
+    m_classes.push_back(std::move(classDefinition));
+
+    return GetNumClasses();
+}
+
+void Schema::AddProperty(PropertyDefinition definition)
+{
+    jassert(!m_classes.empty());
+    auto& classDefinition = m_classes.back();
+    definition.m_property.m_defLevel = classDefinition.m_defLevel;
+    m_properties.push_back(std::move(definition));
+    classDefinition.m_numProperties++;
+}
+
+void Schema::AddMethod(MethodDefinition definition)
+{
+    jassert(!m_classes.empty());
+    auto& classDefinition = m_classes.back();
+    definition.m_defLevel = classDefinition.m_defLevel;
+    m_methods.push_back(std::move(definition));
+    classDefinition.m_numMethods++;
+}
+
+void Schema::AddMissingPropertyMethods()
+{
+    jassert(!m_classes.empty());
+    const auto classDefinition = m_classes.back();
+    auto hasMethod = [this, &classDefinition](int methodIdx)
+    {
+        auto first = m_methods.begin() + classDefinition.m_firstMethodIdx;
+        return std::any_of(first, first + classDefinition.m_numMethods, 
+                           [methodIdx](const MethodDefinition& m) { return m.m_index == methodIdx; });
+    };
+
+    for (int i = 0; i < classDefinition.m_numProperties; i++)
+    {
+        const auto prop = m_properties[static_cast<size_t>(classDefinition.m_firstPropertyIdx + i)].m_property;
+        if (prop.m_getMethodIdx != 0 && !hasMethod(prop.m_getMethodIdx))
+            AddMethod({ 0, prop.m_getMethodIdx, "Get" + prop.m_name, {}, { { prop.m_type, PARAM_ROLE_VALUE } } });
+        if (prop.m_setMethodIdx != 0 && !hasMethod(prop.m_setMethodIdx))
+            AddMethod({ 0, prop.m_setMethodIdx, "Set" + prop.m_name, { { prop.m_type, PARAM_ROLE_VALUE } }, {} });
+    }
+}
+
+bool Schema::ParseSignature(const juce::String& signature, std::vector<MethodParam>& params)
+{
+    params.clear();
+
+    // Parameters are separated by commas, except for those within the item types of maps.
+    juce::StringArray tokens;
+    int depth(0), tokenStart(0);
+    for (int i = 0; i <= signature.length(); i++)
+    {
+        auto c = signature[i];
+        if (c == '<')
+            depth++;
+        else if (c == '>')
+            depth--;
+        else if ((c == ',' && depth == 0) || c == 0)
+        {
+            tokens.add(signature.substring(tokenStart, i));
+            tokenStart = i + 1;
+        }
+    }
+
+    for (const auto& token : tokens)
+    {
+        auto param = token.trim();
+        if (param.isEmpty())
+            continue;
+
+        auto dataType = GetDataTypeFromName(param.upToLastOccurrenceOf(" ", false, false));
+        auto role = ParamRoleNames.indexOf(param.fromLastOccurrenceOf(" ", false, false).trim());
+        if (dataType == 0 || role < 0)
+            return false;
+
+        params.push_back({ dataType, role });
+    }
+
+    return true;
+}
+
+bool Schema::BuildLookupTables()
+{
+    auto numKeys = m_classes.size();
+    auto build = [this, numKeys](ClassLookupTable& table, auto hashOf)
+    {
+        table.m_bucketSeeds.assign(GetNumBuckets(numKeys), 0);
+        table.m_slots.assign(GetTableSize(numKeys), 0);
+        return BuildPerfectHash(hashOf, numKeys, table.m_bucketSeeds.data(), table.m_bucketSeeds.size(), 
+                                table.m_slots.data(), table.m_slots.size());
+    };
+
+    bool success = build(m_classesByName, [this](std::size_t key, std::uint32_t seed)
+    {
+        const auto& name = m_classes[key].m_name;
+        return HashString(std::string_view(name.toRawUTF8(), name.getNumBytesAsUTF8()), seed);
+    });
+    success = success && build(m_classesByClassId, [this](std::size_t key, std::uint32_t seed)
+    {
+        const auto& binaryClassId = m_classes[key].m_binaryClassId;
+        return HashBytes(binaryClassId.data(), binaryClassId.size(), seed);
+    });
+
+    jassert(success); // Should practically never happen with half of the slots unused.
+    return success;
+}
+
+juce::StringArray Schema::ParseItems(const juce::String& itemsString)
+{
+    juce::StringArray items;
+    for (const auto& token : juce::StringArray::fromTokens(itemsString, "|", {}))
+    {
+        if (token.isEmpty())
+            continue;
+
+        // Ranges such as "0..126" stand for each integer within them.
+        if (token.containsOnly("-0123456789.") && token.contains(".."))
+        {
+            auto first = token.upToFirstOccurrenceOf("..", false, false).getIntValue();
+            auto last = token.fromFirstOccurrenceOf("..", false, false).getIntValue();
+            for (int value = first; value <= last; value++)
+                items.add(juce::String(value));
+        }
+        else
+        {
+            items.add(token.trim());
+        }
+    }
+
+    return items;
+}
+
+} // namespace AES70
@@ -0,0 +1,364 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AES70.h"
+
+
+namespace AES70
+{
+
+/**
+ * Schema entry of an AES70 class property. Besides the Property itself, this holds the value range
+ * and the enumerators which a GUI can use to offer only sensible values for the property.
+ */
+struct PropertyDefinition
+{
+    Property m_property = {};       // Definition level, index, data type, name and Get/Set method indexes.
+    double m_minValue = 0.0;        // Smallest value offered for numeric properties.
+    double m_maxValue = 0.0;        // Largest value offered for numeric properties.
+    double m_interval = 1.0;        // Step size between offered values of numeric properties.
+    juce::String m_defaultValue;    // Value string initially offered, i.e. "0", "1: Valid" or "Some text".
+    juce::StringArray m_items;      // Enumerator texts such as "1: Mute". Empty if the property is not enumerated.
+};
+
+/**
+ * What the value of a method parameter is taken from, when generating binary strings.
+ */
+enum ParamRole
+{
+    PARAM_ROLE_VALUE = 0,   // The property value entered by the user.
+    PARAM_ROLE_MIN,         // The smallest value of the property's range (See PropertyDefinition::m_minValue).
+    PARAM_ROLE_MAX,         // The largest value of the property's range (See PropertyDefinition::m_maxValue).
+};
+
+/**
+ * Typed parameter of an AES70 method.
+ */
+struct MethodParam
+{
+    int m_type;     // NanoOcp1 data type, i.e. NanoOcp1::OCP1DATATYPE_FLOAT32.
+    int m_role;     // See ParamRole.
+};
+
+/**
+ * Schema entry of an AES70 method, with the signature of its Command and of its Response.
+ * For instance OcaGain's GetGain takes no parameters, and returns the gain together with its minimum and maximum.
+ */
+struct MethodDefinition
+{
+    int m_defLevel = 0;                 // Definition level of the class defining the method.
+    int m_index = 0;                    // Method index within its definition level.
+    juce::String m_name;                // Method name, i.e. "GetGain".
+    std::vector<MethodParam> m_params;  // Parameters of the Command.
+    std::vector<MethodParam> m_returns; // Parameters of the Response, if its status is OK.
+};
+
+/**
+ * Schema entry of an AES70 class. The properties and methods which the class itself defines (as opposed 
+ * to inheriting them) are stored contiguously in the Schema's flat property and method tables.
+ */
+struct ClassDefinition
+{
+    juce::String m_name;            // Class name, i.e. "OcaGain".
+    juce::String m_classId;         // Dotted ClassID, i.e. "1.1.1.5".
+    std::vector<std::uint8_t> m_binaryClassId; // ClassID as transmitted in OCP.1, see Schema::EncodeClassId.
+    int m_defLevel = 0;             // Definition level, given by the number of fields in the ClassID.
+    int m_parentIdx = 0;            // Class index of the parent class, zero for OcaRoot.
+    int m_firstPropertyIdx = 0;     // Position of the first own property within the flat property table.
+    int m_numProperties = 0;        // Number of own properties.
+    int m_firstMethodIdx = 0;       // Position of the first own method within the flat method table.
+    int m_numMethods = 0;           // Number of own methods.
+};
+
+/**
+ * Perfect hash table mapping a key (class name or ClassID) to a class index, see Schema::GetClassIdxFromName.
+ * A key is first hashed into a bucket, and then hashed again with that bucket's seed into a slot. The seeds 
+ * are chosen such that no two keys share a slot. Slots hold class indexes, or zero if unused. Since 
+ * unknown keys also land in some slot, the class found must always be compared with the key.
+ */
+struct ClassLookupTable
+{
+    std::vector<std::uint16_t> m_bucketSeeds;   // Hash seed per bucket.
+    std::vector<std::uint8_t> m_slots;          // Class index per slot. Size is a power of two.
+};
+
+/**
+ * Flat tables of all AES70 classes and properties known to the app. The standard classes of the ClassIdx 
+ * enum are compiled in, and proprietary (vendor) classes can be appended at startup from a schema file.
+ * Classes are addressed by their class index, which starts at 1 (OcaRoot) like the ClassIdx enum.
+ * Lookups by class name and by ClassID take constant time, using perfect hash tables which for the 
+ * standard classes are computed at compile time, and recomputed whenever classes are appended.
+ *
+ * Schema files are XML files of the following form, where "parent" is the ClassID of an already known class.
+ * Methods list their parameters as data type and role (value, min or max, see ParamRole). Properties whose 
+ * Get or Set methods are not described get methods with the property value as single parameter.
+ *
+ *  <AES70Schema>
+ *    <Class name="AcmeLimiter" id="1.1.1.5.128" parent="1.1.1.5">
+ *      <Property name="Threshold" index="1" type="OcaFloat32" get="1" set="2" min="-60" max="0" interval="0.1" default="0"/>
+ *      <Property name="Mode" index="2" type="OcaUint8" get="3" set="4" items="1: Soft|2: Hard"/>
+ *      <Method name="GetThreshold" index="1" returns="OcaFloat32 value, OcaFloat32 min, OcaFloat32 max"/>
+ *      <Method name="SetThreshold" index="2" params="OcaFloat32 value"/>
+ *    </Class>
+ *  </AES70Schema>
+ *
+ * NOTE: The tables are not guarded against concurrent access. Schema files must be loaded on startup,
+ *       before any AES70 objects are created.
+ */
+class Schema
+{
+public:
+    /**
+     * Highest class index the tables can hold. Higher indexes are left for the app, see ClassIndexForCustomClass.
+     */
+    static constexpr int MaxClassIdx = 255;
+
+    /**
+     * Get the app-wide Schema, which on first use is filled with the standard classes.
+     *
+     * @return  The Schema instance.
+     */
+    static Schema& GetInstance();
+
+    /**
+     * Append the classes described in a schema file to the tables. 
+     * Either all classes of the file are appended, or none.
+     *
+     * @param[in] schemaFile    XML file in the format described above.
+     * @param[out] errorMessage Description of the first problem found, if any.
+     * @return  True if the file was parsed and its classes appended successfully.
+     */
+    bool LoadFromFile(const juce::File& schemaFile, juce::String& errorMessage);
+
+    /**
+     * Append the classes described by a schema XML element to the tables.
+     * Either all classes of the element are appended, or none.
+     *
+     * @param[in] schemaXml     Root element of a schema file.
+     * @param[out] errorMessage Description of the first problem found, if any.
+     * @return  True if the classes were appended successfully.
+     */
+    bool LoadFromXml(const juce::XmlElement& schemaXml, juce::String& errorMessage);
+
+    /**
+     * Get the number of classes in the tables. Valid class indexes are 1 to GetNumClasses().
+     *
+     * @return  Number of classes, including proprietary ones.
+     */
+    int GetNumClasses() const;
+
+    /**
+     * Get the number of compiled-in standard classes, which always come first.
+     *
+     * @return  Number of standard classes.
+     */
+    int GetNumStandardClasses() const;
+
+    /**
+     * Get the definition of a class.
+     *
+     * @param[in] classIdx  Class index, starting at 1.
+     * @return  Pointer to the class definition, or nullptr if there is no class with that index.
+     */
+    const ClassDefinition* GetClass(int classIdx) const;
+
+    /**
+     * Get the text used to present a class on the GUI and in config files, i.e. "1.1.1.5: OcaGain".
+     *
+     * @param[in] classIdx  Class index, starting at 1.
+     * @return  The class text, or an empty string if there is no class with that index.
+     */
+    juce::String GetClassText(int classIdx) const;
+
+    /**
+     * Find the class whose text (See GetClassText) matches the given one.
+     *
+     * @param[in] classText Class text, i.e. "1.1.1.5: OcaGain".
+     * @return  The class index, or zero if no such class exists.
+     */
+    int GetClassIdxFromText(const juce::String& classText) const;
+
+    /**
+     * Find the class with the given name.
+     *
+     * @param[in] name  Class name, i.e. "OcaGain".
+     * @return  The class index, or zero if no such class exists.
+     */
+    int GetClassIdxFromName(const juce::String& name) const;
+
+    /**
+     * Find the class with the given dotted ClassID.
+     *
+     * @param[in] classId   Dotted ClassID, i.e. "1.1.1.5".
+     * @return  The class index, or zero if no such class exists.
+     */
+    int GetClassIdxFromClassId(const juce::String& classId) const;
+
+    /**
+     * Find the class with the given ClassID, as transmitted in OCP.1 (See EncodeClassId).
+     *
+     * @param[in] data  Pointer to the first byte of the binary ClassID.
+     * @param[in] size  Number of bytes of the binary ClassID.
+     * @return  The class index, or zero if no such class exists.
+     */
+    int GetClassIdxFromBinaryClassId(const std::uint8_t* data, std::size_t size) const;
+
+    /**
+     * Get the properties of a class, including those inherited from all its parent classes,
+     * ordered from OcaRoot downwards.
+     *
+     * @param[in] classIdx  Class index, starting at 1.
+     * @return  All properties of the class. Empty if there is no class with that index.
+     */
+    std::vector<Property> GetProperties(int classIdx) const;
+
+    /**
+     * Find the definition of a property of a class or of one of its parent classes.
+     *
+     * @param[in] classIdx  Class index, starting at 1.
+     * @param[in] defLevel  Definition level of the property.
+     * @param[in] propIdx   Index of the property within its definition level.
+     * @return  Pointer to the property definition, or nullptr if the class has no such property.
+     */
+    const PropertyDefinition* GetPropertyDefinition(int classIdx, int defLevel, int propIdx) const;
+
+    /**
+     * Find the definition of a method of a class or of one of its parent classes.
+     *
+     * @param[in] classIdx  Class index, starting at 1.
+     * @param[in] defLevel  Definition level of the method.
+     * @param[in] methodIdx Index of the method within its definition level.
+     * @return  Pointer to the method definition, or nullptr if the class has no such method.
+     */
+    const MethodDefinition* GetMethodDefinition(int classIdx, int defLevel, int methodIdx) const;
+
+    /**
+     * Create a property definition for a property which is not described by the schema, 
+     * such as the user-defined property of an OcaCustomClass. Range and default value 
+     * are derived from the property's data type alone.
+     *
+     * @param[in] prop  The property.
+     * @return  A property definition suitable for the property's data type.
+     */
+    static PropertyDefinition CreateDefinitionForType(const Property& prop);
+
+    /**
+     * Encode a dotted ClassID the way OCP.1 transmits an OcaClassID: the number of fields, 
+     * followed by each field, all as big-endian Uint16.
+     *
+     * @param[in] classId   Dotted ClassID, i.e. "1.1.1.5".
+     * @return  The binary ClassID, i.e. 00 04 00 01 00 01 00 01 00 05.
+     */
+    static std::vector<std::uint8_t> EncodeClassId(const juce::String& classId);
+
+    /**
+     * Get the NanoOcp1 data type matching the name given by GetDataTypeName.
+     *
+     * @param[in] typeName  Name of the data type, i.e. "OcaFloat32" or "OcaList<OcaString>".
+     * @return  The data type, or zero if the type is not supported.
+     */
+    static int GetDataTypeFromName(const juce::String& typeName);
+
+    /**
+     * Get the name of a data type. For NanoOcp1 data types this is the name given by NanoOcp1::DataTypeToString, 
+     * lists and maps are named after their item types, i.e. "OcaList<OcaString>" or "OcaMap<OcaUint16, OcaString>".
+     *
+     * @param[in] dataType  NanoOcp1 data type, or a list or map data type (See MakeListDataType).
+     * @return  Name of the data type.
+     */
+    static juce::String GetDataTypeName(int dataType);
+
+private:
+    Schema();
+
+    /**
+     * Append a class to the tables. Its own properties must be appended right afterwards.
+     *
+     * @param[in] name      Class name.
+     * @param[in] classId   Dotted ClassID.
+     * @param[in] parentIdx Class index of the parent class, zero for OcaRoot.
+     * @return  The class index of the new class.
+     */
+    int AddClass(const juce::String& name, const juce::String& classId, int parentIdx);
+
+    /**
+     * Append a property to the most recently added class.
+     *
+     * @param[in] definition    The property definition. Its definition level is set to that of the class.
+     */
+    void AddProperty(PropertyDefinition definition);
+
+    /**
+     * Append a method to the most recently added class.
+     *
+     * @param[in] definition    The method definition. Its definition level is set to that of the class.
+     */
+    void AddMethod(MethodDefinition definition);
+
+    /**
+     * Append Get and Set methods for the properties of the most recently added class, unless the class 
+     * already has methods with those indexes. These methods transfer the property value only.
+     */
+    void AddMissingPropertyMethods();
+
+    /**
+     * Parse a method signature, where parameters are separated by "," and each consists of a data type
+     * name and a role, i.e. "OcaFloat32 value, OcaFloat32 min, OcaFloat32 max".
+     *
+     * @param[in] signature     The signature.
+     * @param[out] params       The parsed parameters.
+     * @return  True if all data types and roles are valid.
+     */
+    static bool ParseSignature(const juce::String& signature, std::vector<MethodParam>& params);
+
+    /**
+     * Recompute the perfect hash tables over all classes.
+     *
+     * @return  True if hash seeds were found for all tables.
+     */
+    bool BuildLookupTables();
+
+    /**
+     * Expand an items string, where items are separated by "|" and an item such as "0..126" 
+     * stands for all integers within that range.
+     *
+     * @param[in] itemsString   The items string, i.e. "1: Mute|2: Unmute".
+     * @return  The item texts.
+     */
+    static juce::StringArray ParseItems(const juce::String& itemsString);
+
+    std::vector<ClassDefinition> m_classes;         // Class definitions, at position classIdx - 1.
+    std::vector<PropertyDefinition> m_properties;   // Own properties of all classes, grouped per class.
+    std::vector<MethodDefinition> m_methods;        // Own methods of all classes, grouped per class.
+    int m_numStandardClasses;
+    ClassLookupTable m_classesByName;               // See GetClassIdxFromName.
+    ClassLookupTable m_classesByClassId;            // See GetClassIdxFromClassId and GetClassIdxFromBinaryClassId.
+
+    JUCE_DECLARE_NON_COPYABLE(Schema)
+};
+
+} // namespace AES70
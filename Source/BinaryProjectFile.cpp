@@ -0,0 +1,218 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#include "BinaryProjectFile.h"
+#include "CommandModel.h"
+
+
+static constexpr char BinaryProjectFileMagic[4] = { 'A', 'O', 'C', 'B' }; // Identifies a binary project file.
+static constexpr juce::uint16 BinaryProjectFileVersion = 1; // Current format version. Newer versions are rejected.
+static constexpr juce::uint16 BinaryProjectFileHeaderSize = 36; // Size of the header in bytes.
+
+
+//==============================================================================
+// Class BinaryProjectFile
+//==============================================================================
+
+const juce::String BinaryProjectFile::FileExtension(".aes70bin");
+
+bool BinaryProjectFile::IsBinaryProjectFile(const juce::File& file)
+{
+    return file.hasFileExtension(FileExtension);
+}
+
+bool BinaryProjectFile::Write(const juce::String& version,
+                              const juce::String& date,
+                              const CommandModel::CommandProperties& commands,
+                              juce::OutputStream& stream)
+{
+    // Intern all attribute names and values, assigning indices in order of first appearance.
+    std::vector<juce::String> strings;
+    std::unordered_map<juce::String, juce::uint32> stringIndices;
+    auto internString = [&](const juce::String& value)
+    {
+        auto result = stringIndices.emplace(value, static_cast<juce::uint32>(strings.size()));
+        if (result.second)
+            strings.push_back(value);
+
+        return result.first->second;
+    };
+
+    auto versionIdx = internString(version);
+    auto dateIdx = internString(date);
+
+    // All attributes of each command are stored, so that no attribute is lost compared to XML.
+    size_t numRecordEntries = 0;
+    for (const auto& command : commands)
+        numRecordEntries += 1 + 2 * static_cast<size_t>(command.size());
+
+    std::vector<juce::uint32> records;
+    records.reserve(numRecordEntries);
+    for (const auto& command : commands)
+    {
+        records.push_back(static_cast<juce::uint32>(command.size()));
+        for (const auto& attribute : command)
+        {
+            records.push_back(internString(attribute.name.toString()));
+            records.push_back(internString(attribute.value.toString()));
+        }
+    }
+    juce::uint32 numRecords = static_cast<juce::uint32>(commands.size());
+
+    juce::uint32 numStrings = static_cast<juce::uint32>(strings.size());
+    juce::uint32 recordsOffset = BinaryProjectFileHeaderSize;
+    juce::uint32 stringOffsetsOffset = recordsOffset + static_cast<juce::uint32>(records.size() * sizeof(juce::uint32));
+    juce::uint32 stringDataOffset = stringOffsetsOffset + (numStrings + 1) * static_cast<juce::uint32>(sizeof(juce::uint32));
+
+    auto startPosition = stream.getPosition();
+
+    // Header
+    stream.write(BinaryProjectFileMagic, sizeof(BinaryProjectFileMagic));
+    stream.writeShort(static_cast<short>(BinaryProjectFileVersion));
+    stream.writeShort(static_cast<short>(BinaryProjectFileHeaderSize));
+    stream.writeInt(static_cast<int>(numRecords));
+    stream.writeInt(static_cast<int>(numStrings));
+    stream.writeInt(static_cast<int>(versionIdx));
+    stream.writeInt(static_cast<int>(dateIdx));
+    stream.writeInt(static_cast<int>(recordsOffset));
+    stream.writeInt(static_cast<int>(stringOffsetsOffset));
+    stream.writeInt(static_cast<int>(stringDataOffset));
+    jassert(stream.getPosition() - startPosition == BinaryProjectFileHeaderSize);
+    ignoreUnused(startPosition);
+
+    // Records
+    for (auto stringIdx : records)
+        stream.writeInt(static_cast<int>(stringIdx));
+
+    // String offsets, including the end offset of the last string.
+    juce::uint32 stringOffset = 0;
+    stream.writeInt(0);
+    for (const auto& string : strings)
+    {
+        stringOffset += static_cast<juce::uint32>(string.getNumBytesAsUTF8());
+        stream.writeInt(static_cast<int>(stringOffset));
+    }
+
+    // String data
+    bool success = true;
+    for (const auto& string : strings)
+        success = stream.write(string.toRawUTF8(), string.getNumBytesAsUTF8()) && success;
+
+    stream.flush();
+
+    return success;
+}
+
+juce::ValueTree BinaryProjectFile::Read(const juce::File& file)
+{
+    juce::MemoryMappedFile mappedFile(file, juce::MemoryMappedFile::readOnly);
+    auto data = static_cast<const char*>(mappedFile.getData());
+    auto dataSize = mappedFile.getSize();
+    if ((data == nullptr) || (dataSize < BinaryProjectFileHeaderSize))
+        return {};
+
+    auto readUint16 = [data](size_t offset) { return juce::ByteOrder::littleEndianShort(data + offset); };
+    auto readUint32 = [data](size_t offset) { return juce::ByteOrder::littleEndianInt(data + offset); };
+
+    // Header
+    if ((std::memcmp(data, BinaryProjectFileMagic, sizeof(BinaryProjectFileMagic)) != 0) ||
+        (readUint16(4) > BinaryProjectFileVersion) ||
+        (readUint16(6) < BinaryProjectFileHeaderSize))
+        return {};
+
+    juce::uint32 numRecords = readUint32(8);
+    juce::uint32 numStrings = readUint32(12);
+    juce::uint32 versionIdx = readUint32(16);
+    juce::uint32 dateIdx = readUint32(20);
+    size_t recordsOffset = readUint32(24);
+    size_t stringOffsetsOffset = readUint32(28);
+    size_t stringDataOffset = readUint32(32);
+
+    // Each record holds at least its number of attributes.
+    if ((recordsOffset + numRecords * sizeof(juce::uint32) > stringOffsetsOffset) ||
+        (stringOffsetsOffset + (static_cast<size_t>(numStrings) + 1) * sizeof(juce::uint32) > dataSize))
+        return {};
+
+    auto stringDataSize = readUint32(stringOffsetsOffset + numStrings * sizeof(juce::uint32));
+    if (stringDataOffset + stringDataSize > dataSize)
+        return {};
+
+    // Strings are only decoded once, regardless of how many records refer to them.
+    std::vector<juce::String> strings;
+    strings.reserve(numStrings);
+    for (juce::uint32 stringIdx = 0; stringIdx < numStrings; stringIdx++)
+    {
+        auto startOffset = readUint32(stringOffsetsOffset + stringIdx * sizeof(juce::uint32));
+        auto endOffset = readUint32(stringOffsetsOffset + (stringIdx + 1) * sizeof(juce::uint32));
+        if ((endOffset < startOffset) || (endOffset > stringDataSize))
+            return {};
+
+        strings.push_back(juce::String::fromUTF8(data + stringDataOffset + startOffset, static_cast<int>(endOffset - startOffset)));
+    }
+
+    auto setProperty = [&strings](juce::ValueTree& node, const juce::Identifier& id, juce::uint32 stringIdx)
+    {
+        if (stringIdx < strings.size())
+            node.setProperty(id, strings[stringIdx], nullptr);
+    };
+
+    juce::ValueTree commandSet(CommandModel::CommandSetType);
+    setProperty(commandSet, "version", versionIdx);
+    setProperty(commandSet, "date", dateIdx);
+
+    // Identifiers of attribute names are only created once per string.
+    std::vector<juce::Identifier> identifiers(numStrings);
+    auto getIdentifier = [&](juce::uint32 stringIdx)
+    {
+        if ((stringIdx < numStrings) && identifiers[stringIdx].isNull() && strings[stringIdx].isNotEmpty())
+            identifiers[stringIdx] = strings[stringIdx];
+
+        return (stringIdx < numStrings) ? identifiers[stringIdx] : juce::Identifier();
+    };
+
+    size_t recordOffset = recordsOffset;
+    for (juce::uint32 recordIdx = 0; recordIdx < numRecords; recordIdx++)
+    {
+        juce::ValueTree command(CommandModel::CommandType);
+
+        // Attribute count, followed by pairs of name and value string indices.
+        size_t numRecordAttributes = readUint32(recordOffset);
+        recordOffset += sizeof(juce::uint32);
+        if (recordOffset + numRecordAttributes * 2 * sizeof(juce::uint32) > stringOffsetsOffset)
+            return {};
+
+        for (size_t attributeIdx = 0; attributeIdx < numRecordAttributes; attributeIdx++)
+        {
+            auto attributeId = getIdentifier(readUint32(recordOffset));
+            if (attributeId.isValid())
+                setProperty(command, attributeId, readUint32(recordOffset + sizeof(juce::uint32)));
+
+            recordOffset += 2 * sizeof(juce::uint32);
+        }
+
+        commandSet.appendChild(command, nullptr);
+    }
+
+    return commandSet;
+}
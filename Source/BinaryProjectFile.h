@@ -0,0 +1,94 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "CommandModel.h"
+
+
+/**
+ * Compact, versioned binary alternative to the "AES70CommandSet" XML config file format.
+ * 
+ * The file consists of a fixed-size header, followed by one record per "AES70Command" element,
+ * followed by a table of interned UTF-8 strings. Each record holds a pair of string table indices per attribute,
+ * for the attribute's name and value, so that repeated names and values (e.g. "1.1.1.5: OcaGain") are only 
+ * stored once. All values are little-endian.
+ * 
+ *  Header:         magic "AOCB" (4), format version (2), header size (2), number of records (4),
+ *                  number of strings (4), root "version" and "date" attribute string indices (4 + 4),
+ *                  records offset (4), string offsets offset (4), string data offset (4).
+ *  Records:        number of attributes (4), followed by one uint32 name and one uint32 value string index 
+ *                  per attribute.
+ *  String offsets: numStrings + 1 uint32 offsets into the string data, so that the length of
+ *                  string i is offset[i + 1] - offset[i].
+ *  String data:    concatenated UTF-8 strings, without terminators.
+ * 
+ * Since all offsets are known from the header, the file is read directly from a juce::MemoryMappedFile
+ * without any parsing. Records map one-to-one to the nodes of the CommandModel including all of their 
+ * attributes, and thereby convert losslessly to and from the XML representation.
+ */
+class BinaryProjectFile
+{
+public:
+    /**
+     * File extension used for binary project files.
+     */
+    static const juce::String FileExtension;
+
+    /**
+     * Check whether the given file should be treated as a binary project file, based on its extension.
+     *
+     * @param[in] file  File to check.
+     * @return  True if the file has the binary project file extension.
+     */
+    static bool IsBinaryProjectFile(const juce::File& file);
+
+    /**
+     * Write a binary project file containing the given commands.
+     *
+     * @param[in] version       Value of the root "version" attribute.
+     * @param[in] date          Value of the root "date" attribute.
+     * @param[in] commands      Properties of each command node, as taken by CommandModel::GetCommandProperties.
+     * @param[in] stream        Stream to write the file content to.
+     * @return  True if the content could be written to the stream.
+     */
+    static bool Write(const juce::String& version, 
+                      const juce::String& date,
+                      const CommandModel::CommandProperties& commands,
+                      juce::OutputStream& stream);
+
+    /**
+     * Read a binary project file, and convert it back into a CommandModel root node with one 
+     * CommandModel::CommandType child per record.
+     *
+     * @param[in] file  Binary project file to read.
+     * @return  The root node, or an invalid ValueTree if the file does not exist or is not a valid binary project file.
+     */
+    static juce::ValueTree Read(const juce::File& file);
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BinaryProjectFile)
+};
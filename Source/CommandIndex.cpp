@@ -0,0 +1,365 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#include "CommandIndex.h"
+#include "CommandModel.h"
+
+
+/**
+ * Fields which a query term can refer to.
+ */
+enum class QueryField
+{
+    Any = 0,
+    Class,
+    Property,
+    Command,
+    Name,
+    Ono
+};
+
+/**
+ * One parsed term of a query.
+ */
+struct QueryTerm
+{
+    QueryField m_field = QueryField::Any;
+    juce::String m_text;                    // Lower-case text to search for.
+    bool m_hasOnoFilter = false;            // True if the term matches against the ONo.
+    juce::uint32 m_onoMin = 0;              // Lowest matching ONo.
+    juce::uint32 m_onoMax = 0xFFFFFFFF;     // Highest matching ONo.
+    juce::uint32 m_onoValue = 0;            // Matching ONo bits, see m_onoMask.
+    juce::uint32 m_onoMask = 0;             // ONo bits which must equal the ones in m_onoValue.
+};
+
+/**
+ * Helper method to parse an ONo, given either in decimal or in hex with a "0x" prefix.
+ *
+ * @param[in] text      Text to parse.
+ * @param[out] number   The parsed number.
+ * @return  True if the text is a valid 32 bit number.
+ */
+static bool ParseOnoNumber(const juce::String& text, juce::uint32& number)
+{
+    auto trimmedText = text.trim();
+    if (trimmedText.startsWithIgnoreCase("0x"))
+    {
+        auto hexText = trimmedText.substring(2);
+        if (hexText.isEmpty() || (hexText.length() > 8) || !hexText.containsOnly("0123456789abcdefABCDEF"))
+            return false;
+
+        number = static_cast<juce::uint32>(hexText.getHexValue64());
+        return true;
+    }
+
+    if (trimmedText.isEmpty() || (trimmedText.length() > 10) || !trimmedText.containsOnly("0123456789"))
+        return false;
+
+    auto value = trimmedText.getLargeIntValue();
+    if (value > 0xFFFFFFFF)
+        return false;
+
+    number = static_cast<juce::uint32>(value);
+    return true;
+}
+
+/**
+ * Helper method to parse the value of an "ono:" term, which is either a single ONo, a range, or a value and mask.
+ *
+ * @param[in] text      Text to parse.
+ * @param[out] term     Term to set the ONo filter of. If the text is invalid, the filter matches no ONo at all.
+ */
+static void ParseOnoFilter(const juce::String& text, QueryTerm& term)
+{
+    term.m_hasOnoFilter = true;
+
+    bool valid(false);
+    if (text.containsChar('/'))
+    {
+        valid = ParseOnoNumber(text.upToFirstOccurrenceOf("/", false, false), term.m_onoValue) &&
+                ParseOnoNumber(text.fromFirstOccurrenceOf("/", false, false), term.m_onoMask);
+    }
+    else if (text.containsChar('-'))
+    {
+        valid = ParseOnoNumber(text.upToFirstOccurrenceOf("-", false, false), term.m_onoMin) &&
+                ParseOnoNumber(text.fromFirstOccurrenceOf("-", false, false), term.m_onoMax);
+    }
+    else
+    {
+        valid = ParseOnoNumber(text, term.m_onoMin);
+        term.m_onoMax = term.m_onoMin;
+    }
+
+    if (!valid)
+    {
+        term.m_onoMin = 1;
+        term.m_onoMax = 0;
+    }
+}
+
+/**
+ * Helper method to split a query into its terms. See CommandIndex for the query syntax.
+ *
+ * @param[in] query     Query to parse.
+ * @return  The parsed terms.
+ */
+static std::vector<QueryTerm> ParseQuery(const juce::String& query)
+{
+    static const std::map<juce::String, QueryField> fieldPrefixes = {
+        { "class", QueryField::Class },
+        { "prop", QueryField::Property },
+        { "cmd", QueryField::Command },
+        { "name", QueryField::Name },
+        { "ono", QueryField::Ono },
+    };
+
+    juce::StringArray tokens;
+    tokens.addTokens(query, " \t", "\"");
+    tokens.removeEmptyStrings();
+
+    std::vector<QueryTerm> terms;
+    terms.reserve(static_cast<size_t>(tokens.size()));
+    for (const auto& token : tokens)
+    {
+        QueryTerm term;
+        juce::String value(token);
+
+        auto prefix = token.upToFirstOccurrenceOf(":", false, true).toLowerCase();
+        auto fieldIter = fieldPrefixes.find(prefix);
+        if (token.containsChar(':') && (fieldIter != fieldPrefixes.end()))
+        {
+            term.m_field = fieldIter->second;
+            value = token.fromFirstOccurrenceOf(":", false, false);
+        }
+
+        value = value.unquoted().toLowerCase();
+        if (value.isEmpty())
+            continue;
+
+        if (term.m_field == QueryField::Ono)
+        {
+            ParseOnoFilter(value, term);
+        }
+        else
+        {
+            term.m_text = value;
+
+            // A plain number also matches commands with that ONo.
+            juce::uint32 ono;
+            if ((term.m_field == QueryField::Any) && ParseOnoNumber(value, ono))
+            {
+                term.m_hasOnoFilter = true;
+                term.m_onoMin = ono;
+                term.m_onoMax = ono;
+            }
+        }
+
+        terms.push_back(term);
+    }
+
+    return terms;
+}
+
+
+//==============================================================================
+// Class CommandIndex
+//==============================================================================
+
+CommandIndex::CommandIndex(juce::ValueTree commandModel)
+    :   m_commandModel(commandModel)
+{
+    jassert(m_commandModel.hasType(CommandModel::CommandSetType));
+
+    // Index the commands which already exist.
+    for (auto command : m_commandModel)
+        valueTreeChildAdded(m_commandModel, command);
+
+    m_commandModel.addListener(this);
+}
+
+CommandIndex::~CommandIndex()
+{
+    m_commandModel.removeListener(this);
+}
+
+std::vector<juce::ValueTree> CommandIndex::Find(const juce::String& query) const
+{
+    auto terms = ParseQuery(query);
+
+    // Narrow down the candidates using the ONo index, if the query contains an "ono:" term.
+    std::vector<const Entry*> candidates;
+    auto onoTermIter = std::find_if(terms.begin(), terms.end(), [](const QueryTerm& term) 
+        {
+            return (term.m_field == QueryField::Ono);
+        });
+    if (onoTermIter != terms.end())
+    {
+        if (onoTermIter->m_onoMin <= onoTermIter->m_onoMax)
+        {
+            auto endIter = m_entriesByOno.upper_bound(onoTermIter->m_onoMax);
+            for (auto iter = m_entriesByOno.lower_bound(onoTermIter->m_onoMin); iter != endIter; ++iter)
+                candidates.push_back(iter->second);
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](const Entry* a, const Entry* b)
+            {
+                return (a->m_row < b->m_row);
+            });
+    }
+    else
+    {
+        candidates.reserve(m_entries.size());
+        for (const auto& entry : m_entries)
+            candidates.push_back(entry.get());
+    }
+
+    auto onoMatches = [](const Entry& entry, const QueryTerm& term)
+    {
+        return entry.m_hasOno &&
+               (entry.m_ono >= term.m_onoMin) && (entry.m_ono <= term.m_onoMax) &&
+               ((entry.m_ono & term.m_onoMask) == (term.m_onoValue & term.m_onoMask));
+    };
+
+    auto termMatches = [&onoMatches](const Entry& entry, const QueryTerm& term)
+    {
+        switch (term.m_field)
+        {
+            case QueryField::Class:
+                return entry.m_class.contains(term.m_text);
+            case QueryField::Property:
+                return entry.m_property.contains(term.m_text);
+            case QueryField::Command:
+                return entry.m_commandName.contains(term.m_text);
+            case QueryField::Name:
+                return entry.m_name.contains(term.m_text);
+            case QueryField::Ono:
+                return onoMatches(entry, term);
+            case QueryField::Any:
+            default:
+                return entry.m_class.contains(term.m_text) ||
+                       entry.m_property.contains(term.m_text) ||
+                       entry.m_commandName.contains(term.m_text) ||
+                       entry.m_name.contains(term.m_text) ||
+                       (term.m_hasOnoFilter && onoMatches(entry, term));
+        }
+    };
+
+    std::vector<juce::ValueTree> result;
+    for (auto entry : candidates)
+    {
+        if (std::all_of(terms.begin(), terms.end(), [&](const QueryTerm& term) { return termMatches(*entry, term); }))
+            result.push_back(entry->m_command);
+    }
+
+    return result;
+}
+
+int CommandIndex::GetNumCommands() const
+{
+    return static_cast<int>(m_entries.size());
+}
+
+void CommandIndex::UpdateEntry(Entry& entry, const juce::Identifier& property)
+{
+    const auto& command = entry.m_command;
+    if (property == CommandModel::Class)
+        entry.m_class = command.getProperty(CommandModel::Class).toString().toLowerCase();
+    else if (property == CommandModel::Property)
+        entry.m_property = command.getProperty(CommandModel::Property).toString().toLowerCase();
+    else if (property == CommandModel::Command)
+        entry.m_commandName = command.getProperty(CommandModel::Command).toString().toLowerCase();
+    else if (property == CommandModel::Name)
+        entry.m_name = command.getProperty(CommandModel::Name).toString().toLowerCase();
+    else if (property == CommandModel::Ono)
+    {
+        if (entry.m_hasOno)
+            m_entriesByOno.erase(entry.m_onoIter);
+
+        entry.m_hasOno = ParseOnoNumber(command.getProperty(CommandModel::Ono).toString(), entry.m_ono);
+        if (entry.m_hasOno)
+            entry.m_onoIter = m_entriesByOno.emplace(entry.m_ono, &entry);
+    }
+}
+
+void CommandIndex::UpdateRows(int firstRow)
+{
+    for (int row = juce::jmax(0, firstRow); row < static_cast<int>(m_entries.size()); row++)
+        m_entries[static_cast<size_t>(row)]->m_row = row;
+}
+
+void CommandIndex::valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property)
+{
+    if (tree.getParent() != m_commandModel)
+        return;
+
+    int row = m_commandModel.indexOf(tree);
+    if ((row >= 0) && (row < static_cast<int>(m_entries.size())))
+    {
+        jassert(m_entries[static_cast<size_t>(row)]->m_command == tree);
+        UpdateEntry(*m_entries[static_cast<size_t>(row)], property);
+    }
+}
+
+void CommandIndex::valueTreeChildAdded(juce::ValueTree& parentTree, juce::ValueTree& child)
+{
+    // NOTE: every child gets an entry, to keep m_entries in sync with the model's child indices.
+    if (parentTree != m_commandModel)
+        return;
+
+    int row = juce::jlimit(0, static_cast<int>(m_entries.size()), parentTree.indexOf(child));
+
+    auto entry = std::make_unique<Entry>();
+    entry->m_command = child;
+    for (const auto& property : { CommandModel::Class, CommandModel::Property, CommandModel::Command, 
+                                  CommandModel::Name, CommandModel::Ono })
+        UpdateEntry(*entry, property);
+
+    m_entries.insert(m_entries.begin() + row, std::move(entry));
+    UpdateRows(row);
+}
+
+void CommandIndex::valueTreeChildRemoved(juce::ValueTree& parentTree, juce::ValueTree& /*child*/, int index)
+{
+    if ((parentTree != m_commandModel) || (index < 0) || (index >= static_cast<int>(m_entries.size())))
+        return;
+
+    auto& entry = m_entries[static_cast<size_t>(index)];
+    if (entry->m_hasOno)
+        m_entriesByOno.erase(entry->m_onoIter);
+
+    m_entries.erase(m_entries.begin() + index);
+    UpdateRows(index);
+}
+
+void CommandIndex::valueTreeChildOrderChanged(juce::ValueTree& parentTree, int oldIndex, int newIndex)
+{
+    int numEntries = static_cast<int>(m_entries.size());
+    if ((parentTree != m_commandModel) || (oldIndex < 0) || (oldIndex >= numEntries) || (newIndex < 0) || (newIndex >= numEntries))
+        return;
+
+    auto entry = std::move(m_entries[static_cast<size_t>(oldIndex)]);
+    m_entries.erase(m_entries.begin() + oldIndex);
+    m_entries.insert(m_entries.begin() + newIndex, std::move(entry));
+    UpdateRows(juce::jmin(oldIndex, newIndex));
+}
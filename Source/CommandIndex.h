@@ -0,0 +1,123 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <map>
+
+
+/**
+ * Search index over all commands of the CommandModel. The index listens to the model and is updated 
+ * incrementally with every change (See juce::ValueTree::Listener), so that queries never need to touch 
+ * any GUI controls, and stay fast for projects with 10,000+ commands.
+ *
+ * Queries consist of whitespace-separated terms, all of which must match (Values with whitespace can be quoted):
+ *  class:<text>        Class name contains text, i.e. class:gain
+ *  prop:<text>         Property name contains text, i.e. prop:mute
+ *  cmd:<text>          Command name contains text, i.e. cmd:set or cmd:addsub
+ *  name:<text>         Page name contains text, i.e. name:"Page 1"
+ *  ono:<n>             ONo equals n, i.e. ono:10001 or ono:0x2711
+ *  ono:<min>-<max>     ONo within the range, inclusive, i.e. ono:10000-10099
+ *  ono:<value>/<mask>  ONo matches value in all bits set in mask, i.e. ono:0x10000/0xFFFF0000
+ *  <text>              Any of the above texts contains text, or the ONo equals text if it is a number.
+ * Text comparisons are case-insensitive.
+ */
+class CommandIndex : private juce::ValueTree::Listener
+{
+public:
+    /**
+     * @param[in] commandModel  CommandModel::CommandSetType node to index. 
+     */
+    explicit CommandIndex(juce::ValueTree commandModel);
+    ~CommandIndex() override;
+
+    /**
+     * Find all commands matching the given query.
+     *
+     * @param[in] query     Query string, see class description. An empty query matches all commands.
+     * @return  The matching CommandModel::CommandType nodes, in model order.
+     */
+    std::vector<juce::ValueTree> Find(const juce::String& query) const;
+
+    /**
+     * @return  Number of indexed commands.
+     */
+    int GetNumCommands() const;
+
+
+private:
+    /**
+     * Pre-processed search fields of one command.
+     */
+    struct Entry
+    {
+        juce::ValueTree m_command;      // The indexed command node.
+        int m_row = 0;                  // Index of the command within the CommandModel.
+        bool m_hasOno = false;          // True if the command has a valid ONo.
+        juce::uint32 m_ono = 0;         // ONo of the command, only valid if m_hasOno.
+        juce::String m_class;           // Lower-case class name.
+        juce::String m_property;        // Lower-case property name.
+        juce::String m_commandName;     // Lower-case command name.
+        juce::String m_name;            // Lower-case page name.
+
+        std::multimap<juce::uint32, Entry*>::iterator m_onoIter; // Position in m_entriesByOno, only valid if m_hasOno.
+    };
+
+    /**
+     * Update the given field of an entry from its command node, and maintain m_entriesByOno.
+     *
+     * @param[in] entry     Entry to update.
+     * @param[in] property  CommandModel property which changed.
+     */
+    void UpdateEntry(Entry& entry, const juce::Identifier& property);
+
+    /**
+     * Update the m_row of all entries from the given one onwards.
+     *
+     * @param[in] firstRow  Index of the first entry whose position changed.
+     */
+    void UpdateRows(int firstRow);
+
+
+    // Reimplemented from juce::ValueTree::Listener
+
+    void valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property) override;
+    void valueTreeChildAdded(juce::ValueTree& parentTree, juce::ValueTree& child) override;
+    void valueTreeChildRemoved(juce::ValueTree& parentTree, juce::ValueTree& child, int index) override;
+    void valueTreeChildOrderChanged(juce::ValueTree& parentTree, int oldIndex, int newIndex) override;
+
+
+    // The indexed CommandModel.
+    juce::ValueTree m_commandModel;
+
+    // One entry per command, in model order.
+    std::vector<std::unique_ptr<Entry>> m_entries;
+
+    // Entries of all commands with a valid ONo, sorted by ONo. Used for ONo queries.
+    std::multimap<juce::uint32, Entry*> m_entriesByOno;
+
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CommandIndex)
+};
@@ -0,0 +1,462 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#include "CommandModel.h"
+#include "Common.h"
+#include "AES70.h"
+#include "AES70Codec.h"
+#include "AES70Schema.h"
+#include "Metrics.h"
+#include "Trace.h"
+
+
+namespace CommandModel
+{
+
+/**
+ * The AES70 object, property and method selected by a command node.
+ */
+struct ResolvedCommand
+{
+    std::unique_ptr<AES70::OcaRoot> m_object;
+    AES70::Property m_prop = {};
+    const AES70::PropertyDefinition* m_propDefinition = nullptr;
+    const AES70::MethodDefinition* m_method = nullptr;
+    int m_methodIdx = 0;
+    int m_commandDefLevel = 0;
+    bool m_getMethodSelected = false;
+    bool m_setMethodSelected = false;
+    bool m_addSubscriptionSelected = false;
+};
+
+/**
+ * Helper method to get an integer property of a command node.
+ *
+ * @param[in] command       Node of type CommandType.
+ * @param[in] id            Identifier of the property.
+ * @param[in] defaultValue  Value to return if the property is missing or empty, 
+ *                          matching the default of the corresponding GUI control.
+ * @return  The property value, interpreted by its leading number.
+ */
+static int GetIntProperty(const juce::ValueTree& command, const juce::Identifier& id, int defaultValue)
+{
+    auto valueString = command.getProperty(id).toString();
+    if (valueString.isEmpty())
+        return defaultValue;
+
+    return valueString.getIntValue();
+}
+
+/**
+ * Helper method to get the data type matching the name given by AES70::Schema::GetDataTypeName.
+ *
+ * @param[in] typeName  Name of the data type.
+ * @return  The data type. Defaults to NanoOcp1::OCP1DATATYPE_BOOLEAN, as the GUI does for custom classes.
+ */
+static int GetDataTypeFromName(const juce::String& typeName)
+{
+    auto dataType = AES70::Schema::GetDataTypeFromName(typeName);
+    return (dataType != 0) ? dataType : NanoOcp1::OCP1DATATYPE_BOOLEAN;
+}
+
+/**
+ * Determine the AES70 object, property and method selected by a command node.
+ * This mirrors the way StringGeneratorContainer interprets the same selection on its GUI controls.
+ *
+ * @param[in] command       Node of type CommandType.
+ * @param[out] resolved     The selected object, property and method.
+ * @return  True if class, property and command are all selected and valid.
+ */
+static bool ResolveCommand(const juce::ValueTree& command, ResolvedCommand& resolved)
+{
+    auto className = command.getProperty(Class).toString();
+    auto propertyText = command.getProperty(Property).toString();
+    auto commandText = command.getProperty(Command).toString();
+    if (className.isEmpty() || propertyText.isEmpty() || commandText.isEmpty())
+        return false;
+
+    resolved.m_addSubscriptionSelected = (commandText == "AddSubscription");
+
+    // Custom AES70 class: property index, definition levels and data type are user-defined.
+    if (className == "Custom")
+    {
+        resolved.m_object.reset(AES70::OcaRoot::CreateCustom());
+
+        auto customObj = static_cast<AES70::OcaCustomClass*>(resolved.m_object.get());
+        customObj->m_customProp = { 
+            GetIntProperty(command, PropDefLevel, 1), /*m_defLevel*/ 
+            propertyText.getTrailingIntValue(), /*m_index*/ 
+            GetDataTypeFromName(command.getProperty(Type).toString()), /*m_type*/
+            "Custom", /*m_name*/ 0, /*m_getMethodIdx*/ 0 /*m_setMethodIdx*/ 
+        };
+        resolved.m_prop = customObj->m_customProp;
+        resolved.m_commandDefLevel = GetIntProperty(command, CmdDefLevel, 1);
+
+        // The GUI offers custom Get commands with ids 1 to 8, and Set commands with ids 9 to 16.
+        resolved.m_methodIdx = commandText.getIntValue();
+        if (commandText.endsWith("SetValue"))
+            resolved.m_methodIdx += 8;
+
+        resolved.m_getMethodSelected = (resolved.m_methodIdx <= 8);
+        resolved.m_setMethodSelected = (resolved.m_methodIdx > 8) && (resolved.m_methodIdx <= 16);
+    }
+
+    // Usual case: a standard AES70 class (not proprietary).
+    else
+    {
+        int classIdx = AES70::OcaRoot::GetClassIdxFromName(className);
+        if (classIdx == 0)
+            return false;
+
+        resolved.m_object.reset(AES70::OcaRoot::Create(classIdx));
+        if (!resolved.m_object)
+            return false;
+
+        // Property texts are formatted as "defLevel,index: name".
+        int propDefLevel = propertyText.upToFirstOccurrenceOf(",", false, false).getIntValue();
+        int propIndex = propertyText.fromFirstOccurrenceOf(",", false, false).getIntValue();
+        auto propertyList = resolved.m_object->GetProperties();
+        auto iter = std::find_if(propertyList.begin(), propertyList.end(), 
+                                 [propDefLevel, propIndex](const AES70::Property& prop)
+                                 {
+                                     return (prop.m_defLevel == propDefLevel) && (prop.m_index == propIndex);
+                                 });
+        if (iter == propertyList.end())
+            return false;
+
+        resolved.m_prop = *iter;
+        resolved.m_commandDefLevel = resolved.m_prop.m_defLevel;
+        resolved.m_methodIdx = commandText.getIntValue();
+        resolved.m_getMethodSelected = (resolved.m_methodIdx == resolved.m_prop.m_getMethodIdx);
+        resolved.m_setMethodSelected = (resolved.m_methodIdx == resolved.m_prop.m_setMethodIdx);
+
+        const auto& schema = AES70::Schema::GetInstance();
+        resolved.m_propDefinition = schema.GetPropertyDefinition(classIdx, propDefLevel, propIndex);
+        resolved.m_method = schema.GetMethodDefinition(classIdx, resolved.m_commandDefLevel, resolved.m_methodIdx);
+    }
+
+    if (resolved.m_addSubscriptionSelected)
+    {
+        resolved.m_methodIdx = MethodIndexForAddSubscription;
+        resolved.m_getMethodSelected = false;
+        resolved.m_setMethodSelected = false;
+    }
+
+    return (resolved.m_methodIdx > 0);
+}
+
+/**
+ * Helper method to get the parameter signature of the Command or the Response of a resolved command.
+ * Methods which are not described by the Schema, such as those of custom classes, transfer the property value only.
+ *
+ * @param[in] resolved  The resolved command.
+ * @param[in] response  True for the signature of the Response, false for that of the Command.
+ * @return  The parameters.
+ */
+static std::vector<AES70::MethodParam> GetSignature(const ResolvedCommand& resolved, bool response)
+{
+    if (resolved.m_method != nullptr)
+        return response ? resolved.m_method->m_returns : resolved.m_method->m_params;
+
+    if (response == resolved.m_getMethodSelected)
+        return { { resolved.m_prop.m_type, AES70::PARAM_ROLE_VALUE } };
+
+    return {};
+}
+
+/**
+ * Helper method to get the value strings of the parameters of a signature.
+ *
+ * @param[in] resolved      The resolved command, whose property definition provides ranges.
+ * @param[in] signature     The parameters.
+ * @param[in] valueString   Value of the PARAM_ROLE_VALUE parameters.
+ * @param[out] dataTypes    Data type of each parameter.
+ * @return  The value string of each parameter.
+ */
+static juce::StringArray GetParamValues(const ResolvedCommand& resolved,
+                                        const std::vector<AES70::MethodParam>& signature,
+                                        const juce::String& valueString,
+                                        std::vector<int>& dataTypes)
+{
+    juce::StringArray values;
+    dataTypes.clear();
+    for (const auto& param : signature)
+    {
+        dataTypes.push_back(param.m_type);
+        if (param.m_role == AES70::PARAM_ROLE_VALUE || resolved.m_propDefinition == nullptr)
+            values.add(valueString);
+        else if (param.m_role == AES70::PARAM_ROLE_MIN)
+            values.add(juce::String(resolved.m_propDefinition->m_minValue));
+        else
+            values.add(juce::String(resolved.m_propDefinition->m_maxValue));
+    }
+
+    return values;
+}
+
+/**
+ * Helper method to locate the value parameter within encoded parameter data.
+ *
+ * @param[in] signature     Parameters of the method, as returned by GetSignature.
+ * @param[in] values        Encoded value of each parameter, as returned by GetParamValues.
+ * @param[in] dataTypes     Data type of each parameter, as returned by GetParamValues.
+ * @param[in] paramDataEnd  Position within the binary string right after the parameter data.
+ * @param[in] paramDataSize Size of the parameter data.
+ * @return  Position of the first parameter with the value role. Empty if there is none.
+ */
+static ValueRange LocateValue(const std::vector<AES70::MethodParam>& signature, 
+                              const juce::StringArray& values, 
+                              const std::vector<int>& dataTypes,
+                              std::size_t paramDataEnd,
+                              std::size_t paramDataSize)
+{
+    ValueRange range;
+    std::size_t offset = paramDataEnd - paramDataSize;
+    for (std::size_t i = 0; i < signature.size(); i++)
+    {
+        auto size = AES70::OcaRoot::GetParamDataSize(values[static_cast<int>(i)], dataTypes[i]);
+        if (signature[i].m_role == AES70::PARAM_ROLE_VALUE)
+        {
+            range.m_offset = offset;
+            range.m_size = size;
+            break;
+        }
+
+        offset += size;
+    }
+
+    // Only trust the range if it lies within the parameter data.
+    if (range.m_offset + range.m_size > paramDataEnd)
+        return {};
+
+    return range;
+}
+
+bool CreateBinaryStrings(const juce::ValueTree& command,
+                         juce::MemoryBlock& commandMemBlock,
+                         juce::MemoryBlock& responseMemBlock,
+                         juce::MemoryBlock& notificationMemBlock,
+                         ValueRanges* valueRanges,
+                         juce::String* errorMessage)
+{
+    AES70_TRACE_SCOPE("CommandModel::CreateBinaryStrings");
+    Metrics::ScopedGenerationTimer generationTimer;
+
+    commandMemBlock.reset();
+    responseMemBlock.reset();
+    notificationMemBlock.reset();
+
+    ValueRanges ranges;
+    if (valueRanges != nullptr)
+        *valueRanges = ranges;
+
+    ResolvedCommand resolved;
+    if (!ResolveCommand(command, resolved))
+        return false;
+
+    const auto& prop = resolved.m_prop;
+    std::uint32_t targetOno = static_cast<std::uint32_t>(GetIntProperty(command, Ono, 0));
+    std::uint8_t responseStatus = static_cast<std::uint8_t>(GetIntProperty(command, Status, 0));
+
+    std::uint8_t responseParamCount(0);
+    std::vector<std::uint8_t> responseParamData;
+    std::vector<std::uint8_t> commandParamData;
+    NanoOcp1::Ocp1CommandDefinition commandDefinition;
+
+    // Parameters are encoded at the very end of Commands and Responses, so the value's position is 
+    // recorded relative to the end of the parameter data, and resolved once the strings are complete.
+    std::vector<AES70::MethodParam> commandSignature, responseSignature;
+    juce::StringArray commandValues, responseValues;
+    std::vector<int> commandDataTypes, responseDataTypes;
+
+    // Values which cannot be encoded completely, i.e. too large blobs, fail the whole command rather than being truncated.
+    juce::String encodeError;
+
+    // Depending on whether the Get, Set, or AddSubscription commands are selected,
+    // the commandDefinition will be defined differently.
+    if (resolved.m_getMethodSelected)
+    {
+        // A response will only contain data if the status is OK.
+        if (responseStatus == 0 /* OCASTATUS_OK */)
+        {
+            responseSignature = GetSignature(resolved, true);
+            responseValues = GetParamValues(resolved, responseSignature, command.getProperty(RspValue).toString(), responseDataTypes);
+            responseParamCount = static_cast<std::uint8_t>(responseValues.size());
+            responseParamData = AES70::OcaRoot::CreateParamDataFromStrings(responseValues, responseDataTypes, &encodeError);
+        }
+
+        commandDefinition = NanoOcp1::Ocp1CommandDefinition(targetOno,
+                                                            static_cast<std::uint16_t>(prop.m_type),
+                                                            static_cast<std::uint16_t>(resolved.m_commandDefLevel),
+                                                            static_cast<std::uint16_t>(resolved.m_methodIdx));
+    }
+    else if (resolved.m_setMethodSelected)
+    {
+        commandSignature = GetSignature(resolved, false);
+        commandValues = GetParamValues(resolved, commandSignature, command.getProperty(CmdValue).toString(), commandDataTypes);
+        commandParamData = AES70::OcaRoot::CreateParamDataFromStrings(commandValues, commandDataTypes, &encodeError);
+
+        commandDefinition = NanoOcp1::Ocp1CommandDefinition(targetOno,
+                                                            static_cast<std::uint16_t>(prop.m_type),
+                                                            static_cast<std::uint16_t>(resolved.m_commandDefLevel),
+                                                            static_cast<std::uint16_t>(resolved.m_methodIdx),
+                                                            static_cast<std::uint8_t>(commandValues.size()), /* paramCount */
+                                                            commandParamData);
+    }
+    else if (resolved.m_addSubscriptionSelected)
+    {
+        commandDefinition = NanoOcp1::Ocp1CommandDefinition(targetOno,
+                                                            static_cast<std::uint16_t>(prop.m_type),
+                                                            static_cast<std::uint16_t>(prop.m_defLevel),
+                                                            static_cast<std::uint16_t>(prop.m_index)).AddSubscriptionCommand();
+
+        auto notificationParamData = AES70::OcaRoot::CreateParamDataFromString(command.getProperty(NotifValue).toString(), prop.m_type, &encodeError);
+        notificationMemBlock = NanoOcp1::Ocp1Notification(targetOno,
+                                                          static_cast<std::uint16_t>(prop.m_defLevel),
+                                                          static_cast<std::uint16_t>(prop.m_index),
+                                                          1 /* paramCount */,
+                                                          notificationParamData).GetMemoryBlock();
+
+        // The value is the only parameter of the Notification, and is followed by the ChangeType (Uint8).
+        if (!notificationParamData.empty() && (notificationMemBlock.getSize() >= notificationParamData.size() + 1))
+        {
+            ranges.m_notification.m_offset = notificationMemBlock.getSize() - 1 - notificationParamData.size();
+            ranges.m_notification.m_size = notificationParamData.size();
+        }
+    }
+
+    if (encodeError.isNotEmpty())
+    {
+        notificationMemBlock.reset();
+        if (errorMessage != nullptr)
+            *errorMessage = encodeError;
+        return false;
+    }
+
+    std::uint32_t dummyHandle; // Auto-generated by Ocp1CommandResponseRequired, will be thrown away.
+    NanoOcp1::Ocp1CommandResponseRequired ocp1Command(commandDefinition, dummyHandle);
+
+    // Replace the auto-generated handle with the user-defined one, which stays below the internal handles.
+    auto handleString = command.getProperty(Handle).toString();
+    std::uint32_t userHandle(AES70::ClampUserHandle(handleString.isEmpty() ? 1 : handleString.getLargeIntValue()));
+    ocp1Command.SetHandle(userHandle);
+
+    commandMemBlock = ocp1Command.GetMemoryBlock();
+    responseMemBlock = NanoOcp1::Ocp1Response(userHandle, responseStatus, responseParamCount, responseParamData).GetMemoryBlock();
+
+    if (valueRanges != nullptr)
+    {
+        if (!commandParamData.empty() && (commandMemBlock.getSize() >= commandParamData.size()))
+            ranges.m_command = LocateValue(commandSignature, commandValues, commandDataTypes, commandMemBlock.getSize(), commandParamData.size());
+        if (!responseParamData.empty() && (responseMemBlock.getSize() >= responseParamData.size()))
+            ranges.m_response = LocateValue(responseSignature, responseValues, responseDataTypes, responseMemBlock.getSize(), responseParamData.size());
+
+        *valueRanges = ranges;
+    }
+
+    return true;
+}
+
+juce::String GetCommandValue(const juce::ValueTree& command)
+{
+    ResolvedCommand resolved;
+    if (!ResolveCommand(command, resolved))
+        return juce::String();
+
+    if (resolved.m_getMethodSelected)
+        return command.getProperty(RspValue).toString();
+    else if (resolved.m_setMethodSelected)
+        return command.getProperty(CmdValue).toString();
+    else if (resolved.m_addSubscriptionSelected)
+        return command.getProperty(NotifValue).toString();
+
+    return juce::String();
+}
+
+juce::ValueTree CreateGetCommand(int classIdx, std::uint32_t ono)
+{
+    const auto& schema = AES70::Schema::GetInstance();
+    auto classDefinition = schema.GetClass(classIdx);
+    if (classDefinition == nullptr)
+        return juce::ValueTree();
+
+    // Properties are ordered from OcaRoot downwards, so the last readable one is the most specific.
+    auto properties = schema.GetProperties(classIdx);
+    auto propIter = std::find_if(properties.rbegin(), properties.rend(), 
+                                 [](const AES70::Property& prop) { return (prop.m_getMethodIdx != 0); });
+    if (propIter == properties.rend())
+        return juce::ValueTree();
+
+    const auto& prop = *propIter;
+    auto getMethod = schema.GetMethodDefinition(classIdx, prop.m_defLevel, prop.m_getMethodIdx);
+
+    // Texts formatted as shown by the StringGeneratorPage's combo boxes.
+    juce::ValueTree command(CommandType);
+    command.setProperty(Name, classDefinition->m_name + " " + juce::String(ono), nullptr);
+    command.setProperty(Class, schema.GetClassText(classIdx), nullptr);
+    command.setProperty(Ono, juce::String(ono), nullptr);
+    command.setProperty(Property, juce::String(prop.m_defLevel) + "," + juce::String(prop.m_index) + ": " + prop.m_name, nullptr);
+    command.setProperty(Command, juce::String(prop.m_getMethodIdx) + ": " + (getMethod ? getMethod->m_name : "GetValue"), nullptr);
+    command.setProperty(Handle, "1", nullptr);
+    command.setProperty(Status, "0: OK", nullptr);
+
+    return command;
+}
+
+bool GetSubscribedProperty(const juce::ValueTree& command, std::uint32_t& ono, int& defLevel, int& propIndex, int& dataType)
+{
+    ResolvedCommand resolved;
+    if (!ResolveCommand(command, resolved) || !resolved.m_addSubscriptionSelected)
+        return false;
+
+    ono = static_cast<std::uint32_t>(GetIntProperty(command, Ono, 0));
+    defLevel = resolved.m_prop.m_defLevel;
+    propIndex = resolved.m_prop.m_index;
+    dataType = resolved.m_prop.m_type;
+
+    return true;
+}
+
+CommandProperties GetCommandProperties(const juce::ValueTree& commandSet)
+{
+    CommandProperties properties;
+    properties.reserve(static_cast<size_t>(commandSet.getNumChildren()));
+    for (const auto& command : commandSet)
+    {
+        if (!command.hasType(CommandType))
+            continue;
+
+        juce::NamedValueSet commandProperties;
+        for (int propertyIdx = 0; propertyIdx < command.getNumProperties(); propertyIdx++)
+        {
+            auto propertyId = command.getPropertyName(propertyIdx);
+            commandProperties.set(propertyId, command.getProperty(propertyId));
+        }
+        properties.push_back(std::move(commandProperties));
+    }
+
+    return properties;
+}
+
+} // namespace CommandModel
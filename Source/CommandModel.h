@@ -0,0 +1,145 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+
+/**
+ * The command model holds the configuration of all StringGeneratorPages in a single juce::ValueTree.
+ * Its root node is of type CommandSetType, and contains one CommandType child node per page.
+ * Properties of the child nodes are named and formatted exactly like the attributes of the 
+ * "AES70Command" elements in XML config files, so that both can be converted losslessly.
+ */
+namespace CommandModel
+{
+
+static const juce::Identifier CommandSetType("AES70CommandSet");  // Type of the root node.
+static const juce::Identifier CommandType("AES70Command");        // Type of each command node.
+
+static const juce::Identifier Name("name");                 // Page name, i.e. "Page 1".
+static const juce::Identifier Class("class");               // AES70 class, i.e. "1.1.1.5: OcaGain" or "Custom".
+static const juce::Identifier Ono("ono");                   // Object number.
+static const juce::Identifier Property("property");         // Property, i.e. "4,1: Gain" or "Property 1" for custom classes.
+static const juce::Identifier PropDefLevel("propDefLevel"); // Property definition level.
+static const juce::Identifier Type("type");                 // Property data type, as given by NanoOcp1::DataTypeToString.
+static const juce::Identifier Command("command");           // Command, i.e. "2: SetValue" or "AddSubscription".
+static const juce::Identifier CmdDefLevel("cmdDefLevel");   // Command definition level.
+static const juce::Identifier Handle("handle");             // Command handle.
+static const juce::Identifier Status("status");             // Response status, i.e. "0: OK".
+static const juce::Identifier CmdValue("cmdValue");         // Value of Set commands.
+static const juce::Identifier RspValue("rspValue");         // Value of Get command responses.
+static const juce::Identifier NotifValue("notifValue");     // Value of notifications, for AddSubscription commands.
+
+/**
+ * Position of the encoded value within a binary string.
+ */
+struct ValueRange
+{
+    std::size_t m_offset = 0;   // Position of the first value byte within the binary string.
+    std::size_t m_size = 0;     // Number of value bytes, zero if the binary string contains no value.
+};
+
+/**
+ * Positions of the encoded values within the binary strings created by CreateBinaryStrings.
+ */
+struct ValueRanges
+{
+    ValueRange m_command;       // CmdValue within the Command binary string.
+    ValueRange m_response;      // RspValue within the Response binary string.
+    ValueRange m_notification;  // NotifValue within the Notification binary string.
+};
+
+/**
+ * Create the Command, Response, and Notification binary strings for a command node, without 
+ * the need for any GUI controls. The resulting strings are identical to the ones created 
+ * by a StringGeneratorPage showing the same configuration.
+ *
+ * @param[in] command               Node of type CommandType.
+ * @param[out] commandMemBlock      The resulting Command binary string.
+ * @param[out] responseMemBlock     The resulting Response binary string.
+ * @param[out] notificationMemBlock The resulting Notification binary string. Only non-empty if 
+ *                                  the AddSubscription command is selected.
+ * @param[out] valueRanges          Optional positions of the values within the strings, as recorded while 
+ *                                  encoding them, i.e. to patch later value changes into the strings.
+ * @param[out] errorMessage         Optional description of why a value could not be encoded, i.e. because the 
+ *                                  file of a blob cannot be read. Left untouched if the node is merely incomplete.
+ * @return  True if the command node is complete, and all strings could be generated.
+ */
+bool CreateBinaryStrings(const juce::ValueTree& command, 
+                         juce::MemoryBlock& commandMemBlock, 
+                         juce::MemoryBlock& responseMemBlock, 
+                         juce::MemoryBlock& notificationMemBlock,
+                         ValueRanges* valueRanges = nullptr,
+                         juce::String* errorMessage = nullptr);
+
+/**
+ * Get the value which is relevant for the selected command: the Set value for Set commands,
+ * the Response value for Get commands, or the Notification value for AddSubscription.
+ *
+ * @param[in] command   Node of type CommandType.
+ * @return  The relevant value as a string, or an empty string if no command is selected.
+ */
+juce::String GetCommandValue(const juce::ValueTree& command);
+
+/**
+ * Get the property which an AddSubscription command subscribes to, i.e. to route the Notifications 
+ * received for it, without the need to generate the binary strings.
+ *
+ * @param[in] command       Node of type CommandType.
+ * @param[out] ono          ONo of the object emitting the Notifications.
+ * @param[out] defLevel     Definition level of the property.
+ * @param[out] propIndex    Index of the property.
+ * @param[out] dataType     Data type of the property.
+ * @return  True if the command node is complete and the AddSubscription command is selected.
+ */
+bool GetSubscribedProperty(const juce::ValueTree& command, std::uint32_t& ono, int& defLevel, int& propIndex, int& dataType);
+
+/**
+ * Create a command node getting the value of an object, i.e. for an object discovered on the device 
+ * (See ObjectTreeWalker). The Get command of the class's most specific readable property is selected,
+ * i.e. GetGain for OcaGain.
+ *
+ * @param[in] classIdx  Index of the object's class within the Schema.
+ * @param[in] ono       ONo of the object.
+ * @return  Node of type CommandType, or an invalid node if the class has no readable property.
+ */
+juce::ValueTree CreateGetCommand(int classIdx, std::uint32_t ono);
+
+/**
+ * Properties of all command nodes, in the order of the nodes.
+ */
+using CommandProperties = std::vector<juce::NamedValueSet>;
+
+/**
+ * Take a snapshot of the properties of all command nodes, i.e. to write them to a file on another thread.
+ * Unlike createCopy(), no nodes are created, and the property values share their string data with the model.
+ *
+ * @param[in] commandSet    Node of type CommandSetType.
+ * @return  The properties of each CommandType child node.
+ */
+CommandProperties GetCommandProperties(const juce::ValueTree& commandSet);
+
+} // namespace CommandModel
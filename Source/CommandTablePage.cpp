@@ -0,0 +1,357 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#include "CommandTablePage.h"
+#include "CommandModel.h"
+#include "CommandIndex.h"
+#include "ObjectTreeWalker.h"
+#include "MainTabbedComponent.h"
+#include "Common.h"
+
+
+/**
+ * Ids of the columns of the command table. NOTE: juce::TableHeaderComponent column ids must be non-zero.
+ */
+enum CommandTableColumns
+{
+    COLUMN_PAGE = 1,
+    COLUMN_CLASS,
+    COLUMN_ONO,
+    COLUMN_PROPERTY,
+    COLUMN_COMMAND,
+    COLUMN_VALUE,
+    COLUMN_COMMAND_STRING,
+};
+
+static constexpr int CommandTableRowHeight = 22; // Height of each table row in pixels.
+
+
+//==============================================================================
+// Class CommandTablePage
+//==============================================================================
+
+CommandTablePage::CommandTablePage(MainTabbedComponent* parent)
+    :   AbstractPage(parent),
+        m_commandModel(parent->GetCommandModel()),
+        m_summaryLabel(juce::Label("CommandTablePage Summary")),
+        m_filterEdit(juce::TextEditor("CommandTablePage Filter")),
+        m_discoverButton(juce::TextButton("Discover")),
+        m_createPagesButton(juce::TextButton("Create pages")),
+        m_table(juce::TableListBox("CommandTable")),
+        m_rowsChanged(true)
+{
+    jassert(parent != nullptr);
+
+    m_summaryLabel.setColour(juce::Label::textColourId, LabelEnabledTextColour);
+    m_summaryLabel.setJustificationType(juce::Justification::centredLeft);
+    addAndMakeVisible(&m_summaryLabel);
+
+    m_filterEdit.setHasFocusOutline(true);
+    m_filterEdit.setTextToShowWhenEmpty("Filter, i.e. class:gain ono:10000-10099 cmd:set name:\"Page 1\"", 
+                                        LabelEnabledTextColour.withAlpha(0.6f));
+    m_filterEdit.onTextChange = [=]()
+        {
+            ScheduleRowsUpdate();
+        };
+    addAndMakeVisible(&m_filterEdit);
+
+    for (auto button : { &m_discoverButton, &m_createPagesButton })
+    {
+        button->setClickingTogglesState(false);
+        button->setColour(juce::TextButton::ColourIds::buttonColourId, ButtonBackgroundColour);
+        button->setColour(juce::TextButton::ColourIds::textColourOffId, LabelEnabledTextColour);
+        button->setEnabled(false);
+        addAndMakeVisible(button);
+    }
+    m_discoverButton.setTooltip("Discover the objects of the device, starting from its root block");
+    m_discoverButton.onClick = [=]()
+        {
+            m_discoverButton.setEnabled(false);
+            m_summaryLabel.setText("Discovering objects...", juce::dontSendNotification);
+            GetMainComponent()->GetObjectTreeWalker().Start();
+        };
+    m_createPagesButton.setTooltip("Create a page for each discovered object which has none yet");
+    m_createPagesButton.onClick = [=]()
+        {
+            GetMainComponent()->CreatePagesForDiscoveredObjects();
+        };
+
+    m_createPagesButton.setEnabled(!GetMainComponent()->GetObjectTreeWalker().GetObjects().empty());
+    GetMainComponent()->GetObjectTreeWalker().OnWalkFinished = [=](bool /*success*/)
+        {
+            m_discoverButton.setEnabled(GetMainComponent()->GetConnectionStatus() == ConnectionStatus::Online);
+            m_createPagesButton.setEnabled(!GetMainComponent()->GetObjectTreeWalker().GetObjects().empty());
+            UpdateSummary();
+            m_table.repaint();
+        };
+
+    auto columnFlags = juce::TableHeaderComponent::visible | juce::TableHeaderComponent::resizable;
+    auto& header = m_table.getHeader();
+    header.addColumn("Page", COLUMN_PAGE, 70, 30, -1, columnFlags);
+    header.addColumn("Class", COLUMN_CLASS, 130, 30, -1, columnFlags);
+    header.addColumn("ONo", COLUMN_ONO, 60, 30, -1, columnFlags);
+    header.addColumn("Property", COLUMN_PROPERTY, 120, 30, -1, columnFlags);
+    header.addColumn("Command", COLUMN_COMMAND, 100, 30, -1, columnFlags);
+    header.addColumn("Value", COLUMN_VALUE, 70, 30, -1, columnFlags);
+    header.addColumn("Command string", COLUMN_COMMAND_STRING, 300, 30, -1, columnFlags);
+    header.setStretchToFitActive(true);
+
+    m_table.setColour(juce::ListBox::backgroundColourId, AppBackgroundColour);
+    m_table.setRowHeight(CommandTableRowHeight);
+    m_table.setModel(this);
+    addAndMakeVisible(&m_table);
+
+    m_commandModel.addListener(this);
+    ScheduleRowsUpdate();
+
+    setSize(10, 10);
+}
+
+CommandTablePage::~CommandTablePage()
+{
+    GetMainComponent()->GetObjectTreeWalker().OnWalkFinished = nullptr;
+    m_commandModel.removeListener(this);
+    m_table.setModel(nullptr);
+    cancelPendingUpdate();
+}
+
+void CommandTablePage::UpdateConnectionStatus(ConnectionStatus status)
+{
+    m_discoverButton.setEnabled((status == ConnectionStatus::Online) && !GetMainComponent()->GetObjectTreeWalker().IsRunning());
+}
+
+void CommandTablePage::paint(juce::Graphics& g)
+{
+    g.fillAll(AppBackgroundColour);
+}
+
+void CommandTablePage::resized()
+{
+    auto bounds = getLocalBounds().reduced(4);
+    int margin = 2;
+    int controlHeight = 40;
+
+    auto rowBounds = bounds.removeFromTop(static_cast<int>(controlHeight * 0.75));
+    auto buttonWidth = rowBounds.getWidth() / 9;
+    m_createPagesButton.setBounds(rowBounds.removeFromRight(buttonWidth).reduced(margin));
+    m_discoverButton.setBounds(rowBounds.removeFromRight(buttonWidth).reduced(margin));
+    m_summaryLabel.setBounds(rowBounds.removeFromLeft(rowBounds.getWidth() / 3).reduced(margin));
+    m_filterEdit.setBounds(rowBounds.reduced(margin));
+    m_table.setBounds(bounds.reduced(margin));
+
+    juce::Component::resized();
+}
+
+int CommandTablePage::getNumRows()
+{
+    // Only changes in handleAsyncUpdate, together with the table's content.
+    return static_cast<int>(m_rows.size());
+}
+
+void CommandTablePage::paintRowBackground(juce::Graphics& g, int rowNumber, int /*width*/, int /*height*/, bool rowIsSelected)
+{
+    if (rowIsSelected)
+        g.fillAll(LabelEnabledTextColour.withAlpha(0.35f));
+    else if ((rowNumber % 2) == 1)
+        g.fillAll(AppBackgroundColour.brighter(0.1f));
+}
+
+void CommandTablePage::paintCell(juce::Graphics& g, int rowNumber, int columnId, int width, int height, bool /*rowIsSelected*/)
+{
+    auto textColour = LabelEnabledTextColour;
+
+    // Show whether the device has an object of the row's class under the row's ONo.
+    if ((columnId == COLUMN_ONO) && (rowNumber >= 0) && (rowNumber < static_cast<int>(m_rows.size())))
+    {
+        switch (GetMainComponent()->GetObjectTreeWalker().Validate(m_rows[static_cast<size_t>(rowNumber)]))
+        {
+            case ObjectTreeWalker::Validation::Match:
+                textColour = ReadBackMatchColour;
+                break;
+            case ObjectTreeWalker::Validation::Mismatch:
+                textColour = ReadBackMismatchColour;
+                break;
+            case ObjectTreeWalker::Validation::Unknown:
+            default:
+                break;
+        }
+    }
+
+    g.setColour(textColour);
+    g.setFont(static_cast<float>(height) * 0.6f);
+    g.drawText(GetCellText(rowNumber, columnId), 2, 0, width - 4, height, juce::Justification::centredLeft, true);
+}
+
+void CommandTablePage::cellDoubleClicked(int rowNumber, int /*columnId*/, const juce::MouseEvent& /*e*/)
+{
+    ShowPageForRow(rowNumber);
+}
+
+void CommandTablePage::returnKeyPressed(int lastRowSelected)
+{
+    ShowPageForRow(lastRowSelected);
+}
+
+void CommandTablePage::valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& /*property*/)
+{
+    if ((tree.getParent() != m_commandModel) || m_rowsChanged)
+        return;
+
+    // The change might affect whether the command matches the filter.
+    if (m_filterEdit.getText().isNotEmpty())
+    {
+        ScheduleRowsUpdate();
+        return;
+    }
+
+    // Otherwise only the changed row needs to be re-generated and repainted. 
+    auto rowIter = std::find(m_rows.begin(), m_rows.end(), tree);
+    if (rowIter != m_rows.end())
+    {
+        auto rowNumber = static_cast<int>(std::distance(m_rows.begin(), rowIter));
+        m_cachedRowTexts[static_cast<size_t>(rowNumber)] = CachedRowTexts();
+        m_table.repaintRow(rowNumber);
+    }
+}
+
+void CommandTablePage::valueTreeChildAdded(juce::ValueTree& parentTree, juce::ValueTree& /*child*/)
+{
+    if (parentTree != m_commandModel)
+        return;
+
+    ScheduleRowsUpdate();
+}
+
+void CommandTablePage::valueTreeChildRemoved(juce::ValueTree& parentTree, juce::ValueTree& /*child*/, int /*index*/)
+{
+    if (parentTree != m_commandModel)
+        return;
+
+    ScheduleRowsUpdate();
+}
+
+void CommandTablePage::valueTreeChildOrderChanged(juce::ValueTree& parentTree, int /*oldIndex*/, int /*newIndex*/)
+{
+    if (parentTree != m_commandModel)
+        return;
+
+    ScheduleRowsUpdate();
+}
+
+void CommandTablePage::handleAsyncUpdate()
+{
+    if (!m_rowsChanged)
+        return;
+
+    m_rowsChanged = false;
+    const auto& commandIndex = GetMainComponent()->GetCommandIndex();
+    m_rows = commandIndex.Find(m_filterEdit.getText());
+    m_cachedRowTexts.assign(m_rows.size(), CachedRowTexts());
+    m_table.updateContent();
+    m_table.repaint();
+
+    UpdateSummary();
+}
+
+void CommandTablePage::UpdateSummary()
+{
+    const auto& commandIndex = GetMainComponent()->GetCommandIndex();
+    juce::String summary(juce::String(m_rows.size()) + " commands");
+    if (m_filterEdit.getText().isNotEmpty())
+        summary = juce::String(m_rows.size()) + " of " + juce::String(commandIndex.GetNumCommands()) + " commands";
+
+    const auto& walker = GetMainComponent()->GetObjectTreeWalker();
+    if (!walker.GetObjects().empty() && walker.IsRevalidation())
+        summary << ", " << juce::String(walker.GetObjects().size()) << " cached objects revalidated in " 
+                << juce::String(walker.GetNumRoundTrips()) << " round trips (" 
+                << juce::String(walker.GetNumChangedBlocks()) << " blocks changed)";
+    else if (!walker.GetObjects().empty())
+        summary << ", " << juce::String(walker.GetObjects().size()) << " objects discovered in " 
+                << juce::String(walker.GetNumRoundTrips()) << " round trips";
+
+    m_summaryLabel.setText(summary, juce::dontSendNotification);
+}
+
+juce::String CommandTablePage::GetCellText(int rowNumber, int columnId)
+{
+    if ((rowNumber < 0) || (rowNumber >= static_cast<int>(m_rows.size())))
+        return {};
+
+    const auto& command = m_rows[static_cast<size_t>(rowNumber)];
+
+    switch (columnId)
+    {
+        case COLUMN_PAGE:
+            return command.getProperty(CommandModel::Name).toString();
+        case COLUMN_CLASS:
+            return command.getProperty(CommandModel::Class).toString();
+        case COLUMN_ONO:
+            return command.getProperty(CommandModel::Ono).toString();
+        case COLUMN_PROPERTY:
+            return command.getProperty(CommandModel::Property).toString();
+        case COLUMN_COMMAND:
+            return command.getProperty(CommandModel::Command).toString();
+        case COLUMN_VALUE:
+            {
+                // Format the value once, when the row is first painted.
+                auto& value = m_cachedRowTexts[static_cast<size_t>(rowNumber)].m_value;
+                if (!value.has_value())
+                    value = CommandModel::GetCommandValue(command);
+
+                return *value;
+            }
+        case COLUMN_COMMAND_STRING:
+            {
+                // Generate the command string once, when the row is first painted.
+                auto& commandString = m_cachedRowTexts[static_cast<size_t>(rowNumber)].m_commandString;
+                if (!commandString.has_value())
+                {
+                    juce::MemoryBlock commandMemBlock;
+                    juce::MemoryBlock responseMemBlock;
+                    juce::MemoryBlock notificationMemBlock;
+                    CommandModel::CreateBinaryStrings(command, commandMemBlock, responseMemBlock, notificationMemBlock);
+                    commandString = juce::String::toHexString(commandMemBlock.getData(), static_cast<int>(commandMemBlock.getSize()));
+                }
+
+                return *commandString;
+            }
+        default:
+            break;
+    }
+
+    jassertfalse; // Missing implementation for column!
+    return {};
+}
+
+void CommandTablePage::ShowPageForRow(int rowNumber)
+{
+    if ((rowNumber >= 0) && (rowNumber < static_cast<int>(m_rows.size())))
+        GetMainComponent()->ShowCommandPage(m_rows[static_cast<size_t>(rowNumber)]);
+}
+
+void CommandTablePage::ScheduleRowsUpdate()
+{
+    m_rowsChanged = true;
+    triggerAsyncUpdate();
+}
@@ -0,0 +1,153 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <optional>
+#include "AbstractPage.h"
+
+
+/**
+ * Page listing all commands of the CommandModel in a table, one row per StringGeneratorPage.
+ * The table is virtualized: only the rows currently scrolled into view are painted, and the command
+ * strings are only generated for those rows (directly from the CommandModel, see CommandModel::CreateBinaryStrings), 
+ * so that the page stays responsive for projects with hundreds or thousands of commands, whether or not 
+ * their pages were ever shown. Double-clicking a row shows the corresponding StringGeneratorPage.
+ * The rows can be filtered with a query, which is answered by the CommandIndex of the MainTabbedComponent.
+ * The objects of the connected device can be discovered (See ObjectTreeWalker), after which the ONo of each 
+ * row is colored depending on whether the device has an object of the row's class under that ONo, and pages
+ * can be created for all discovered objects.
+ */
+class CommandTablePage : public AbstractPage,
+                         private juce::TableListBoxModel,
+                         private juce::ValueTree::Listener,
+                         private juce::AsyncUpdater
+{
+public:
+    CommandTablePage(MainTabbedComponent* parent);
+    ~CommandTablePage() override;
+
+
+    // Reimplemented from AbstractPage
+
+    void UpdateConnectionStatus(ConnectionStatus status) override;
+
+
+    // Reimplemented from juce::Component
+
+    void paint(juce::Graphics&) override;
+    void resized() override;
+
+
+private:
+    // Reimplemented from juce::TableListBoxModel
+
+    int getNumRows() override;
+    void paintRowBackground(juce::Graphics& g, int rowNumber, int width, int height, bool rowIsSelected) override;
+    void paintCell(juce::Graphics& g, int rowNumber, int columnId, int width, int height, bool rowIsSelected) override;
+    void cellDoubleClicked(int rowNumber, int columnId, const juce::MouseEvent& e) override;
+    void returnKeyPressed(int lastRowSelected) override;
+
+
+    // Reimplemented from juce::ValueTree::Listener
+
+    void valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property) override;
+    void valueTreeChildAdded(juce::ValueTree& parentTree, juce::ValueTree& child) override;
+    void valueTreeChildRemoved(juce::ValueTree& parentTree, juce::ValueTree& child, int index) override;
+    void valueTreeChildOrderChanged(juce::ValueTree& parentTree, int oldIndex, int newIndex) override;
+
+
+    // Reimplemented from juce::AsyncUpdater
+
+    void handleAsyncUpdate() override;
+
+
+    /**
+     * Get the text to display in the given cell.
+     *
+     * @param[in] rowNumber     Row index within m_rows.
+     * @param[in] columnId      One of the table's column ids.
+     * @return  The cell text, or an empty string if the row does not exist.
+     */
+    juce::String GetCellText(int rowNumber, int columnId);
+
+    /**
+     * Show the StringGeneratorPage corresponding to the given row.
+     *
+     * @param[in] rowNumber     Row index within m_rows.
+     */
+    void ShowPageForRow(int rowNumber);
+
+    /**
+     * Update the m_summaryLabel with the number of rows, and the result of the last object discovery.
+     */
+    void UpdateSummary();
+
+    /**
+     * Mark the rows as outdated. The rows are re-queried on the next handleAsyncUpdate, so that 
+     * any number of changes within one message loop iteration (i.e. while loading a file) are merged.
+     */
+    void ScheduleRowsUpdate();
+
+    // The CommandModel of the MainTabbedComponent.
+    juce::ValueTree m_commandModel;
+
+    // Label showing the number of commands.
+    juce::Label m_summaryLabel;
+
+    // TextEditor to enter the filter query. See CommandIndex for the query syntax.
+    juce::TextEditor m_filterEdit;
+
+    // Button to discover the objects of the device.
+    juce::TextButton m_discoverButton;
+
+    // Button to create pages for all discovered objects.
+    juce::TextButton m_createPagesButton;
+
+    // Table with one row per command.
+    juce::TableListBox m_table;
+
+    // Commands matching the current filter, in model order. One per table row.
+    std::vector<juce::ValueTree> m_rows;
+
+    /**
+     * Texts of a row which are expensive to generate, since the command needs to be resolved against the Schema.
+     */
+    struct CachedRowTexts
+    {
+        std::optional<juce::String> m_value;            // Formatted value, see CommandModel::GetCommandValue.
+        std::optional<juce::String> m_commandString;    // Hex command string.
+    };
+
+    // Cached texts of the rows which have been painted so far, indexed by row. 
+    // Entries are reset whenever the corresponding command changes.
+    std::vector<CachedRowTexts> m_cachedRowTexts;
+
+    // True if m_rows needs to be re-queried on the next handleAsyncUpdate.
+    bool m_rowsChanged;
+
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CommandTablePage)
+};
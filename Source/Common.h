@@ -29,9 +29,24 @@ static const juce::Colour AppBackgroundColour(43, 65, 77);          // App windo
 static const juce::Colour LabelEnabledTextColour(125, 182, 212);    // Color for labels of relevant controls
 static const juce::Colour LabelDisabledTextColour(12, 12, 12);      // Color for labels of non-relevant controls
 static const juce::Colour ButtonBackgroundColour(43, 65, 77);	    // Color for button background
+static const juce::Colour ReadBackMatchColour(120, 200, 120);       // Color for values read back from the device, if as expected
+static const juce::Colour ReadBackMismatchColour(230, 160, 60);     // Color for values read back from the device, if not as expected
+static const juce::Colour EncodeErrorColour(230, 90, 80);           // Color for errors of values which cannot be encoded
 
 static const juce::String ProjectHostShortURL("https://github.com/escalonely"); // Web address of this project's host.
 static const juce::String ProjectHostLongURL("https://github.com/escalonely/AES70_OCP1_StringGenerator"); // Complete web address of this project's host.
 
+static constexpr int MethodIndexForAddSubscription = 256; // Command index used for AddSubscription.
+static constexpr int ClassIndexForCustomClass = 256; // Index used for custom (aka proprietary, non-standard) AES70 classes.
+
 static constexpr int AppWindowDefaultWidth = 640; // Default App window width.
 static constexpr int AppWindowDefaultHeight = 480; // Default App window height, also used for m_container within the juce::Viewport.
+
+static constexpr int PageReleaseTimeoutDefault = 60000; // Default time in ms after which the GUI controls of hidden pages are released.
+static constexpr int PageReleaseCheckInterval = 1000; // Interval in ms at which hidden pages are checked for release.
+
+// Define as 1 (i.e. in the Projucer's preprocessor definitions) to record the scopes marked with 
+// AES70_TRACE_SCOPE, which can be written as Chrome trace JSON on exit (See Trace.h).
+#ifndef AES70_ENABLE_TRACING
+#define AES70_ENABLE_TRACING 0
+#endif
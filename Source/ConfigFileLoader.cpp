@@ -0,0 +1,124 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#include "ConfigFileLoader.h"
+#include "BinaryProjectFile.h"
+#include "CommandModel.h"
+#include "Trace.h"
+
+
+//==============================================================================
+// Class ConfigFileLoader
+//==============================================================================
+
+ConfigFileLoader::ConfigFileLoader(const juce::File& configFile)
+    :   juce::ThreadWithProgressWindow("Loading " + configFile.getFileName() + "...",
+                                       true /* progress bar */,
+                                       true /* cancel button */),
+        m_configFile(configFile),
+        m_cancelled(false)
+{
+}
+
+ConfigFileLoader::~ConfigFileLoader()
+{
+}
+
+const juce::File& ConfigFileLoader::GetConfigFile() const
+{
+    return m_configFile;
+}
+
+std::vector<juce::ValueTree> ConfigFileLoader::TakeCommands()
+{
+    jassert(!isThreadRunning());
+    return std::move(m_commands);
+}
+
+juce::ValueTree ConfigFileLoader::ReadConfigFile(const juce::File& configFile)
+{
+    AES70_TRACE_SCOPE("ConfigFileLoader::ReadConfigFile");
+
+    if (!configFile.existsAsFile())
+        return {};
+
+    if (BinaryProjectFile::IsBinaryProjectFile(configFile))
+        return BinaryProjectFile::Read(configFile);
+
+    auto rootXmlElement = parseXMLIfTagMatches(configFile, CommandModel::CommandSetType.toString());
+    if (!rootXmlElement)
+        return {};
+
+    return juce::ValueTree::fromXml(*rootXmlElement);
+}
+
+bool ConfigFileLoader::WasCancelled() const
+{
+    return m_cancelled;
+}
+
+void ConfigFileLoader::run()
+{
+    m_commands.clear();
+
+    // Reading cannot report its progress, so show an indeterminate progress bar meanwhile.
+    setProgress(-1.0);
+    setStatusMessage("Reading file...");
+    auto commandSet = ReadConfigFile(m_configFile);
+    if (!commandSet.isValid() || threadShouldExit())
+        return;
+
+    setStatusMessage("Reading commands...");
+    int numChildren = commandSet.getNumChildren();
+    m_commands.reserve(static_cast<size_t>(numChildren));
+    for (int childIdx = 0; childIdx < numChildren; childIdx++)
+    {
+        if (threadShouldExit())
+        {
+            m_commands.clear();
+            return;
+        }
+
+        auto command = commandSet.getChild(childIdx);
+        if (command.hasType(CommandModel::CommandType))
+            m_commands.push_back(command);
+
+        setProgress(static_cast<double>(childIdx + 1) / numChildren);
+    }
+
+    // Detach the commands, so that they can be added to the CommandModel of the MainTabbedComponent.
+    commandSet.removeAllChildren(nullptr);
+}
+
+void ConfigFileLoader::threadComplete(bool userPressedCancel)
+{
+    m_cancelled = userPressedCancel;
+
+    bool success = !userPressedCancel && !m_commands.empty();
+    if (!success)
+        m_commands.clear();
+
+    if (OnLoadFinished)
+        OnLoadFinished(success);
+}
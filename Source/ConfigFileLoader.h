@@ -0,0 +1,98 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+
+/**
+ * Reads and parses a config file on a background thread, while showing a progress window
+ * which allows the user to cancel the operation. The result is a list of CommandModel nodes, 
+ * one for each StringGeneratorPage to create, which can be taken over once loading has finished.
+ */
+class ConfigFileLoader : public juce::ThreadWithProgressWindow
+{
+public:
+    ConfigFileLoader(const juce::File& configFile);
+    ~ConfigFileLoader() override;
+
+    /**
+     * Get the config file being loaded.
+     *
+     * @return  The config file passed on construction.
+     */
+    const juce::File& GetConfigFile() const;
+
+    /**
+     * Take over the command nodes read from the config file.
+     * Only to be called after loading has finished successfully.
+     *
+     * @return  List of CommandModel::CommandType nodes without parent, in the order in which they appear in the file.
+     */
+    std::vector<juce::ValueTree> TakeCommands();
+
+    /**
+     * Read a config file, either in XML or in the binary project format, into a CommandModel root node.
+     *
+     * @param[in] configFile    File to read.
+     * @return  The CommandModel::CommandSetType root node, or an invalid ValueTree if the file could not be read.
+     */
+    static juce::ValueTree ReadConfigFile(const juce::File& configFile);
+
+    /**
+     * Check whether loading was cancelled by the user.
+     *
+     * @return  True if the user pressed the progress window's cancel button.
+     */
+    bool WasCancelled() const;
+
+    /**
+     * Callback method that is triggered on the message thread once loading has finished.
+     *
+     * @param[in] success   True if the file was read and contains at least one command.
+     *                      False if loading failed or was cancelled by the user.
+     */
+    std::function<void(bool success)> OnLoadFinished;
+
+
+    // Reimplemented from juce::ThreadWithProgressWindow
+
+    void run() override;
+    void threadComplete(bool userPressedCancel) override;
+
+
+private:
+    // The config file to load.
+    juce::File m_configFile;
+
+    // Command nodes read from the config file.
+    std::vector<juce::ValueTree> m_commands;
+
+    // True if the user cancelled loading.
+    bool m_cancelled;
+
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ConfigFileLoader)
+};
@@ -0,0 +1,132 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#include "ConfigFileWriter.h"
+#include "BinaryProjectFile.h"
+#include "CommandModel.h"
+#include "Trace.h"
+
+
+static constexpr size_t ConfigFileWriterBufferSize = 65536; // Size of the output stream buffer in bytes.
+
+
+//==============================================================================
+// Class ConfigFileWriter
+//==============================================================================
+
+ConfigFileWriter::ConfigFileWriter(const juce::File& configFile, CommandModel::CommandProperties commands)
+    :   juce::Thread("ConfigFileWriter"),
+        m_configFile(configFile),
+        m_version(JUCEApplicationBase::getInstance()->getApplicationVersion()),
+        m_date(Time::getCurrentTime().formatted("%d.%m.%Y")),
+        m_commands(std::move(commands)),
+        m_success(false)
+{
+}
+
+ConfigFileWriter::~ConfigFileWriter()
+{
+    stopThread(5000);
+    cancelPendingUpdate();
+}
+
+const juce::File& ConfigFileWriter::GetConfigFile() const
+{
+    return m_configFile;
+}
+
+void ConfigFileWriter::run()
+{
+    AES70_TRACE_SCOPE("ConfigFileWriter::run");
+
+    m_success = false;
+
+    // Write to a temporary file next to the target, which is renamed on success.
+    // Otherwise the TemporaryFile destructor deletes it, leaving the target file untouched.
+    juce::TemporaryFile tempFile(m_configFile);
+    bool written(false);
+    {
+        juce::FileOutputStream stream(tempFile.getFile(), ConfigFileWriterBufferSize);
+        if (!stream.openedOk())
+        {
+            triggerAsyncUpdate();
+            return;
+        }
+
+        if (BinaryProjectFile::IsBinaryProjectFile(m_configFile))
+        {
+            written = BinaryProjectFile::Write(m_version, m_date, m_commands, stream);
+        }
+        else
+        {
+            written = WriteXml(m_version, m_date, m_commands, stream, this);
+        }
+
+        stream.flush();
+        written = written && stream.getStatus().wasOk();
+    }
+
+    m_commands.clear();
+    m_success = written && !threadShouldExit() && tempFile.overwriteTargetFileWithTemporary();
+
+    triggerAsyncUpdate();
+}
+
+void ConfigFileWriter::handleAsyncUpdate()
+{
+    if (OnWriteFinished)
+        OnWriteFinished(m_success);
+}
+
+bool ConfigFileWriter::WriteXml(const juce::String& version, 
+                                const juce::String& date, 
+                                const CommandModel::CommandProperties& commands, 
+                                juce::OutputStream& stream,
+                                juce::Thread* thread)
+{
+    // Only the root tag is written by hand. Each command is written by its XmlElement, 
+    // which takes care of escaping the attribute values.
+    auto childFormat = juce::XmlElement::TextFormat().singleLine().withoutHeader();
+
+    stream << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << juce::newLine << juce::newLine
+           << "<AES70CommandSet version=\"" << version << "\" date=\"" << date << "\">" << juce::newLine;
+
+    for (const auto& command : commands)
+    {
+        if (thread != nullptr && thread->threadShouldExit())
+            return false;
+
+        // Only one command exists as XML at a time, to keep memory usage constant.
+        juce::XmlElement commandElement(CommandModel::CommandType);
+        command.copyToXmlAttributes(commandElement);
+
+        stream << "  ";
+        commandElement.writeTo(stream, childFormat);
+        stream << juce::newLine;
+    }
+
+    stream << "</AES70CommandSet>" << juce::newLine;
+
+    return true;
+}
@@ -0,0 +1,108 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "CommandModel.h"
+
+
+/**
+ * Writes a config file on a background thread. The commands are passed in as a snapshot of their properties
+ * (See CommandModel::GetCommandProperties), which are written one by one to a buffered stream, so neither 
+ * a copy of the CommandModel nor an XML tree of the whole project is built in memory. The content is written to a temporary file first, which only replaces the 
+ * target file once writing has succeeded.
+ */
+class ConfigFileWriter : public juce::Thread,
+                         private juce::AsyncUpdater
+{
+public:
+    /**
+     * @param[in] configFile    File to write. Written in the binary project format if it 
+     *                          has the BinaryProjectFile::FileExtension, as XML otherwise.
+     * @param[in] commands      Properties of the commands to write, as taken by CommandModel::GetCommandProperties.
+     */
+    ConfigFileWriter(const juce::File& configFile, CommandModel::CommandProperties commands);
+    ~ConfigFileWriter() override;
+
+    /**
+     * Get the config file being written.
+     *
+     * @return  The config file passed on construction.
+     */
+    const juce::File& GetConfigFile() const;
+
+    /**
+     * Callback method that is triggered on the message thread once writing has finished.
+     *
+     * @param[in] success   True if the config file was written and replaced successfully.
+     */
+    std::function<void(bool success)> OnWriteFinished;
+
+    /**
+     * Write the root element and all commands of a command set as XML to the given stream.
+     * Each command is converted to XML only right before it is written.
+     *
+     * @param[in] version       Value of the root "version" attribute.
+     * @param[in] date          Value of the root "date" attribute.
+     * @param[in] commands      Properties of the commands to write, as taken by CommandModel::GetCommandProperties.
+     * @param[in] stream        Stream to write to.
+     * @param[in] thread        Optional thread whose threadShouldExit() aborts writing.
+     * @return  True if all elements were written, false if the thread was asked to exit.
+     */
+    static bool WriteXml(const juce::String& version, 
+                         const juce::String& date, 
+                         const CommandModel::CommandProperties& commands, 
+                         juce::OutputStream& stream,
+                         juce::Thread* thread = nullptr);
+
+
+    // Reimplemented from juce::Thread
+
+    void run() override;
+
+
+    // Reimplemented from juce::AsyncUpdater
+
+    void handleAsyncUpdate() override;
+
+
+private:
+    // The config file to write.
+    juce::File m_configFile;
+
+    // Values of the root "version" and "date" attributes. Determined on construction, on the message thread.
+    juce::String m_version;
+    juce::String m_date;
+
+    // Commands to write. Snapshot of the CommandModel, only accessed by the writing thread.
+    CommandModel::CommandProperties m_commands;
+
+    // Result of run(), passed to OnWriteFinished.
+    std::atomic<bool> m_success;
+
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ConfigFileWriter)
+};
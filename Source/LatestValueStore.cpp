@@ -0,0 +1,152 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#include "LatestValueStore.h"
+#include <cstring>
+
+
+static constexpr std::uint64_t KeyHashMultiplier = 0x9e3779b97f4a7c15ull; // Fibonacci hashing.
+
+
+//==============================================================================
+// Class LatestValueStore
+//==============================================================================
+
+LatestValueStore::LatestValueStore(int capacity)
+    :   m_mask(0),
+        m_numEntries(0)
+{
+    jassert(capacity > 0);
+    std::size_t numSlots(1);
+    while (numSlots < static_cast<std::size_t>(capacity))
+        numSlots <<= 1;
+
+    m_slots = std::make_unique<Slot[]>(numSlots);
+    m_mask = numSlots - 1;
+}
+
+LatestValueStore::~LatestValueStore()
+{
+}
+
+std::uint64_t LatestValueStore::MakeKey(std::uint32_t ono, std::uint16_t defLevel, std::uint16_t propIdx)
+{
+    return (std::uint64_t(ono) << 32) | (std::uint64_t(defLevel) << 16) | std::uint64_t(propIdx);
+}
+
+bool LatestValueStore::Write(std::uint64_t key, const std::uint8_t* data, std::size_t size)
+{
+    jassert(key != 0);
+    if (size > MaxValueSize)
+        return false;
+
+    auto slot = FindSlot(key, true);
+    if (slot == nullptr)
+        return false;
+
+    // Mark the slot as being written, so that overlapping Reads are retried.
+    auto sequence = slot->m_sequence.load(std::memory_order_relaxed);
+    slot->m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::uint32_t words[Slot::NumWords] = {};
+    std::memcpy(words, data, size);
+    for (std::size_t i = 0; i < (size + sizeof(std::uint32_t) - 1) / sizeof(std::uint32_t); i++)
+        slot->m_words[i].store(words[i], std::memory_order_relaxed);
+    slot->m_size.store(static_cast<std::uint32_t>(size), std::memory_order_relaxed);
+    slot->m_updateCount.store(slot->m_updateCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    slot->m_sequence.store(sequence + 2, std::memory_order_release);
+
+    return true;
+}
+
+bool LatestValueStore::Read(std::uint64_t key, std::uint8_t* data, std::size_t& size, std::uint32_t& updateCount) const
+{
+    auto slot = FindSlot(key, false);
+    if (slot == nullptr)
+        return false;
+
+    std::uint32_t words[Slot::NumWords];
+    std::uint32_t sequence(0);
+    do
+    {
+        // Wait for any ongoing Write to finish. Writes are short, so this rarely spins.
+        sequence = slot->m_sequence.load(std::memory_order_acquire);
+        if ((sequence & 1) != 0)
+            continue;
+
+        size = slot->m_size.load(std::memory_order_relaxed);
+        updateCount = slot->m_updateCount.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < Slot::NumWords; i++)
+            words[i] = slot->m_words[i].load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } 
+    while (((sequence & 1) != 0) || (slot->m_sequence.load(std::memory_order_relaxed) != sequence));
+
+    // The slot's key is published before its first value, so it might not have a value yet.
+    if (updateCount == 0)
+        return false;
+
+    std::memcpy(data, words, size);
+    return true;
+}
+
+int LatestValueStore::GetNumEntries() const
+{
+    return m_numEntries.load(std::memory_order_relaxed);
+}
+
+LatestValueStore::Slot* LatestValueStore::FindSlot(std::uint64_t key, bool insert) const
+{
+    // Linear probing from the hashed position. Keys are never removed, so an empty slot ends the search.
+    auto index = static_cast<std::size_t>((key * KeyHashMultiplier) >> 32) & m_mask;
+    for (std::size_t i = 0; i <= m_mask; i++)
+    {
+        auto& slot = m_slots[(index + i) & m_mask];
+        auto slotKey = slot.m_key.load(std::memory_order_acquire);
+        if (slotKey == key)
+            return &slot;
+
+        if (slotKey == 0)
+        {
+            if (!insert)
+                return nullptr;
+
+            std::uint64_t emptyKey(0);
+            if (slot.m_key.compare_exchange_strong(emptyKey, key, std::memory_order_acq_rel))
+            {
+                m_numEntries.fetch_add(1, std::memory_order_relaxed);
+                return &slot;
+            }
+
+            // Another thread claimed the slot in the meantime, maybe for the same key.
+            if (emptyKey == key)
+                return &slot;
+        }
+    }
+
+    return nullptr;
+}
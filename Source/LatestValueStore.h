@@ -0,0 +1,131 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+
+
+/**
+ * Fixed-capacity store of the latest value received for each property of each object, 
+ * i.e. the readings of subscribed sensors. Entries are keyed by ONo, definition level and property index 
+ * (See MakeKey), and are never removed, so that no memory is allocated once the store has been created.
+ *
+ * The store is lock-free: entries are inserted into an open-addressing hash table by compare-and-swap 
+ * of their key, and each entry's value is protected by a sequence counter instead of a lock. 
+ * Write is meant to be called from a single ingesting thread, while Read can be called from any thread, 
+ * i.e. by the GUI at its own frame rate, without ever blocking the ingesting thread.
+ */
+class LatestValueStore
+{
+public:
+    /**
+     * Largest value, in bytes, that can be stored. Large enough for all numeric data types
+     * and short strings. Larger values are rejected by Write.
+     */
+    static constexpr std::size_t MaxValueSize = 32;
+
+    /**
+     * @param[in] capacity  Maximum number of entries. Rounded up to the next power of two.
+     */
+    explicit LatestValueStore(int capacity = 4096);
+    ~LatestValueStore();
+
+    /**
+     * Compose the key of an entry.
+     *
+     * @param[in] ono       ONo of the object.
+     * @param[in] defLevel  Definition level of the property.
+     * @param[in] propIdx   Index of the property.
+     * @return  The key. Never zero for valid property definition levels.
+     */
+    static std::uint64_t MakeKey(std::uint32_t ono, std::uint16_t defLevel, std::uint16_t propIdx);
+
+    /**
+     * Set the latest value of an entry, inserting the entry if it does not exist yet.
+     * Must only be called from one thread at a time.
+     *
+     * @param[in] key   Key of the entry (See MakeKey).
+     * @param[in] data  Pointer to the value as marshalled OCP.1 data.
+     * @param[in] size  Size of the value in bytes.
+     * @return  False if the value is larger than MaxValueSize, or the store is full.
+     */
+    bool Write(std::uint64_t key, const std::uint8_t* data, std::size_t size);
+
+    /**
+     * Get the latest value of an entry. Can be called from any thread.
+     *
+     * @param[in] key           Key of the entry (See MakeKey).
+     * @param[out] data         Buffer of at least MaxValueSize bytes receiving the value.
+     * @param[out] size         Size of the value in bytes.
+     * @param[out] updateCount  Number of times the value was written so far. Can be compared with
+     *                          the count of a previous Read, to find out whether the value changed since.
+     * @return  False if no value has been written for the key yet.
+     */
+    bool Read(std::uint64_t key, std::uint8_t* data, std::size_t& size, std::uint32_t& updateCount) const;
+
+    /**
+     * Get the number of entries in the store.
+     *
+     * @return  Number of different keys written so far.
+     */
+    int GetNumEntries() const;
+
+private:
+    /**
+     * One entry of the hash table. The value is held in atomic words, so that a Read overlapping
+     * a Write is well-defined. Such a Read is detected by the sequence counter and retried.
+     */
+    struct Slot
+    {
+        static constexpr std::size_t NumWords = MaxValueSize / sizeof(std::uint32_t);
+
+        std::atomic<std::uint64_t> m_key{ 0 };           // Zero while the slot is empty.
+        std::atomic<std::uint32_t> m_sequence{ 0 };      // Odd while a Write is ongoing.
+        std::atomic<std::uint32_t> m_updateCount{ 0 };
+        std::atomic<std::uint32_t> m_size{ 0 };
+        std::atomic<std::uint32_t> m_words[NumWords]{};
+    };
+
+    /**
+     * Find the slot of the given key.
+     *
+     * @param[in] key       Key of the entry.
+     * @param[in] insert    True to claim an empty slot for the key if it does not exist yet.
+     * @return  The slot, or nullptr if the key does not exist (and could not be inserted).
+     */
+    Slot* FindSlot(std::uint64_t key, bool insert) const;
+
+    // Hash table with a power of two number of slots.
+    std::unique_ptr<Slot[]> m_slots;
+    std::size_t m_mask;
+
+    // Number of slots in use.
+    mutable std::atomic<int> m_numEntries;
+
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LatestValueStore)
+};
@@ -24,6 +24,8 @@
 
 #include <JuceHeader.h>
 #include "MainTabbedComponent.h"
+#include "AES70Schema.h"
+#include "Trace.h"
 
 class AES70_OCP1_StringGeneratorApplication  : public juce::JUCEApplication
 {
@@ -36,6 +38,23 @@ public:
 
     void initialise (const juce::String& /*commandLine*/) override
     {
+        juce::ArgumentList argList("executable", JUCEApplicationBase::getCommandLineParameterArray());
+
+#if AES70_ENABLE_TRACING
+        // Check if a file to write the recorded trace events to on exit was given via the commandline.
+        if (argList.containsOption("-t"))
+            m_traceFile = argList.getFileForOption("-t");
+#endif
+
+        // Check if a schema file with proprietary AES70 classes was given via the commandline.
+        // It must be loaded before any page is created (See AES70::Schema).
+        if (argList.containsOption("-s"))
+        {
+            juce::String errorMessage;
+            if (!AES70::Schema::GetInstance().LoadFromFile(argList.getFileForOption("-s"), errorMessage))
+                juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Schema not loaded", errorMessage);
+        }
+
         m_mainWindow.reset(new MainWindow());
 
         // Create and initialize the tabs in the mainWindow's TabbedComponent.
@@ -45,6 +64,11 @@ public:
     void shutdown() override
     {
         m_mainWindow = nullptr;
+
+#if AES70_ENABLE_TRACING
+        if (m_traceFile != juce::File())
+            Trace::WriteChromeJson(m_traceFile);
+#endif
     }
 
     void systemRequestedQuit() override
@@ -97,8 +121,23 @@ public:
             if (argList.containsOption("-o"))
                 configFile = argList.getFileForOption("-o");
 
-            // Create tabs and pages (using the config file if available).
             auto mainComponent = static_cast<MainTabbedComponent*>(getContentComponent());
+
+            // Check if a timeout (in seconds) for releasing the GUI controls of hidden pages was given via the commandline.
+            if (argList.containsOption("-r"))
+                mainComponent->SetPageReleaseTimeout(argList.getValueForOption("-r").getIntValue() * 1000);
+
+            // Check if a port for exporting metrics via HTTP on the loopback interface was given via the commandline.
+            if (argList.containsOption("-m"))
+            {
+                auto port = argList.getValueForOption("-m").getIntValue();
+                if (!mainComponent->StartMetricsServer(port))
+                    juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Metrics not exported",
+                                                           "Could not listen on port " + juce::String(port) + 
+                                                           " of the loopback interface. The port might be invalid or already in use.");
+            }
+
+            // Create tabs and pages (using the config file if available).
             bool parsedFile = mainComponent->InitializePages(configFile);
 
             // Set the app window name. If successfully opened, add the name of the config file.
@@ -114,6 +153,11 @@ public:
 
 private:
     std::unique_ptr<MainWindow> m_mainWindow;
+
+#if AES70_ENABLE_TRACING
+    // File to write the recorded trace events to on exit. See Trace::WriteChromeJson.
+    juce::File m_traceFile;
+#endif
 };
 
 // This macro generates the main() routine that launches the app.
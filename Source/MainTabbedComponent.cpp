@@ -23,23 +23,54 @@
 */
 
 #include "MainTabbedComponent.h"
+#include "AES70Codec.h"
 #include "TestPage.h"
 #include "StringGeneratorPage.h"
+#include "CommandTablePage.h"
+#include "MonitorPage.h"
+#include "LatestValueStore.h"
+#include "SubscriptionManager.h"
+#include "ObjectTreeWalker.h"
+#include "CommandModel.h"
+#include "CommandIndex.h"
+#include "ConfigFileLoader.h"
+#include "ConfigFileWriter.h"
+#include "BinaryProjectFile.h"
+#include "Metrics.h"
+#include "MetricsServer.h"
+#include "Trace.h"
 #include "Common.h"
 #include <NanoOcp1.h>
+#include <set>
 
 
 static const juce::String TestPageDefaultName("Test"); // Default name to show on the page's tab.
+static const juce::String CommandTablePageName("Commands"); // Name to show on the CommandTablePage's tab.
+static const juce::String MonitorPageName("Monitor"); // Name to show on the MonitorPage's tab.
 static constexpr int TestPageTabIndex(0); // TestPage will always be the leftmost tab.
+static constexpr int CommandTablePageTabIndex(1); // CommandTablePage will always be the second tab.
+static constexpr int MonitorPageTabIndex(2); // MonitorPage will always be the third tab.
+static constexpr int FirstPageTabIndex(3); // Index of the first StringGeneratorPage tab.
+static constexpr int PagesAttachedPerChunk(50); // Number of loaded pages attached per message loop iteration.
 
 
 MainTabbedComponent::MainTabbedComponent()
     :   juce::TabbedComponent(juce::TabbedButtonBar::TabsAtTop),
-        m_numUnreadMessages(0)
+        m_numUnreadMessages(0),
+        m_pageReleaseTimeout(PageReleaseTimeoutDefault),
+        m_commandModel(CommandModel::CommandSetType),
+        m_commandIndex(std::make_unique<CommandIndex>(m_commandModel)),
+        m_latestValueStore(std::make_unique<LatestValueStore>()),
+        m_responseDispatcher(std::make_unique<ResponseDispatcher>([this](const juce::MemoryBlock& data) { return SendCommandToDevice(data); })),
+        m_subscriptionManager(std::make_unique<SubscriptionManager>([this](const juce::MemoryBlock& data) { return SendCommandToDevice(data); })),
+        m_objectTreeWalker(std::make_unique<ObjectTreeWalker>([this](const juce::MemoryBlock& data) { return SendCommandToDevice(data); }))
 {
     // Initialize the NanoOcp1::NanoOcp1Client m_nanoOcp1Client. 
     StartNanoOcpClient();
 
+    // Periodically check for hidden pages whose GUI controls can be released.
+    startTimer(PageReleaseCheckInterval);
+
     // Resize the MainTabbedComponent taking into account the height of the TabBar itself. 
     // TODO: get rid of magic numbers.
     setSize(AppWindowDefaultWidth + 3, AppWindowDefaultHeight + getTabBarDepth() + 2);
@@ -47,27 +78,42 @@ MainTabbedComponent::MainTabbedComponent()
 
 MainTabbedComponent::~MainTabbedComponent()
 {
+    // Leave no subscriptions behind on the device.
+    m_subscriptionManager->RemoveAll();
+
+    stopTimer();
+    cancelPendingUpdate();
+    m_metricsServer.reset();
+
+    // Delete the pages while the CommandModel still exists.
+    clearTabs();
 }
 
 bool MainTabbedComponent::LoadFileViaDialog()
 {
     m_fileChooser.reset(new juce::FileChooser("Select config file to LOAD...", 
                                               File::getCurrentWorkingDirectory(), 
-                                              "*.xml",
+                                              "*.xml;*" + BinaryProjectFile::FileExtension,
                                               true /* use native */));
 
     auto fileChooserFlags = juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles;
     m_fileChooser->launchAsync(fileChooserFlags, [this](const juce::FileChooser& chooser)
         {
             juce::File configFile = chooser.getResult();
-            if (configFile != juce::File())
-            {
-                // First need to remove all current tabs.
-                clearTabs();
+            if (configFile == juce::File())
+                return;
 
-                // Create tabs on a blank slate, based on the contents of the file.
-                InitializePages(configFile);
-            }
+            // Ignore the request while a previous load is still ongoing.
+            if ((m_configFileLoader && m_configFileLoader->isThreadRunning()) || !m_pendingCommands.empty())
+                return;
+
+            // Parse the file in the background. Current tabs remain untouched until that succeeds.
+            m_configFileLoader = std::make_unique<ConfigFileLoader>(configFile);
+            m_configFileLoader->OnLoadFinished = [this](bool success)
+                {
+                    OnConfigFileLoaded(success);
+                };
+            m_configFileLoader->launchThread();
         });
 
     return true;
@@ -77,7 +123,7 @@ bool MainTabbedComponent::SaveFileViaDialog()
 {
     m_fileChooser.reset(new juce::FileChooser("Select config file to SAVE to...",
                                               File::getCurrentWorkingDirectory(),
-                                              "*.xml",
+                                              "*.xml;*" + BinaryProjectFile::FileExtension,
                                               true /* use native */));
 
     auto fileChooserFlags = juce::FileBrowserComponent::saveMode | 
@@ -97,7 +143,37 @@ bool MainTabbedComponent::SaveFileViaDialog()
 
 bool MainTabbedComponent::InitializePages(const juce::File& configFile)
 {
-    // First tab is always the "Test" tab
+    // First tab is always the "Test" tab, followed by the "Commands" and "Monitor" tabs.
+    CreateTestPageTab();
+    CreateCommandTablePageTab();
+    CreateMonitorPageTab();
+
+    // Attempt to load tabs and pages from the passed config file.
+    bool parsedConfigFromFile(false);
+    if (configFile.getFullPathName().isNotEmpty())
+    {
+        parsedConfigFromFile = CreatePagesFromConfigFile(configFile);
+    }
+
+    if (!parsedConfigFromFile)
+    {
+        // Add one StringGeneratorPage tab per default.
+        auto genPage = new StringGeneratorPage(this);
+        genPage->setName("Page " + juce::String(m_commandModel.getNumChildren()));
+        addTab(genPage->getName(), AppBackgroundColour, genPage, true);
+    }
+
+    // Last tab is always the "+" tab
+    CreatePlusTab();
+
+    // Set the first StringGeneratorPage tab as the active one per default
+    setCurrentTabIndex(FirstPageTabIndex);
+
+    return parsedConfigFromFile;
+}
+
+void MainTabbedComponent::CreateTestPageTab()
+{
     auto testPage = new TestPage(this);
     testPage->UpdateConnectionStatus(ConnectionStatus::Offline);
     addTab(TestPageDefaultName, AppBackgroundColour, testPage, true);
@@ -112,51 +188,109 @@ bool MainTabbedComponent::InitializePages(const juce::File& configFile)
                 m_nanoOcp1Client->start();
             }
         };
+}
 
-    // Attempt to load tabs and pages from the passed config file.
-    bool parsedConfigFromFile(false);
-    if (configFile.getFullPathName().isNotEmpty())
-    {
-        parsedConfigFromFile = CreatePagesFromConfigFile(configFile);
-    }
+void MainTabbedComponent::CreateCommandTablePageTab()
+{
+    auto commandTablePage = new CommandTablePage(this);
+    commandTablePage->UpdateConnectionStatus(GetConnectionStatus());
+    addTab(CommandTablePageName, AppBackgroundColour, commandTablePage, true);
+}
 
-    if (!parsedConfigFromFile)
-    {
-        // Add one StringGeneratorPage tab per default.
-        auto genPage = new StringGeneratorPage(this);
-        genPage->setName("Page " + juce::String(getNumTabs()));
-        addTab(genPage->getName(), AppBackgroundColour, genPage, true);
-    }
+void MainTabbedComponent::CreateMonitorPageTab()
+{
+    auto monitorPage = new MonitorPage(this);
+    monitorPage->UpdateConnectionStatus(GetConnectionStatus());
+    addTab(MonitorPageName, AppBackgroundColour, monitorPage, true);
+    jassert(getNumTabs() == MonitorPageTabIndex + 1);
+}
 
-    // Last tab is always the "+" tab
+void MainTabbedComponent::CreatePlusTab()
+{
     addTab("+", AppBackgroundColour, new DummyPage(this), true);
     getTabbedButtonBar().getTabButton(getNumTabs() - 1)->onClick = [=]()
         {
             // Clicking on the "+" tab will add a new StringGeneratorPage tab.
             auto genPage = new StringGeneratorPage(this);
             int newTabNumber = getNumTabs() - 1;
-            genPage->setName("Page " + juce::String(newTabNumber));
+            genPage->setName("Page " + juce::String(m_commandModel.getNumChildren()));
 
             // Ensure that the "+" tab remains as the rightmost tab.
             addTab(genPage->getName(), AppBackgroundColour, genPage, true, newTabNumber);
             setCurrentTabIndex(newTabNumber);
         };
+}
 
-    // Set the first StringGeneratorPage tab as the active one per default
-    setCurrentTabIndex(1);
+void MainTabbedComponent::OnConfigFileLoaded(bool success)
+{
+    if (!success)
+    {
+        // Keep the current tabs. Only complain if the user did not cancel on purpose.
+        if (m_configFileLoader && !m_configFileLoader->WasCancelled())
+            juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Load failed",
+                "Could not load any AES70 commands from " + m_configFileLoader->GetConfigFile().getFileName() + ".");
+        return;
+    }
 
-    return parsedConfigFromFile;
+    for (auto& command : m_configFileLoader->TakeCommands())
+        m_pendingCommands.push_back(command);
+
+    // Create tabs on a blank slate. StringGeneratorPage tabs will follow in handleAsyncUpdate.
+    m_showFirstPageWhenAttached = true;
+    clearTabs();
+    m_commandModel.removeAllChildren(nullptr);
+    CreateTestPageTab();
+    CreateCommandTablePageTab();
+    CreateMonitorPageTab();
+    triggerAsyncUpdate();
 }
 
-bool MainTabbedComponent::SendCommandToDevice(const juce::MemoryBlock& data)
+bool MainTabbedComponent::SendCommandToDevice(const juce::MemoryBlock& data, StringGeneratorPage* sourcePage)
 {
+    AES70_TRACE_SCOPE("MainTabbedComponent::SendCommandToDevice");
+
+    // Pass the Response back to the page, unless the handle still awaits the Response to an earlier Command.
+    // Responses only carry the handle, so the earlier Command keeps it, and this one is sent without tracking.
+    AES70::CommandHeader command;
+    if ((sourcePage != nullptr) && AES70::GetCommandHeader(data.getData(), data.getSize(), command))
+    {
+        // Responses to handles of the internal range are passed to the object tree walk instead.
+        if (command.m_handle > AES70::LastUserHandle)
+        {
+            sourcePage->ShowReadBackMessage("Handle " + juce::String(command.m_handle) + " is reserved");
+            return false;
+        }
+
+        if (!m_responseDispatcher->IsPending(command.m_handle))
+        {
+            juce::Component::SafePointer<StringGeneratorPage> page(sourcePage);
+            return SendRequestToDevice(data, [page, command](ResponseDispatcher::Outcome outcome, const AES70::ResponseView& response)
+                {
+                    if ((outcome == ResponseDispatcher::Outcome::Response) && (page != nullptr))
+                        page->ShowReadBackValue(command, response);
+                }) > 0;
+        }
+
+        sourcePage->ShowReadBackMessage("Handle " + juce::String(command.m_handle) + " still awaits a Response");
+    }
+
+    bool success(false);
     if (m_nanoOcp1Client && m_nanoOcp1Client->isConnected())
     {
         //m_nanoOcp1Client->sendMessage(commandMemBlock); TODO make method protected?? 
-        return m_nanoOcp1Client->sendData(data);
+        success = m_nanoOcp1Client->sendData(data);
     }
 
-    return false;
+    Metrics::GetInstance().AddSentMessage(data, success);
+
+    return success;
+}
+
+int MainTabbedComponent::SendRequestToDevice(const juce::MemoryBlock& data, 
+                                             ResponseDispatcher::ResponseCallback callback, 
+                                             int timeoutMs)
+{
+    return m_responseDispatcher->Send(data, std::move(callback), timeoutMs);
 }
 
 bool MainTabbedComponent::GetConnectionParameters(juce::String& address, int& port) const
@@ -180,6 +314,99 @@ ConnectionStatus MainTabbedComponent::GetConnectionStatus() const
     return ConnectionStatus::Offline;
 }
 
+void MainTabbedComponent::SetPageReleaseTimeout(int timeoutMs)
+{
+    m_pageReleaseTimeout = timeoutMs;
+}
+
+bool MainTabbedComponent::StartMetricsServer(int port)
+{
+    if (!m_metricsServer)
+        m_metricsServer = std::make_unique<MetricsServer>();
+
+    if (m_metricsServer->Start(port))
+        return true;
+
+    m_metricsServer.reset();
+    return false;
+}
+
+juce::ValueTree MainTabbedComponent::GetCommandModel() const
+{
+    return m_commandModel;
+}
+
+const CommandIndex& MainTabbedComponent::GetCommandIndex() const
+{
+    return *m_commandIndex;
+}
+
+const LatestValueStore& MainTabbedComponent::GetLatestValueStore() const
+{
+    return *m_latestValueStore;
+}
+
+SubscriptionManager& MainTabbedComponent::GetSubscriptionManager()
+{
+    return *m_subscriptionManager;
+}
+
+ResponseDispatcher& MainTabbedComponent::GetResponseDispatcher()
+{
+    return *m_responseDispatcher;
+}
+
+ObjectTreeWalker& MainTabbedComponent::GetObjectTreeWalker()
+{
+    return *m_objectTreeWalker;
+}
+
+int MainTabbedComponent::CreatePagesForDiscoveredObjects()
+{
+    // The "+" tab is only re-created once all pending pages are attached.
+    if (!m_pendingCommands.empty())
+        return 0;
+
+    std::set<std::uint32_t> addressedOnos;
+    for (const auto& command : m_commandModel)
+        addressedOnos.insert(static_cast<std::uint32_t>(command.getProperty(CommandModel::Ono).toString().getLargeIntValue()));
+
+    for (const auto& onoAndObject : m_objectTreeWalker->GetObjects())
+    {
+        const auto& object = onoAndObject.second;
+        if ((object.m_classIdx == 0) || (addressedOnos.count(object.m_ono) > 0))
+            continue;
+
+        auto command = CommandModel::CreateGetCommand(object.m_classIdx, object.m_ono);
+        if (command.isValid())
+            m_pendingCommands.push_back(command);
+    }
+
+    if (m_pendingCommands.empty())
+        return 0;
+
+    // Remove the "+" tab, which handleAsyncUpdate adds again after the new pages.
+    removeTab(getNumTabs() - 1);
+    triggerAsyncUpdate();
+
+    return static_cast<int>(m_pendingCommands.size());
+}
+
+bool MainTabbedComponent::ShowCommandPage(const juce::ValueTree& command)
+{
+    for (int tabIdx = FirstPageTabIndex; tabIdx < getNumTabs(); tabIdx++)
+    {
+        auto genPage = dynamic_cast<StringGeneratorPage*>(getTabContentComponent(tabIdx));
+        if (genPage && (genPage->GetState() == command))
+        {
+            setCurrentTabIndex(tabIdx);
+            return true;
+        }
+    }
+
+    return false;
+}
+
 TabBarButton* MainTabbedComponent::createTabButton(const String& tabName, int tabIndex)
 {
     // TODO: create custom TabBarButton components depending on the tabIndex
@@ -211,16 +438,96 @@ void MainTabbedComponent::resized()
     juce::TabbedComponent::resized();
 }
 
+void MainTabbedComponent::timerCallback()
+{
+    if (m_pageReleaseTimeout <= 0)
+        return;
+
+    // Release the GUI controls of all StringGeneratorPages which have not been shown for a while.
+    auto now = juce::Time::getMillisecondCounter();
+    for (int tabIdx = 0; tabIdx < getNumTabs(); tabIdx++)
+    {
+        if (tabIdx == getCurrentTabIndex())
+            continue;
+
+        auto genPage = dynamic_cast<StringGeneratorPage*>(getTabContentComponent(tabIdx));
+        if (genPage && genPage->IsMaterialized() && 
+            (now - genPage->GetLastVisibleTime() > static_cast<juce::uint32>(m_pageReleaseTimeout)))
+        {
+            genPage->Release();
+        }
+    }
+}
+
+void MainTabbedComponent::handleAsyncUpdate()
+{
+    AES70_TRACE_SCOPE("MainTabbedComponent::AttachPendingPages");
+
+    // Attach one chunk of the loaded pages, then yield to the message loop.
+    for (int count = 0; (count < PagesAttachedPerChunk) && !m_pendingCommands.empty(); count++)
+    {
+        auto page = StringGeneratorPage::CreatePageFromValueTree(m_pendingCommands.front(), this);
+        m_pendingCommands.pop_front();
+        if (page != nullptr)
+            addTab(page->getName(), AppBackgroundColour, page, true);
+    }
+
+    if (!m_pendingCommands.empty())
+    {
+        triggerAsyncUpdate();
+        return;
+    }
+
+    // Last tab is always the "+" tab
+    CreatePlusTab();
+
+    // Set the first StringGeneratorPage tab as the active one after loading a config file.
+    if (m_showFirstPageWhenAttached)
+    {
+        m_showFirstPageWhenAttached = false;
+        setCurrentTabIndex(FirstPageTabIndex);
+    }
+}
+
 void MainTabbedComponent::StartNanoOcpClient()
 {
     m_nanoOcp1Client = std::make_unique<NanoOcp1::NanoOcp1Client>("127.0.0.1", 50014);
     m_nanoOcp1Client->onDataReceived = [=](const juce::MemoryBlock& message)
     {
-        // Pass message to the TestPage tab for displaying.
+        AES70_TRACE_SCOPE("NanoOcp1Client::onDataReceived");
+        Metrics::GetInstance().AddReceivedMessage(message);
+
+        // Keep the latest value of each notified property. The MonitorPage picks them up at its own frame rate.
+        int numNotifications(0);
+        std::uint64_t notificationKey(0);
+        AES70::ForEachNotification(message.getData(), message.getSize(), [&](const AES70::NotificationView& notification)
+            {
+                notificationKey = LatestValueStore::MakeKey(notification.m_emitterOno, notification.m_propDefLevel, notification.m_propIndex);
+                m_latestValueStore->Write(notificationKey, notification.m_valueData, notification.m_valueDataSize);
+                numNotifications++;
+            });
+
+        // Pass message to the TestPage tab for displaying. PDUs with a single Notification are coalesced
+        // per property, so that subscriptions to fast-changing properties do not flood the inbox.
         auto testPage = static_cast<TestPage*>(getTabContentComponent(TestPageTabIndex));
-        if (testPage)
+        if (testPage && (numNotifications == 1))
+            testPage->AddNotification(notificationKey, message);
+        else if (testPage)
             testPage->AddMessage(message);
 
+        // Pass Responses to internally generated handles to the ongoing object tree walk, 
+        // and Responses to user-defined handles to the pending Commands they belong to.
+        if ((m_responseDispatcher->GetNumPendingRequests() > 0) || m_objectTreeWalker->IsAwaitingResponses())
+        {
+            AES70::ForEachResponse(message.getData(), message.getSize(), [this](const AES70::ResponseView& response)
+            {
+                if (response.m_handle >= AES70::FirstInternalHandle)
+                    m_objectTreeWalker->HandleResponse(response);
+                else
+                    m_responseDispatcher->HandleResponse(response);
+            });
+        }
+
 #if JUCE_DEBUG
         auto receivedStr = juce::String::toHexString(message.getData(), static_cast<int>(message.getSize()));
         DBG("onDataReceived: " + receivedStr);
@@ -243,6 +550,17 @@ void MainTabbedComponent::StartNanoOcpClient()
         {
             DBG("onConnectionEstablished");
 
+            auto& metrics = Metrics::GetInstance();
+            if (metrics.Get(Metrics::CONNECTIONS_ESTABLISHED) > 0)
+                metrics.Increment(Metrics::RECONNECTS);
+            metrics.Increment(Metrics::CONNECTIONS_ESTABLISHED);
+
+            // Re-establish all subscriptions, i.e. after the connection was lost due to a network glitch.
+            m_subscriptionManager->OnConnectionEstablished();
+
+            // Identify the device, to make its cached object tree available if it is known.
+            m_objectTreeWalker->OnConnectionEstablished();
+
             for (int tabIdx = 0; tabIdx < getNumTabs(); tabIdx++)
             {
                 // Pass connection status to each tab.
@@ -258,6 +576,11 @@ void MainTabbedComponent::StartNanoOcpClient()
         {
             DBG("onConnectionLost");
 
+            // Responses to Commands sent over the lost connection will not arrive anymore.
+            m_responseDispatcher->OnConnectionLost();
+            m_subscriptionManager->OnConnectionLost();
+            m_objectTreeWalker->OnConnectionLost();
+
             for (int tabIdx = 0; tabIdx < getNumTabs(); tabIdx++)
             {
                 // Pass connection status to each tab.
@@ -274,56 +597,46 @@ void MainTabbedComponent::StartNanoOcpClient()
 
 bool MainTabbedComponent::CreatePagesFromConfigFile(const juce::File& configFIle)
 {
-    if (configFIle.existsAsFile())
+    auto commandSet = ConfigFileLoader::ReadConfigFile(configFIle);
+    if (!commandSet.isValid())
+        return false;
+
+    // Detach the commands from the file's root node, so that the pages can add them to m_commandModel.
+    std::vector<juce::ValueTree> commands;
+    for (const auto& command : commandSet)
+        commands.push_back(command);
+    commandSet.removeAllChildren(nullptr);
+
+    bool atLeastOneAdded(false);
+    for (const auto& command : commands)
     {
-        auto rootXmlElement = parseXMLIfTagMatches(configFIle, "AES70CommandSet");
-        if (rootXmlElement)
+        // Create one StringGeneratorPage for each AES70Command.
+        auto page = StringGeneratorPage::CreatePageFromValueTree(command, this);
+        if (page != nullptr)
         {
-            bool atLeastOneAdded(false);
-
-            juce::String configVersion;
-            if (rootXmlElement->hasAttribute("version"))
-                configVersion = rootXmlElement->getStringAttribute("version");
-
-            auto childXmlElement = rootXmlElement->getChildByName("AES70Command");
-            while (childXmlElement)
-            {
-                // Create one StringGeneratorPage for each AES70Command.
-                auto page = StringGeneratorPage::CreatePageFromXmlElement(childXmlElement, this);
-                jassert(page != nullptr);
-                if (page != nullptr)
-                {
-                    // Add the StringGeneratorPage tab. Use the page's component name as tabName.
-                    addTab(page->getName(), AppBackgroundColour, page, true);
-                    atLeastOneAdded = true;
-                }
-
-                // Advance to next AES70Command tag.
-                childXmlElement = childXmlElement->getNextElementWithTagName("AES70Command");
-            }
-
-            if (atLeastOneAdded)
-                return true;
+            // Add the StringGeneratorPage tab. Use the page's component name as tabName.
+            addTab(page->getName(), AppBackgroundColour, page, true);
+            atLeastOneAdded = true;
         }
     }
 
-    return false;
+    return atLeastOneAdded;
 }
 
-bool MainTabbedComponent::CreateConfigFileFromPages(juce::File& configFile) const
+bool MainTabbedComponent::CreateConfigFileFromPages(const juce::File& configFile)
 {
-    XmlElement rootElement("AES70CommandSet");
-    rootElement.setAttribute("version", JUCEApplicationBase::getInstance()->getApplicationVersion());
-    rootElement.setAttribute("date", Time::getCurrentTime().formatted("%d.%m.%Y"));
+    if (m_configFileWriter && m_configFileWriter->isThreadRunning())
+        return false;
 
-    for (int tIdx = 0; tIdx < getNumTabs(); tIdx++)
-    {
-        auto genPage = dynamic_cast<StringGeneratorPage*>(getTabContentComponent(tIdx));
-        if (genPage)
+    // The writer gets a snapshot of the command properties only, so that the pages can be edited while writing.
+    m_configFileWriter = std::make_unique<ConfigFileWriter>(configFile, CommandModel::GetCommandProperties(m_commandModel));
+    m_configFileWriter->OnWriteFinished = [this](bool success)
         {
-            rootElement.addChildElement(genPage->CreateXmlElementFromPage());
-        }
-    }
+            if (!success)
+                juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Save failed",
+                    "Could not write " + m_configFileWriter->GetConfigFile().getFileName() + ".");
+        };
+    m_configFileWriter->startThread();
 
-    return rootElement.writeTo(configFile);
-}
\ No newline at end of file
+    return true;
+}
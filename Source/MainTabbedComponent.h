@@ -25,6 +25,9 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <deque>
+
+#include "ResponseDispatcher.h"
 
 
 /**
@@ -34,6 +37,14 @@ namespace NanoOcp1
 {
     class NanoOcp1Client;
 }
+class ConfigFileLoader;
+class ConfigFileWriter;
+class CommandIndex;
+class LatestValueStore;
+class SubscriptionManager;
+class ObjectTreeWalker;
+class MetricsServer;
+class StringGeneratorPage;
 
 /**
  * Status of the internal m_nanoOcp1Client
@@ -53,10 +64,13 @@ enum class ConnectionStatus
 
 /**
  * Custom juce::TabbedComponent, a component with a TabbedButtonBar along the top.
- * The first tab will always be a TestPage component, while the rest of the tabs 
- * will be StringGeneratorPage components.
+ * The first tab will always be a TestPage component, the second one a CommandTablePage, 
+ * and the third one a MonitorPage, while the rest of the tabs will be StringGeneratorPage components. The configuration of all
+ * StringGeneratorPages is held in a single CommandModel (See GetCommandModel).
  */
-class MainTabbedComponent : public juce::TabbedComponent
+class MainTabbedComponent : public juce::TabbedComponent,
+                            private juce::Timer,
+                            private juce::AsyncUpdater
 {
 public:
     MainTabbedComponent();
@@ -64,7 +78,8 @@ public:
 
     /**
      * Opens a dialog window to select a config file to load.
-     * This clears all current tabs, and creates new tabs based on the selected config file.
+     * The file is parsed on a background thread (See ConfigFileLoader). Only if that succeeds,
+     * all current tabs are cleared and new tabs are created based on the selected config file.
      */
     bool LoadFileViaDialog();
 
@@ -87,19 +102,37 @@ public:
 
     /**
      * Create a file containing the configuration of all pages under this TabbedComponent. 
+     * The file is written asynchronously on a background thread (See ConfigFileWriter).
      *
-     * @param[in] configFile    File which will be weitten with page configuration as XML.
-     * @return  True if the file could be written to.
+     * @param[in] configFile    File which will be weitten with page configuration as XML, or in the 
+     *                          binary project format if it has the BinaryProjectFile::FileExtension.
+     * @return  True if writing the file was started, false if a previous write is still ongoing.
      */
-    bool CreateConfigFileFromPages(juce::File& configFile) const;
+    bool CreateConfigFileFromPages(const juce::File& configFile);
 
     /**
      * Use m_nanoOcp1Client to send a given MemoryBlock to the connected remote device.
      * 
-     * @param[in] data  MemoryBlock to send.
+     * @param[in] data          MemoryBlock to send.
+     * @param[in] sourcePage    Optional page which generated the Command. The device's Response 
+     *                          to it is passed back to the page (See StringGeneratorPage::ShowReadBackValue).
      * @return  True if the message could be sent successfully.
      */
-    bool SendCommandToDevice(const juce::MemoryBlock& data);
+    bool SendCommandToDevice(const juce::MemoryBlock& data, StringGeneratorPage* sourcePage = nullptr);
+
+    /**
+     * Send a PDU of Commands requiring a Response to the connected remote device, and get called back 
+     * once per Command with its Response, or once it timed out, was cancelled or the connection was lost.
+     * 
+     * @param[in] data          PDU of Commands requiring a Response.
+     * @param[in] callback      Function called once per Command, on the message thread.
+     * @param[in] timeoutMs     Time after which a Command without Response is resolved with a timeout.
+     * @return  Number of Commands sent. Zero if the PDU could not be sent or one of its handles still awaits 
+     *          a Response (See ResponseDispatcher::Send), in which case the callback is never called.
+     */
+    int SendRequestToDevice(const juce::MemoryBlock& data, 
+                            ResponseDispatcher::ResponseCallback callback, 
+                            int timeoutMs = ResponseDispatcher::DefaultTimeoutMs);
 
     /**
      * Get the ip address and port currently used by m_nanoOcp1Client.
@@ -117,6 +150,82 @@ public:
      */
     ConnectionStatus GetConnectionStatus() const;
 
+    /**
+     * Set the time after which the GUI controls of StringGeneratorPages that are not shown are released, 
+     * to keep memory usage low when working with large config files. Released pages will re-create
+     * their GUI controls when they are shown again.
+     *
+     * @param[in] timeoutMs Time in milliseconds. Zero or negative to never release GUI controls.
+     */
+    void SetPageReleaseTimeout(int timeoutMs);
+
+    /**
+     * Start exporting the app's Metrics over HTTP on the loopback interface (See MetricsServer).
+     *
+     * @param[in] port  TCP port to listen on.
+     * @return  True if the port could be bound.
+     */
+    bool StartMetricsServer(int port);
+
+    /**
+     * Get the CommandModel holding the configuration of all StringGeneratorPages, in tab order.
+     *
+     * @return  The CommandModel::CommandSetType root node.
+     */
+    juce::ValueTree GetCommandModel() const;
+
+    /**
+     * Get the search index over all commands of the CommandModel.
+     *
+     * @return  The CommandIndex, which is kept up to date with the CommandModel.
+     */
+    const CommandIndex& GetCommandIndex() const;
+
+    /**
+     * Get the store holding the latest value of each property notified by the device.
+     *
+     * @return  The LatestValueStore, which is updated whenever Notifications are received.
+     */
+    const LatestValueStore& GetLatestValueStore() const;
+
+    /**
+     * Get the manager of all subscriptions to properties of the device.
+     *
+     * @return  The SubscriptionManager, which re-establishes its subscriptions whenever the connection is.
+     */
+    SubscriptionManager& GetSubscriptionManager();
+
+    /**
+     * Get the dispatcher resolving the Commands sent with SendRequestToDevice, i.e. to cancel them.
+     *
+     * @return  The ResponseDispatcher, which is passed all Responses while Commands are pending.
+     */
+    ResponseDispatcher& GetResponseDispatcher();
+
+    /**
+     * Get the walker discovering the objects of the device.
+     *
+     * @return  The ObjectTreeWalker, which is passed all Responses while a walk is ongoing.
+     */
+    ObjectTreeWalker& GetObjectTreeWalker();
+
+    /**
+     * Append a StringGeneratorPage for each object found by the ObjectTreeWalker, whose class is known 
+     * and which no page addresses yet (See CommandModel::CreateGetCommand). The pages are attached in chunks, 
+     * like those of a loaded config file.
+     *
+     * @return  Number of pages appended. Zero if pages of a config file are still being attached.
+     */
+    int CreatePagesForDiscoveredObjects();
+
+    /**
+     * Make the StringGeneratorPage tab holding the given command the current tab.
+     *
+     * @param[in] command   CommandModel::CommandType node of the page to show.
+     * @return  True if a page holding the command was found.
+     */
+    bool ShowCommandPage(const juce::ValueTree& command);
+
 
     // Reimplemented from juce::TabbedComponent
 
@@ -130,6 +239,16 @@ public:
     void resized() override;
 
 
+    // Reimplemented from juce::Timer
+
+    void timerCallback() override;
+
+
+    // Reimplemented from juce::AsyncUpdater
+
+    void handleAsyncUpdate() override;
+
+
 protected:
     /**
      * Initialize NanoOcp1Client, which will send and receive messages to & from the device
@@ -138,9 +257,37 @@ protected:
     void StartNanoOcpClient();
 
     /**
-     * Read the given file, parse the XML content, and create StringGeneratorPage tabs based on the file.
+     * Add the TestPage tab, which is always the leftmost tab.
+     */
+    void CreateTestPageTab();
+
+    /**
+     * Add the CommandTablePage tab, which is always the second tab from the left.
+     */
+    void CreateCommandTablePageTab();
+
+    /**
+     * Add the MonitorPage tab, which is always the third tab from the left.
+     */
+    void CreateMonitorPageTab();
+
+    /**
+     * Add the "+" tab, which is always the rightmost tab and adds a new StringGeneratorPage when clicked.
+     */
+    void CreatePlusTab();
+
+    /**
+     * Called once m_configFileLoader has finished. If successful, replaces all current tabs with
+     * the loaded ones. Pages are attached in chunks (See handleAsyncUpdate) to keep the GUI responsive.
+     *
+     * @param[in] success   True if the config file was loaded successfully.
+     */
+    void OnConfigFileLoaded(bool success);
+
+    /**
+     * Read the given file and create StringGeneratorPage tabs based on the file.
      * 
-     * @param[in] configFile        File containing a valid configuration as XML.
+     * @param[in] configFile        File containing a valid configuration as XML or as binary project file.
      * @return  True if the file could be parsed and at least one StringGeneratorPage was created.
      */
     bool CreatePagesFromConfigFile(const juce::File& configFile);
@@ -159,11 +306,73 @@ private:
      */
     int m_numUnreadMessages;
 
+    /**
+     * Time in milliseconds after which the GUI controls of hidden StringGeneratorPages are released.
+     * See SetPageReleaseTimeout.
+     */
+    int m_pageReleaseTimeout;
+
     /**
      * File open dialog.
      */
     std::unique_ptr<juce::FileChooser> m_fileChooser;
 
+    /**
+     * Background thread loading a config file, if any load is currently ongoing.
+     */
+    std::unique_ptr<ConfigFileLoader> m_configFileLoader;
+
+    /**
+     * Background thread writing a config file, if any save is currently ongoing.
+     */
+    std::unique_ptr<ConfigFileWriter> m_configFileWriter;
+
+    /**
+     * Configuration of all StringGeneratorPages. See GetCommandModel.
+     */
+    juce::ValueTree m_commandModel;
+
+    /**
+     * Search index over m_commandModel. See GetCommandIndex.
+     */
+    std::unique_ptr<CommandIndex> m_commandIndex;
+
+    /**
+     * Latest value of each notified property. See GetLatestValueStore.
+     */
+    std::unique_ptr<LatestValueStore> m_latestValueStore;
+
+    /**
+     * Commands awaiting their Response. See SendRequestToDevice.
+     */
+    std::unique_ptr<ResponseDispatcher> m_responseDispatcher;
+
+    /**
+     * Subscriptions to properties of the device. See GetSubscriptionManager.
+     */
+    std::unique_ptr<SubscriptionManager> m_subscriptionManager;
+
+    /**
+     * Discovery of the device's objects. See GetObjectTreeWalker.
+     */
+    std::unique_ptr<ObjectTreeWalker> m_objectTreeWalker;
+
+    /**
+     * Loaded command nodes whose StringGeneratorPage tabs have not yet been attached.
+     */
+    std::deque<juce::ValueTree> m_pendingCommands;
+
+    /**
+     * True if the pending pages were loaded from a config file, in which case the first of them is 
+     * shown once all are attached. Pages created for discovered objects leave the current tab as is.
+     */
+    bool m_showFirstPageWhenAttached = false;
+
+    /**
+     * HTTP server exporting the app's Metrics, if started. See StartMetricsServer.
+     */
+    std::unique_ptr<MetricsServer> m_metricsServer;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainTabbedComponent)
 };
 
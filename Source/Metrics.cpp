@@ -0,0 +1,212 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#include "Metrics.h"
+
+
+/**
+ * Description of a metric, as exported to JSON and Prometheus.
+ */
+struct MetricDescription
+{
+    const char* m_name;     // Prometheus metric name, also used as JSON property name if there is no label.
+    const char* m_label;    // Value of the "type" label, for metrics which share one name. Empty if none.
+    const char* m_help;     // Prometheus HELP text.
+    bool m_isGauge;         // True for gauges, false for counters.
+};
+
+/**
+ * Descriptions of all metrics, indexed by Metrics::MetricId.
+ */
+static const std::array<MetricDescription, Metrics::METRIC_MAX> MetricDescriptions = {{
+    /* PDUS_SENT                */ { "aes70_pdus_sent_total", "", "PDUs sent to the device.", false },
+    /* BYTES_SENT               */ { "aes70_bytes_sent_total", "", "Bytes sent to the device.", false },
+    /* SEND_FAILURES            */ { "aes70_send_failures_total", "", "PDUs which could not be sent.", false },
+    /* PDUS_RECEIVED            */ { "aes70_pdus_received_total", "", "PDUs received from the device.", false },
+    /* BYTES_RECEIVED           */ { "aes70_bytes_received_total", "", "Bytes received from the device.", false },
+    /* COMMANDS_RECEIVED        */ { "aes70_messages_received_total", "Command", "Received PDUs per OCP.1 message type.", false },
+    /* NOTIFICATIONS_RECEIVED   */ { "aes70_messages_received_total", "Notification", "", false },
+    /* RESPONSES_RECEIVED       */ { "aes70_messages_received_total", "Response", "", false },
+    /* KEEPALIVES_RECEIVED      */ { "aes70_messages_received_total", "KeepAlive", "", false },
+    /* UNKNOWN_RECEIVED         */ { "aes70_messages_received_total", "Unknown", "", false },
+    /* CONNECTIONS_ESTABLISHED  */ { "aes70_connections_established_total", "", "Connections established with the device.", false },
+    /* RECONNECTS               */ { "aes70_reconnects_total", "", "Connections re-established after a connection was lost.", false },
+    /* GENERATION_CALLS         */ { "aes70_generation_calls_total", "", "Generated sets of Command, Response and Notification strings.", false },
+    /* GENERATION_MICROSECONDS  */ { "aes70_generation_microseconds_total", "", "Time spent generating binary strings.", false },
+    /* INBOX_SIZE               */ { "aes70_inbox_size", "", "Messages shown in the inbox of the Test page.", true },
+    /* NOTIFICATIONS_COALESCED  */ { "aes70_notifications_coalesced_total", "", "Notifications replaced by a newer one for the same property before being shown.", false },
+    /* REQUESTS_IN_FLIGHT       */ { "aes70_requests_in_flight", "", "Commands awaiting their Response.", true },
+    /* REQUEST_TIMEOUTS         */ { "aes70_request_timeouts_total", "", "Commands whose Response was not received in time.", false },
+}};
+
+static constexpr int Ocp1HeaderMessageTypeOffset = 7; // Position of the message type within a PDU, after SyncVal, ProtocolVersion and MessageSize.
+
+
+//==============================================================================
+// Struct Metrics::ScopedGenerationTimer
+//==============================================================================
+
+Metrics::ScopedGenerationTimer::ScopedGenerationTimer()
+    :   m_startTicks(juce::Time::getHighResolutionTicks())
+{
+}
+
+Metrics::ScopedGenerationTimer::~ScopedGenerationTimer()
+{
+    auto elapsedSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - m_startTicks);
+
+    auto& metrics = Metrics::GetInstance();
+    metrics.Increment(GENERATION_CALLS);
+    metrics.Increment(GENERATION_MICROSECONDS, static_cast<juce::int64>(elapsedSeconds * 1e6));
+}
+
+
+//==============================================================================
+// Class Metrics
+//==============================================================================
+
+Metrics::Metrics()
+{
+    for (auto& value : m_values)
+        value.store(0);
+}
+
+Metrics& Metrics::GetInstance()
+{
+    static Metrics instance;
+    return instance;
+}
+
+void Metrics::Increment(MetricId id, juce::int64 amount)
+{
+    jassert(!MetricDescriptions.at(id).m_isGauge); // Use Set for gauges!
+    m_values.at(id).fetch_add(amount, std::memory_order_relaxed);
+}
+
+void Metrics::Set(MetricId id, juce::int64 value)
+{
+    jassert(MetricDescriptions.at(id).m_isGauge); // Use Increment for counters!
+    m_values.at(id).store(value, std::memory_order_relaxed);
+}
+
+juce::int64 Metrics::Get(MetricId id) const
+{
+    return m_values.at(id).load(std::memory_order_relaxed);
+}
+
+void Metrics::AddSentMessage(const juce::MemoryBlock& message, bool success)
+{
+    if (!success)
+    {
+        Increment(SEND_FAILURES);
+        return;
+    }
+
+    Increment(PDUS_SENT);
+    Increment(BYTES_SENT, static_cast<juce::int64>(message.getSize()));
+}
+
+void Metrics::AddReceivedMessage(const juce::MemoryBlock& message)
+{
+    Increment(PDUS_RECEIVED);
+    Increment(BYTES_RECEIVED, static_cast<juce::int64>(message.getSize()));
+
+    auto typeId = UNKNOWN_RECEIVED;
+    if (message.getSize() > Ocp1HeaderMessageTypeOffset)
+    {
+        switch (static_cast<std::uint8_t>(message[Ocp1HeaderMessageTypeOffset]))
+        {
+            case 0: // Command
+            case 1: // CommandResponseRequired
+                typeId = COMMANDS_RECEIVED;
+                break;
+            case 2:
+                typeId = NOTIFICATIONS_RECEIVED;
+                break;
+            case 3:
+                typeId = RESPONSES_RECEIVED;
+                break;
+            case 4:
+                typeId = KEEPALIVES_RECEIVED;
+                break;
+            default:
+                break;
+        }
+    }
+
+    Increment(typeId);
+}
+
+juce::String Metrics::ToSummaryString() const
+{
+    auto generationCalls = Get(GENERATION_CALLS);
+    auto averageGenerationUs = (generationCalls > 0) ? (Get(GENERATION_MICROSECONDS) / generationCalls) : 0;
+
+    return "Sent: " + juce::String(Get(PDUS_SENT)) + " (" + juce::File::descriptionOfSizeInBytes(Get(BYTES_SENT)) + ")"
+        + "   Received: " + juce::String(Get(PDUS_RECEIVED)) + " (" + juce::File::descriptionOfSizeInBytes(Get(BYTES_RECEIVED)) + ")"
+        + "   Send failures: " + juce::String(Get(SEND_FAILURES))
+        + "   Reconnects: " + juce::String(Get(RECONNECTS))
+        + "   Coalesced: " + juce::String(Get(NOTIFICATIONS_COALESCED))
+        + "   Timeouts: " + juce::String(Get(REQUEST_TIMEOUTS))
+        + "   Generated: " + juce::String(generationCalls) + " (avg. " + juce::String(averageGenerationUs) + " us)";
+}
+
+juce::String Metrics::ToJson() const
+{
+    auto rootObject = new juce::DynamicObject();
+    for (int id = 0; id < METRIC_MAX; id++)
+    {
+        const auto& description = MetricDescriptions.at(id);
+        juce::String name(description.m_name);
+        if (description.m_label[0] != 0)
+            name += "_" + juce::String(description.m_label).toLowerCase();
+
+        rootObject->setProperty(name, Get(static_cast<MetricId>(id)));
+    }
+
+    return juce::JSON::toString(juce::var(rootObject));
+}
+
+juce::String Metrics::ToPrometheusText() const
+{
+    juce::String ret;
+    for (int id = 0; id < METRIC_MAX; id++)
+    {
+        const auto& description = MetricDescriptions.at(id);
+
+        // Metrics sharing one name are listed consecutively, and only the first one has the HELP text.
+        if (description.m_help[0] != 0)
+        {
+            ret << "# HELP " << description.m_name << " " << description.m_help << "\n"
+                << "# TYPE " << description.m_name << (description.m_isGauge ? " gauge" : " counter") << "\n";
+        }
+
+        ret << description.m_name;
+        if (description.m_label[0] != 0)
+            ret << "{type=\"" << description.m_label << "\"}";
+        ret << " " << Get(static_cast<MetricId>(id)) << "\n";
+    }
+
+    return ret;
+}
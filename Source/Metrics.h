@@ -0,0 +1,152 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+
+/**
+ * Lightweight registry of counters and gauges describing what the app is doing internally,
+ * i.e. how many PDUs were sent and received, or how long generating binary strings takes.
+ * All values are atomics, so they can be updated from any thread without locking. 
+ * The registry can be exported as JSON, or as Prometheus text (See MetricsServer).
+ */
+class Metrics
+{
+public:
+    /**
+     * Ids of all metrics in the registry.
+     */
+    enum MetricId
+    {
+        PDUS_SENT = 0,
+        BYTES_SENT,
+        SEND_FAILURES,
+        PDUS_RECEIVED,
+        BYTES_RECEIVED,
+        COMMANDS_RECEIVED,
+        NOTIFICATIONS_RECEIVED,
+        RESPONSES_RECEIVED,
+        KEEPALIVES_RECEIVED,
+        UNKNOWN_RECEIVED,
+        CONNECTIONS_ESTABLISHED,
+        RECONNECTS,
+        GENERATION_CALLS,
+        GENERATION_MICROSECONDS,
+        INBOX_SIZE,
+        NOTIFICATIONS_COALESCED,
+        REQUESTS_IN_FLIGHT,
+        REQUEST_TIMEOUTS,
+        METRIC_MAX,
+    };
+
+    /**
+     * Measures the time from its construction until its destruction, 
+     * and adds it as one call to GENERATION_CALLS and GENERATION_MICROSECONDS.
+     */
+    struct ScopedGenerationTimer
+    {
+        ScopedGenerationTimer();
+        ~ScopedGenerationTimer();
+
+        juce::int64 m_startTicks;
+    };
+
+    /**
+     * Get the app-wide registry.
+     *
+     * @return  The single Metrics instance.
+     */
+    static Metrics& GetInstance();
+
+    /**
+     * Increment a counter.
+     *
+     * @param[in] id        Id of the counter.
+     * @param[in] amount    Amount to add.
+     */
+    void Increment(MetricId id, juce::int64 amount = 1);
+
+    /**
+     * Set the value of a gauge.
+     *
+     * @param[in] id    Id of the gauge.
+     * @param[in] value New value.
+     */
+    void Set(MetricId id, juce::int64 value);
+
+    /**
+     * Get the current value of a metric.
+     *
+     * @param[in] id    Id of the metric.
+     * @return  The current value.
+     */
+    juce::int64 Get(MetricId id) const;
+
+    /**
+     * Count a PDU that was passed to the connection for sending.
+     *
+     * @param[in] message   The PDU.
+     * @param[in] success   False if sending failed, in which case only SEND_FAILURES is incremented.
+     */
+    void AddSentMessage(const juce::MemoryBlock& message, bool success);
+
+    /**
+     * Count a PDU received from the connection, including the counter for its OCP.1 message type.
+     *
+     * @param[in] message   The PDU.
+     */
+    void AddReceivedMessage(const juce::MemoryBlock& message);
+
+    /**
+     * Create a single line summary of the most relevant metrics, for displaying on the GUI.
+     *
+     * @return  The summary text.
+     */
+    juce::String ToSummaryString() const;
+
+    /**
+     * Export all metrics as a JSON object, with one property per metric.
+     *
+     * @return  The JSON text.
+     */
+    juce::String ToJson() const;
+
+    /**
+     * Export all metrics in the Prometheus text exposition format.
+     *
+     * @return  The Prometheus text.
+     */
+    juce::String ToPrometheusText() const;
+
+private:
+    Metrics();
+
+    // Current values of all metrics, indexed by MetricId.
+    std::array<std::atomic<juce::int64>, METRIC_MAX> m_values;
+
+    // NOTE: No leak detector, as the single instance is only destroyed at static deinitialization.
+    JUCE_DECLARE_NON_COPYABLE(Metrics)
+};
@@ -0,0 +1,147 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#include "MetricsServer.h"
+#include "Metrics.h"
+
+
+static const juce::String MetricsServerAddress("127.0.0.1"); // Only the loopback interface is served.
+static constexpr int MetricsServerRequestTimeout = 1000; // Time in ms to wait for a client to send its request.
+static constexpr int MetricsServerMaxRequestSize = 4096; // Only the request line is evaluated, the rest is ignored.
+
+
+//==============================================================================
+// Class MetricsServer
+//==============================================================================
+
+MetricsServer::MetricsServer()
+    :   juce::Thread("MetricsServer")
+{
+}
+
+MetricsServer::~MetricsServer()
+{
+    Stop();
+}
+
+bool MetricsServer::Start(int port)
+{
+    Stop();
+
+    m_listener = std::make_unique<juce::StreamingSocket>();
+    if (!m_listener->createListener(port, MetricsServerAddress))
+    {
+        m_listener.reset();
+        return false;
+    }
+
+    startThread();
+    return true;
+}
+
+void MetricsServer::Stop()
+{
+    signalThreadShouldExit();
+
+    // Closing the socket releases the thread from waitForNextConnection.
+    if (m_listener)
+        m_listener->close();
+
+    stopThread(MetricsServerRequestTimeout * 2);
+    m_listener.reset();
+}
+
+void MetricsServer::run()
+{
+    while (!threadShouldExit())
+    {
+        std::unique_ptr<juce::StreamingSocket> connection(m_listener->waitForNextConnection());
+        if (connection == nullptr || threadShouldExit())
+            break;
+
+        HandleConnection(*connection);
+    }
+}
+
+void MetricsServer::HandleConnection(juce::StreamingSocket& connection)
+{
+    juce::HeapBlock<char> buffer(MetricsServerMaxRequestSize + 1, true);
+    int numBytesRead(0);
+
+    // Read until the end of the request line.
+    while (numBytesRead < MetricsServerMaxRequestSize && !threadShouldExit())
+    {
+        if (connection.waitUntilReady(true, MetricsServerRequestTimeout) != 1)
+            return;
+
+        auto numBytes = connection.read(buffer + numBytesRead, MetricsServerMaxRequestSize - numBytesRead, false);
+        if (numBytes <= 0)
+            return;
+
+        numBytesRead += numBytes;
+        if (juce::String(buffer.get(), static_cast<size_t>(numBytesRead)).contains("\r\n"))
+            break;
+    }
+
+    // Request line, i.e. "GET /metrics HTTP/1.1".
+    auto requestLine = juce::String(buffer.get(), static_cast<size_t>(numBytesRead)).upToFirstOccurrenceOf("\r\n", false, false);
+    auto tokens = juce::StringArray::fromTokens(requestLine, " ", "");
+    auto path = (tokens.size() >= 2) ? tokens[1].upToFirstOccurrenceOf("?", false, false) : juce::String();
+
+    juce::String status("200 OK");
+    juce::String contentType;
+    juce::String body;
+    if (tokens[0] != "GET")
+    {
+        status = "405 Method Not Allowed";
+        contentType = "text/plain";
+        body = "Only GET is supported.\n";
+    }
+    else if (path == "/metrics")
+    {
+        contentType = "text/plain; version=0.0.4";
+        body = Metrics::GetInstance().ToPrometheusText();
+    }
+    else if (path == "/metrics.json")
+    {
+        contentType = "application/json";
+        body = Metrics::GetInstance().ToJson();
+    }
+    else
+    {
+        status = "404 Not Found";
+        contentType = "text/plain";
+        body = "Available: /metrics, /metrics.json\n";
+    }
+
+    auto bodyUtf8 = body.toUTF8();
+    auto bodySize = static_cast<int>(bodyUtf8.sizeInBytes() - 1);
+    juce::String header = "HTTP/1.1 " + status + "\r\n"
+                          "Content-Type: " + contentType + "\r\n"
+                          "Content-Length: " + juce::String(bodySize) + "\r\n"
+                          "Connection: close\r\n\r\n";
+
+    connection.write(header.toRawUTF8(), static_cast<int>(header.getNumBytesAsUTF8()));
+    connection.write(bodyUtf8.getAddress(), bodySize);
+}
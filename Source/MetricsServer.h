@@ -0,0 +1,76 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+
+/**
+ * Minimal HTTP server which exports the Metrics registry on the loopback interface, 
+ * so that it can be inspected or scraped while the app runs unattended:
+ *  - GET /metrics        Prometheus text format.
+ *  - GET /metrics.json   JSON.
+ * Requests are served one at a time on a background thread.
+ */
+class MetricsServer : private juce::Thread
+{
+public:
+    MetricsServer();
+    ~MetricsServer() override;
+
+    /**
+     * Start listening on 127.0.0.1 with the given port. Stops listening on any previous port first.
+     *
+     * @param[in] port  TCP port to listen on.
+     * @return  True if the port could be bound.
+     */
+    bool Start(int port);
+
+    /**
+     * Stop listening and wait for the background thread to finish.
+     */
+    void Stop();
+
+
+    // Reimplemented from juce::Thread
+
+    void run() override;
+
+
+protected:
+    /**
+     * Read one HTTP request from the given connection, and write the response.
+     *
+     * @param[in] connection    Accepted client connection.
+     */
+    void HandleConnection(juce::StreamingSocket& connection);
+
+
+private:
+    // Socket listening for client connections.
+    std::unique_ptr<juce::StreamingSocket> m_listener;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MetricsServer)
+};
@@ -0,0 +1,419 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#include "MonitorPage.h"
+#include "CommandModel.h"
+#include "MainTabbedComponent.h"
+#include "LatestValueStore.h"
+#include "SubscriptionManager.h"
+#include "AES70Codec.h"
+#include "Common.h"
+
+
+/**
+ * Ids of the columns of the monitor table. NOTE: juce::TableHeaderComponent column ids must be non-zero.
+ */
+enum MonitorTableColumns
+{
+    COLUMN_PAGE = 1,
+    COLUMN_CLASS,
+    COLUMN_ONO,
+    COLUMN_PROPERTY,
+    COLUMN_VALUE,
+    COLUMN_UPDATES,
+    COLUMN_COALESCED,
+};
+
+static constexpr int MonitorTableRowHeight = 22;    // Height of each table row in pixels.
+static constexpr int MonitorFrameRateHz = 20;       // Rate at which the shown values are refreshed.
+
+
+//==============================================================================
+// Class MonitorPage
+//==============================================================================
+
+MonitorPage::MonitorPage(MainTabbedComponent* parent)
+    :   AbstractPage(parent),
+        m_commandModel(parent->GetCommandModel()),
+        m_summaryLabel(juce::Label("MonitorPage Summary")),
+        m_subscribeButton(juce::TextButton("Subscribe")),
+        m_unsubscribeButton(juce::TextButton("Unsubscribe")),
+        m_table(juce::TableListBox("MonitorTable")),
+        m_rowsChanged(true)
+{
+    jassert(parent != nullptr);
+
+    m_summaryLabel.setColour(juce::Label::textColourId, LabelEnabledTextColour);
+    m_summaryLabel.setJustificationType(juce::Justification::centredLeft);
+    addAndMakeVisible(&m_summaryLabel);
+
+    for (auto button : { &m_subscribeButton, &m_unsubscribeButton })
+    {
+        button->setClickingTogglesState(false);
+        button->setColour(juce::TextButton::ColourIds::buttonColourId, ButtonBackgroundColour);
+        button->setColour(juce::TextButton::ColourIds::textColourOffId, LabelEnabledTextColour);
+        button->setEnabled(false);
+        addAndMakeVisible(button);
+    }
+    m_subscribeButton.onClick = [=]()
+        {
+            SetAllSubscribed(true);
+        };
+    m_unsubscribeButton.onClick = [=]()
+        {
+            SetAllSubscribed(false);
+        };
+
+    auto columnFlags = juce::TableHeaderComponent::visible | juce::TableHeaderComponent::resizable;
+    auto& header = m_table.getHeader();
+    header.addColumn("Page", COLUMN_PAGE, 70, 30, -1, columnFlags);
+    header.addColumn("Class", COLUMN_CLASS, 130, 30, -1, columnFlags);
+    header.addColumn("ONo", COLUMN_ONO, 60, 30, -1, columnFlags);
+    header.addColumn("Property", COLUMN_PROPERTY, 120, 30, -1, columnFlags);
+    header.addColumn("Value", COLUMN_VALUE, 200, 30, -1, columnFlags);
+    header.addColumn("Updates", COLUMN_UPDATES, 70, 30, -1, columnFlags);
+    header.addColumn("Coalesced", COLUMN_COALESCED, 70, 30, -1, columnFlags);
+    header.setStretchToFitActive(true);
+
+    m_table.setColour(juce::ListBox::backgroundColourId, AppBackgroundColour);
+    m_table.setRowHeight(MonitorTableRowHeight);
+    m_table.setModel(this);
+    addAndMakeVisible(&m_table);
+
+    m_commandModel.addListener(this);
+    ScheduleRowsUpdate();
+
+    startTimerHz(MonitorFrameRateHz);
+
+    setSize(10, 10);
+}
+
+MonitorPage::~MonitorPage()
+{
+    stopTimer();
+    m_commandModel.removeListener(this);
+    m_table.setModel(nullptr);
+    cancelPendingUpdate();
+}
+
+void MonitorPage::UpdateConnectionStatus(ConnectionStatus status)
+{
+    m_subscribeButton.setEnabled(status == ConnectionStatus::Online);
+    m_unsubscribeButton.setEnabled(status == ConnectionStatus::Online);
+}
+
+void MonitorPage::paint(juce::Graphics& g)
+{
+    g.fillAll(AppBackgroundColour);
+}
+
+void MonitorPage::resized()
+{
+    auto bounds = getLocalBounds().reduced(4);
+    int margin = 2;
+    int controlHeight = 40;
+
+    auto rowBounds = bounds.removeFromTop(static_cast<int>(controlHeight * 0.75));
+    auto buttonWidth = rowBounds.getWidth() / 6;
+    m_unsubscribeButton.setBounds(rowBounds.removeFromRight(buttonWidth).reduced(margin));
+    m_subscribeButton.setBounds(rowBounds.removeFromRight(buttonWidth).reduced(margin));
+    m_summaryLabel.setBounds(rowBounds.reduced(margin));
+    m_table.setBounds(bounds.reduced(margin));
+
+    juce::Component::resized();
+}
+
+int MonitorPage::getNumRows()
+{
+    // Only changes in handleAsyncUpdate, together with the table's content.
+    return static_cast<int>(m_rows.size());
+}
+
+void MonitorPage::paintRowBackground(juce::Graphics& g, int rowNumber, int /*width*/, int /*height*/, bool rowIsSelected)
+{
+    if (rowIsSelected)
+        g.fillAll(LabelEnabledTextColour.withAlpha(0.35f));
+    else if ((rowNumber % 2) == 1)
+        g.fillAll(AppBackgroundColour.brighter(0.1f));
+}
+
+void MonitorPage::paintCell(juce::Graphics& g, int rowNumber, int columnId, int width, int height, bool /*rowIsSelected*/)
+{
+    g.setColour(LabelEnabledTextColour);
+    g.setFont(static_cast<float>(height) * 0.6f);
+    g.drawText(GetCellText(rowNumber, columnId), 2, 0, width - 4, height, juce::Justification::centredLeft, true);
+}
+
+void MonitorPage::cellDoubleClicked(int rowNumber, int /*columnId*/, const juce::MouseEvent& /*e*/)
+{
+    if ((rowNumber >= 0) && (rowNumber < static_cast<int>(m_rows.size())))
+        GetMainComponent()->ShowCommandPage(m_rows[static_cast<size_t>(rowNumber)].m_command);
+}
+
+void MonitorPage::valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property)
+{
+    if (tree.getParent() != m_commandModel)
+        return;
+
+    // Only the page name is shown as is, without affecting the subscribed property.
+    if (property == CommandModel::Name)
+    {
+        auto rowIter = std::find_if(m_rows.begin(), m_rows.end(), [&](const MonitoredProperty& row) { return row.m_command == tree; });
+        if (rowIter != m_rows.end())
+            m_table.repaintRow(static_cast<int>(std::distance(m_rows.begin(), rowIter)));
+        return;
+    }
+
+    // Values, handles, and the like are irrelevant. The definition levels and data type
+    // only need to be considered for custom classes, whose properties are entered freely.
+    if ((property != CommandModel::Class) && (property != CommandModel::Ono) && (property != CommandModel::Property) &&
+        (property != CommandModel::Command) && (property != CommandModel::PropDefLevel) && (property != CommandModel::Type))
+        return;
+
+    if (m_rowsChanged || (std::find(m_changedCommands.begin(), m_changedCommands.end(), tree) != m_changedCommands.end()))
+        return;
+
+    m_changedCommands.push_back(tree);
+    triggerAsyncUpdate();
+}
+
+void MonitorPage::valueTreeChildAdded(juce::ValueTree& parentTree, juce::ValueTree& /*child*/)
+{
+    if (parentTree == m_commandModel)
+        ScheduleRowsUpdate();
+}
+
+void MonitorPage::valueTreeChildRemoved(juce::ValueTree& parentTree, juce::ValueTree& /*child*/, int /*index*/)
+{
+    if (parentTree == m_commandModel)
+        ScheduleRowsUpdate();
+}
+
+void MonitorPage::valueTreeChildOrderChanged(juce::ValueTree& parentTree, int /*oldIndex*/, int /*newIndex*/)
+{
+    if (parentTree == m_commandModel)
+        ScheduleRowsUpdate();
+}
+
+void MonitorPage::handleAsyncUpdate()
+{
+    if (m_rowsChanged)
+        CollectRows();
+    else if (!m_changedCommands.empty())
+        UpdateChangedRows();
+
+    // Show the values which were notified already.
+    timerCallback();
+}
+
+bool MonitorPage::ResolveRow(const juce::ValueTree& command, MonitoredProperty& row)
+{
+    std::uint32_t ono(0);
+    int defLevel(0), propIndex(0), dataType(0);
+    if (!CommandModel::GetSubscribedProperty(command, ono, defLevel, propIndex, dataType))
+        return false;
+
+    row.m_command = command;
+    row.m_key = LatestValueStore::MakeKey(ono, static_cast<std::uint16_t>(defLevel), static_cast<std::uint16_t>(propIndex));
+    row.m_dataType = dataType;
+    return true;
+}
+
+void MonitorPage::CollectRows()
+{
+    m_rowsChanged = false;
+    m_changedCommands.clear();
+
+    // Both the previous and the new rows are in model order, so rows of unchanged commands are 
+    // found by walking both at once, skipping previous rows whose command was removed meanwhile.
+    std::vector<MonitoredProperty> previousRows;
+    previousRows.swap(m_rows);
+    std::size_t previousIdx(0);
+    for (const auto& command : m_commandModel)
+    {
+        while ((previousIdx < previousRows.size()) && !previousRows[previousIdx].m_command.getParent().isValid())
+            previousIdx++;
+
+        MonitoredProperty row;
+        auto subscribes = ResolveRow(command, row);
+        if ((previousIdx < previousRows.size()) && (previousRows[previousIdx].m_command == command))
+        {
+            const auto& previousRow = previousRows[previousIdx++];
+            if (subscribes && (previousRow.m_key == row.m_key) && (previousRow.m_dataType == row.m_dataType))
+                row = previousRow;
+        }
+
+        if (subscribes)
+            m_rows.push_back(row);
+    }
+
+    m_table.updateContent();
+    m_table.repaint();
+
+    UpdateSummary();
+}
+
+void MonitorPage::UpdateChangedRows()
+{
+    bool rowsAddedOrRemoved(false);
+    for (const auto& command : m_changedCommands)
+    {
+        auto rowIter = std::find_if(m_rows.begin(), m_rows.end(), [&](const MonitoredProperty& row) { return row.m_command == command; });
+
+        MonitoredProperty changedRow;
+        bool subscribes = (command.getParent() == m_commandModel) && ResolveRow(command, changedRow);
+        if ((rowIter != m_rows.end()) && subscribes)
+        {
+            // Counters only remain meaningful as long as the same property is shown.
+            if ((rowIter->m_key != changedRow.m_key) || (rowIter->m_dataType != changedRow.m_dataType))
+                *rowIter = changedRow;
+
+            m_table.repaintRow(static_cast<int>(std::distance(m_rows.begin(), rowIter)));
+        }
+        else if (rowIter != m_rows.end())
+        {
+            m_rows.erase(rowIter);
+            rowsAddedOrRemoved = true;
+        }
+        else if (subscribes)
+        {
+            // Keep the rows in model order.
+            auto modelIdx = m_commandModel.indexOf(command);
+            auto insertIter = std::lower_bound(m_rows.begin(), m_rows.end(), modelIdx, [this](const MonitoredProperty& row, int idx)
+            {
+                return m_commandModel.indexOf(row.m_command) < idx;
+            });
+            m_rows.insert(insertIter, changedRow);
+            rowsAddedOrRemoved = true;
+        }
+    }
+    m_changedCommands.clear();
+
+    if (rowsAddedOrRemoved)
+    {
+        m_table.updateContent();
+        m_table.repaint();
+
+        UpdateSummary();
+    }
+}
+
+void MonitorPage::timerCallback()
+{
+    if (!isShowing() || m_rows.empty())
+        return;
+
+    // Only the rows scrolled into view are read from the store, and repainted if their value was updated,
+    // no matter how many Notifications were received since the previous frame.
+    auto viewport = m_table.getViewport();
+    int firstRow = viewport->getViewPositionY() / MonitorTableRowHeight;
+    int lastRow = juce::jmin(static_cast<int>(m_rows.size()) - 1,
+                             (viewport->getViewPositionY() + viewport->getViewHeight()) / MonitorTableRowHeight);
+
+    const auto& store = GetMainComponent()->GetLatestValueStore();
+    std::uint8_t valueData[LatestValueStore::MaxValueSize];
+    for (int rowNumber = firstRow; rowNumber <= lastRow; rowNumber++)
+    {
+        auto& row = m_rows[static_cast<size_t>(rowNumber)];
+        std::size_t valueSize(0);
+        std::uint32_t updateCount(0);
+        if (!store.Read(row.m_key, valueData, valueSize, updateCount) || (updateCount == row.m_updateCount))
+            continue;
+
+        // All updates since the previous frame but the latest one were never shown.
+        row.m_numCoalesced += updateCount - row.m_updateCount - 1;
+        row.m_updateCount = updateCount;
+        row.m_valueText.clear();
+        const std::uint8_t* src = valueData;
+        auto codec = AES70::GetValueCodec(row.m_dataType);
+        if ((codec == nullptr) || !codec->m_decode(src, valueData + valueSize, row.m_valueText))
+            row.m_valueText = juce::String::toHexString(valueData, static_cast<int>(valueSize));
+
+        m_table.repaintRow(rowNumber);
+    }
+}
+
+juce::String MonitorPage::GetCellText(int rowNumber, int columnId) const
+{
+    if ((rowNumber < 0) || (rowNumber >= static_cast<int>(m_rows.size())))
+        return {};
+
+    const auto& row = m_rows[static_cast<size_t>(rowNumber)];
+
+    switch (columnId)
+    {
+        case COLUMN_PAGE:
+            return row.m_command.getProperty(CommandModel::Name).toString();
+        case COLUMN_CLASS:
+            return row.m_command.getProperty(CommandModel::Class).toString();
+        case COLUMN_ONO:
+            return row.m_command.getProperty(CommandModel::Ono).toString();
+        case COLUMN_PROPERTY:
+            return row.m_command.getProperty(CommandModel::Property).toString();
+        case COLUMN_VALUE:
+            return row.m_valueText;
+        case COLUMN_UPDATES:
+            return (row.m_updateCount > 0) ? juce::String(row.m_updateCount) : juce::String();
+        case COLUMN_COALESCED:
+            return (row.m_updateCount > 0) ? juce::String(row.m_numCoalesced) : juce::String();
+        default:
+            break;
+    }
+
+    jassertfalse; // Missing implementation for column!
+    return {};
+}
+
+void MonitorPage::SetAllSubscribed(bool subscribe)
+{
+    // The SubscriptionManager pipelines the commands of all rows into few PDUs.
+    auto& subscriptionManager = GetMainComponent()->GetSubscriptionManager();
+    for (const auto& row : m_rows)
+    {
+        std::uint32_t ono(0);
+        int defLevel(0), propIndex(0), dataType(0);
+        if (!CommandModel::GetSubscribedProperty(row.m_command, ono, defLevel, propIndex, dataType))
+            continue;
+
+        if (subscribe)
+            subscriptionManager.Add(ono, defLevel, propIndex, dataType, true);
+        else
+            subscriptionManager.Remove(ono, defLevel, propIndex);
+    }
+
+    UpdateSummary();
+}
+
+void MonitorPage::UpdateSummary()
+{
+    auto numSubscriptions = GetMainComponent()->GetSubscriptionManager().GetNumSubscriptions();
+    m_summaryLabel.setText(juce::String(m_rows.size()) + " properties, " + juce::String(numSubscriptions) + " subscriptions active", 
+                           juce::dontSendNotification);
+}
+
+void MonitorPage::ScheduleRowsUpdate()
+{
+    m_rowsChanged = true;
+    triggerAsyncUpdate();
+}
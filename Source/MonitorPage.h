@@ -0,0 +1,175 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AbstractPage.h"
+
+
+/**
+ * Page showing the latest values of all properties subscribed to by AddSubscription commands of the 
+ * CommandModel, i.e. the readings of many OcaAudioLevelSensor objects, as they are notified by the device.
+ * Incoming Notifications are not passed to the page directly, but only update the LatestValueStore 
+ * of the MainTabbedComponent. The page polls the store at a fixed frame rate, and repaints only those 
+ * visible rows whose values were updated since the previous frame, so that its cost does not depend 
+ * on the rate of incoming Notifications.
+ */
+class MonitorPage : public AbstractPage,
+                    private juce::TableListBoxModel,
+                    private juce::ValueTree::Listener,
+                    private juce::AsyncUpdater,
+                    private juce::Timer
+{
+public:
+    MonitorPage(MainTabbedComponent* parent);
+    ~MonitorPage() override;
+
+
+    // Reimplemented from AbstractPage
+
+    void UpdateConnectionStatus(ConnectionStatus status) override;
+
+
+    // Reimplemented from juce::Component
+
+    void paint(juce::Graphics&) override;
+    void resized() override;
+
+
+private:
+    /**
+     * A subscribed property, shown as one table row.
+     */
+    struct MonitoredProperty
+    {
+        juce::ValueTree m_command;          // AddSubscription command node.
+        std::uint64_t m_key = 0;            // Key within the LatestValueStore.
+        int m_dataType = 0;                 // Data type of the property value.
+        std::uint32_t m_updateCount = 0;    // Update count of the value shown.
+        std::uint32_t m_numCoalesced = 0;   // Number of updates which were replaced before being shown.
+        juce::String m_valueText;           // Latest value, as shown.
+    };
+
+
+    // Reimplemented from juce::TableListBoxModel
+
+    int getNumRows() override;
+    void paintRowBackground(juce::Graphics& g, int rowNumber, int width, int height, bool rowIsSelected) override;
+    void paintCell(juce::Graphics& g, int rowNumber, int columnId, int width, int height, bool rowIsSelected) override;
+    void cellDoubleClicked(int rowNumber, int columnId, const juce::MouseEvent& e) override;
+
+
+    // Reimplemented from juce::ValueTree::Listener
+
+    void valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property) override;
+    void valueTreeChildAdded(juce::ValueTree& parentTree, juce::ValueTree& child) override;
+    void valueTreeChildRemoved(juce::ValueTree& parentTree, juce::ValueTree& child, int index) override;
+    void valueTreeChildOrderChanged(juce::ValueTree& parentTree, int oldIndex, int newIndex) override;
+
+
+    // Reimplemented from juce::AsyncUpdater
+
+    void handleAsyncUpdate() override;
+
+
+    // Reimplemented from juce::Timer
+
+    void timerCallback() override;
+
+
+    /**
+     * Get the text to display in the given cell.
+     *
+     * @param[in] rowNumber     Row index within m_rows.
+     * @param[in] columnId      One of the table's column ids.
+     * @return  The cell text, or an empty string if the row does not exist.
+     */
+    juce::String GetCellText(int rowNumber, int columnId) const;
+
+    /**
+     * Subscribe to the properties of all rows, or unsubscribe from them (See SubscriptionManager).
+     *
+     * @param[in] subscribe     True to subscribe, false to unsubscribe.
+     */
+    void SetAllSubscribed(bool subscribe);
+
+    /**
+     * Update the m_summaryLabel with the number of rows and of subscriptions.
+     */
+    void UpdateSummary();
+
+    /**
+     * Mark the rows as outdated. The rows are re-collected on the next handleAsyncUpdate, so that 
+     * any number of changes within one message loop iteration (i.e. while loading a file) are merged.
+     */
+    void ScheduleRowsUpdate();
+
+    /**
+     * Get the property which a command subscribes to, as needed by a table row.
+     *
+     * @param[in] command   Node of type CommandModel::CommandType.
+     * @param[out] row      Row whose m_command, m_key and m_dataType are set. Other members are left untouched.
+     * @return  True if the command is an AddSubscription command.
+     */
+    static bool ResolveRow(const juce::ValueTree& command, MonitoredProperty& row);
+
+    /**
+     * Re-collect all rows from the CommandModel. Rows of commands which still subscribe 
+     * to the same property keep their value and counters.
+     */
+    void CollectRows();
+
+    /**
+     * Update, add, or remove only the rows of the commands in m_changedCommands.
+     */
+    void UpdateChangedRows();
+
+    // The CommandModel of the MainTabbedComponent.
+    juce::ValueTree m_commandModel;
+
+    // Label showing the number of subscribed properties.
+    juce::Label m_summaryLabel;
+
+    // Button to subscribe to the properties of all rows.
+    juce::TextButton m_subscribeButton;
+
+    // Button to unsubscribe from the properties of all rows.
+    juce::TextButton m_unsubscribeButton;
+
+    // Table with one row per subscribed property.
+    juce::TableListBox m_table;
+
+    // Subscribed properties, in model order. One per table row.
+    std::vector<MonitoredProperty> m_rows;
+
+    // True if m_rows needs to be re-collected on the next handleAsyncUpdate.
+    bool m_rowsChanged;
+
+    // Commands whose subscribed property might have changed, to be updated on the next handleAsyncUpdate.
+    std::vector<juce::ValueTree> m_changedCommands;
+
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MonitorPage)
+};
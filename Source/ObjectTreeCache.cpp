@@ -0,0 +1,263 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#include "ObjectTreeCache.h"
+#include "AES70Schema.h"
+#include "Trace.h"
+#include <unordered_map>
+
+
+static constexpr char ObjectTreeCacheMagic[4] = { 'A', 'O', 'T', 'C' }; // Identifies an object tree cache file.
+static constexpr juce::uint16 ObjectTreeCacheVersion = 1; // Current format version. Other versions are ignored.
+static constexpr juce::uint16 ObjectTreeCacheHeaderSize = 28; // Size of the header in bytes.
+static constexpr std::size_t ObjectTreeCacheRecordSize = 16; // Size of each record in bytes.
+static constexpr std::size_t ObjectTreeCacheBufferSize = 16384; // Size of the output stream buffer in bytes.
+
+
+//==============================================================================
+// Class ObjectTreeCache
+//==============================================================================
+
+const juce::String ObjectTreeCache::FileExtension(".aes70tree");
+
+juce::File ObjectTreeCache::GetCacheFile(const juce::String& deviceIdentity)
+{
+    juce::String appName("AES70_OCP1_StringGenerator");
+    if (auto app = juce::JUCEApplicationBase::getInstance())
+        appName = app->getApplicationName();
+
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile(appName)
+        .getChildFile("ObjectTreeCache")
+        .getChildFile(juce::File::createLegalFileName(deviceIdentity) + FileExtension);
+}
+
+bool ObjectTreeCache::Write(const std::map<std::uint32_t, ObjectTreeWalker::DiscoveredObject>& objects, juce::OutputStream& stream)
+{
+    // A device typically has many objects of few classes, so each ClassID is stored only once.
+    std::vector<juce::String> strings;
+    std::unordered_map<juce::String, juce::uint32> stringIndices;
+    auto internString = [&](const juce::String& value)
+    {
+        auto result = stringIndices.emplace(value, static_cast<juce::uint32>(strings.size()));
+        if (result.second)
+            strings.push_back(value);
+
+        return result.first->second;
+    };
+
+    std::vector<juce::uint32> classIdIndices;
+    classIdIndices.reserve(objects.size());
+    for (const auto& onoAndObject : objects)
+        classIdIndices.push_back(internString(onoAndObject.second.m_classId));
+
+    juce::uint32 numRecords = static_cast<juce::uint32>(objects.size());
+    juce::uint32 numStrings = static_cast<juce::uint32>(strings.size());
+    juce::uint32 recordsOffset = ObjectTreeCacheHeaderSize;
+    juce::uint32 stringOffsetsOffset = recordsOffset + numRecords * static_cast<juce::uint32>(ObjectTreeCacheRecordSize);
+    juce::uint32 stringDataOffset = stringOffsetsOffset + (numStrings + 1) * static_cast<juce::uint32>(sizeof(juce::uint32));
+
+    auto startPosition = stream.getPosition();
+
+    // Header
+    stream.write(ObjectTreeCacheMagic, sizeof(ObjectTreeCacheMagic));
+    stream.writeShort(static_cast<short>(ObjectTreeCacheVersion));
+    stream.writeShort(static_cast<short>(ObjectTreeCacheHeaderSize));
+    stream.writeInt(static_cast<int>(numRecords));
+    stream.writeInt(static_cast<int>(numStrings));
+    stream.writeInt(static_cast<int>(recordsOffset));
+    stream.writeInt(static_cast<int>(stringOffsetsOffset));
+    stream.writeInt(static_cast<int>(stringDataOffset));
+    jassert(stream.getPosition() - startPosition == ObjectTreeCacheHeaderSize);
+    ignoreUnused(startPosition);
+
+    // Records, in ONo order since objects is a std::map.
+    std::size_t recordIdx = 0;
+    for (const auto& onoAndObject : objects)
+    {
+        const auto& object = onoAndObject.second;
+        stream.writeInt(static_cast<int>(object.m_ono));
+        stream.writeInt(static_cast<int>(object.m_containerOno));
+        stream.writeInt(static_cast<int>(classIdIndices[recordIdx++]));
+        stream.writeShort(static_cast<short>(object.m_classVersion));
+        stream.writeShort(0);
+    }
+
+    // String offsets, including the end offset of the last string.
+    juce::uint32 stringOffset = 0;
+    stream.writeInt(0);
+    for (const auto& string : strings)
+    {
+        stringOffset += static_cast<juce::uint32>(string.getNumBytesAsUTF8());
+        stream.writeInt(static_cast<int>(stringOffset));
+    }
+
+    // String data
+    bool success = true;
+    for (const auto& string : strings)
+        success = stream.write(string.toRawUTF8(), string.getNumBytesAsUTF8()) && success;
+
+    return success;
+}
+
+ObjectTreeCache::ObjectTreeCache(const juce::File& file)
+    :   m_mappedFile(file, juce::MemoryMappedFile::readOnly),
+        m_data(nullptr),
+        m_numRecords(0),
+        m_numStrings(0),
+        m_recordsOffset(0),
+        m_stringOffsetsOffset(0),
+        m_stringDataOffset(0),
+        m_stringDataSize(0)
+{
+    auto data = static_cast<const char*>(m_mappedFile.getData());
+    auto dataSize = m_mappedFile.getSize();
+    if ((data == nullptr) || (dataSize < ObjectTreeCacheHeaderSize))
+        return;
+
+    // Header
+    if ((std::memcmp(data, ObjectTreeCacheMagic, sizeof(ObjectTreeCacheMagic)) != 0) ||
+        (juce::ByteOrder::littleEndianShort(data + 4) != ObjectTreeCacheVersion) ||
+        (juce::ByteOrder::littleEndianShort(data + 6) < ObjectTreeCacheHeaderSize))
+        return;
+
+    m_numRecords = juce::ByteOrder::littleEndianInt(data + 8);
+    m_numStrings = juce::ByteOrder::littleEndianInt(data + 12);
+    m_recordsOffset = juce::ByteOrder::littleEndianInt(data + 16);
+    m_stringOffsetsOffset = juce::ByteOrder::littleEndianInt(data + 20);
+    m_stringDataOffset = juce::ByteOrder::littleEndianInt(data + 24);
+
+    if ((m_recordsOffset + static_cast<std::size_t>(m_numRecords) * ObjectTreeCacheRecordSize > dataSize) ||
+        (m_stringOffsetsOffset + (static_cast<std::size_t>(m_numStrings) + 1) * sizeof(juce::uint32) > dataSize))
+        return;
+
+    m_stringDataSize = juce::ByteOrder::littleEndianInt(data + m_stringOffsetsOffset + m_numStrings * sizeof(juce::uint32));
+    if (m_stringDataOffset + m_stringDataSize > dataSize)
+        return;
+
+    m_data = data;
+}
+
+bool ObjectTreeCache::IsValid() const
+{
+    return m_data != nullptr;
+}
+
+bool ObjectTreeCache::ReadAll(std::map<std::uint32_t, ObjectTreeWalker::DiscoveredObject>& objects) const
+{
+    objects.clear();
+    if (!IsValid())
+        return false;
+
+    // ClassIDs are only decoded and looked up in the schema once, regardless of how many objects share them.
+    std::vector<ObjectTreeWalker::DiscoveredObject> classes(m_numStrings);
+    for (std::uint32_t stringIdx = 0; stringIdx < m_numStrings; stringIdx++)
+    {
+        if (!ReadClass(stringIdx, classes[stringIdx]))
+            return false;
+    }
+
+    for (std::uint32_t recordIdx = 0; recordIdx < m_numRecords; recordIdx++)
+    {
+        auto record = m_data + m_recordsOffset + recordIdx * ObjectTreeCacheRecordSize;
+        auto stringIdx = juce::ByteOrder::littleEndianInt(record + 8);
+        if (stringIdx >= m_numStrings)
+        {
+            objects.clear();
+            return false;
+        }
+
+        auto object = classes[stringIdx];
+        object.m_ono = juce::ByteOrder::littleEndianInt(record);
+        object.m_containerOno = juce::ByteOrder::littleEndianInt(record + 4);
+        object.m_classVersion = juce::ByteOrder::littleEndianShort(record + 12);
+
+        // Records are sorted, so each one is appended at the end of the map.
+        objects.emplace_hint(objects.end(), object.m_ono, object);
+    }
+
+    return true;
+}
+
+bool ObjectTreeCache::ReadClass(std::uint32_t stringIdx, ObjectTreeWalker::DiscoveredObject& object) const
+{
+    if (stringIdx >= m_numStrings)
+        return false;
+
+    auto stringOffsets = m_data + m_stringOffsetsOffset;
+    auto startOffset = juce::ByteOrder::littleEndianInt(stringOffsets + stringIdx * sizeof(juce::uint32));
+    auto endOffset = juce::ByteOrder::littleEndianInt(stringOffsets + (stringIdx + 1) * sizeof(juce::uint32));
+    if ((endOffset < startOffset) || (endOffset > m_stringDataSize))
+        return false;
+
+    object.m_classId = juce::String::fromUTF8(m_data + m_stringDataOffset + startOffset, static_cast<int>(endOffset - startOffset));
+
+    // The class index is not stored, since it depends on the schema files loaded in this session.
+    object.m_classIdx = AES70::Schema::GetInstance().GetClassIdxFromClassId(object.m_classId);
+
+    return true;
+}
+
+
+//==============================================================================
+// Class ObjectTreeCacheWriter
+//==============================================================================
+
+ObjectTreeCacheWriter::ObjectTreeCacheWriter(const std::map<std::uint32_t, ObjectTreeWalker::DiscoveredObject>& objects, const juce::File& file)
+    :   juce::Thread("ObjectTreeCacheWriter"),
+        m_file(file)
+{
+    juce::MemoryOutputStream stream(m_content, false);
+    if (!ObjectTreeCache::Write(objects, stream))
+        m_content.reset();
+}
+
+ObjectTreeCacheWriter::~ObjectTreeCacheWriter()
+{
+    waitForThreadToExit(-1);
+}
+
+void ObjectTreeCacheWriter::run()
+{
+    AES70_TRACE_SCOPE("ObjectTreeCacheWriter::run");
+
+    if (m_content.isEmpty() || !m_file.getParentDirectory().createDirectory())
+        return;
+
+    // Write to a temporary file next to the target, which only replaces the target on success.
+    juce::TemporaryFile tempFile(m_file);
+    bool written(false);
+    {
+        juce::FileOutputStream stream(tempFile.getFile(), ObjectTreeCacheBufferSize);
+        if (!stream.openedOk())
+            return;
+
+        written = stream.write(m_content.getData(), m_content.getSize());
+        stream.flush();
+        written = written && stream.getStatus().wasOk();
+    }
+
+    if (written)
+        tempFile.overwriteTargetFileWithTemporary();
+}
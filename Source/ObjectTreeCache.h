@@ -0,0 +1,159 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include "ObjectTreeWalker.h"
+
+
+/**
+ * Compact binary file holding the objects discovered on a device (See ObjectTreeWalker), so that a later
+ * session connecting to the same device can look up the class of each ONo right away, and only has to
+ * revalidate the tree instead of walking it again. One file is kept per device identity, which includes
+ * the device's firmware revision, so a firmware update starts over with an empty cache.
+ * 
+ * The file consists of a fixed-size header, followed by one fixed-size record per object, sorted by ONo,
+ * followed by a table of interned UTF-8 ClassID strings. All values are little-endian.
+ * 
+ *  Header:         magic "AOTC" (4), format version (2), header size (2), number of records (4),
+ *                  number of strings (4), records offset (4), string offsets offset (4), string data offset (4).
+ *  Records:        ONo (4), container ONo (4), ClassID string index (4), ClassVersion (2), reserved (2).
+ *  String offsets: numStrings + 1 uint32 offsets into the string data, like in BinaryProjectFile.
+ *  String data:    concatenated UTF-8 strings, without terminators.
+ * 
+ * The file is read straight from a juce::MemoryMappedFile. Since revalidation needs every cached block and its 
+ * members anyway, the whole file is read at once (See ReadAll), decoding each ClassID string only once.
+ */
+class ObjectTreeCache
+{
+public:
+    /**
+     * File extension used for object tree cache files.
+     */
+    static const juce::String FileExtension;
+
+    /**
+     * Get the cache file of a device.
+     *
+     * @param[in] deviceIdentity    Identity of the device, including its firmware revision.
+     * @return  File in the application data directory, which may or may not exist.
+     */
+    static juce::File GetCacheFile(const juce::String& deviceIdentity);
+
+    /**
+     * Write the given objects to a stream in the cache file format.
+     *
+     * @param[in] objects   Objects to write, by ONo.
+     * @param[in] stream    Stream to write to.
+     * @return  True if the content could be written to the stream.
+     */
+    static bool Write(const std::map<std::uint32_t, ObjectTreeWalker::DiscoveredObject>& objects, juce::OutputStream& stream);
+
+    /**
+     * Map the given cache file into memory. Use IsValid to check whether that succeeded.
+     *
+     * @param[in] file  Cache file to read.
+     */
+    explicit ObjectTreeCache(const juce::File& file);
+
+    /**
+     * Check whether the file was mapped, and its header and tables are consistent.
+     *
+     * @return  True if objects can be read from the file.
+     */
+    bool IsValid() const;
+
+    /**
+     * Read all objects of the file.
+     *
+     * @param[out] objects  The objects, by ONo.
+     * @return  True if the file is valid and all records could be read.
+     */
+    bool ReadAll(std::map<std::uint32_t, ObjectTreeWalker::DiscoveredObject>& objects) const;
+
+private:
+    /**
+     * Set the ClassID and class index of an object from the string at the given index.
+     *
+     * @param[in] stringIdx Index of the ClassID string.
+     * @param[out] object   The object.
+     * @return  False if the index or the string's offsets are invalid.
+     */
+    bool ReadClass(std::uint32_t stringIdx, ObjectTreeWalker::DiscoveredObject& object) const;
+
+    // The mapped cache file.
+    juce::MemoryMappedFile m_mappedFile;
+
+    // Start of the mapped data, or nullptr if the file is not valid.
+    const char* m_data;
+
+    // Values of the header.
+    std::uint32_t m_numRecords;
+    std::uint32_t m_numStrings;
+    std::size_t m_recordsOffset;
+    std::size_t m_stringOffsetsOffset;
+    std::size_t m_stringDataOffset;
+    std::size_t m_stringDataSize;
+
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ObjectTreeCache)
+};
+
+
+/**
+ * Writes the content of a cache file on a background thread, so that creating the directory and writing and 
+ * replacing the file never block the message thread. Like ConfigFileWriter, the content is written to a 
+ * temporary file first, which only replaces the target file once writing has succeeded.
+ */
+class ObjectTreeCacheWriter : public juce::Thread
+{
+public:
+    /**
+     * @param[in] objects   Objects to write, by ONo. They are encoded right away, on the calling thread,
+     *                      so that only the encoded file content is handed to the background thread.
+     * @param[in] file      Cache file to write.
+     */
+    ObjectTreeCacheWriter(const std::map<std::uint32_t, ObjectTreeWalker::DiscoveredObject>& objects, const juce::File& file);
+
+    /**
+     * Waits until writing has finished, so that no partially written file is left behind.
+     */
+    ~ObjectTreeCacheWriter() override;
+
+
+    // Reimplemented from juce::Thread
+
+    void run() override;
+
+
+private:
+    // The cache file to write.
+    juce::File m_file;
+
+    // Encoded content of the cache file.
+    juce::MemoryBlock m_content;
+
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ObjectTreeCacheWriter)
+};
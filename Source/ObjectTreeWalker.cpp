@@ -0,0 +1,553 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#include "ObjectTreeWalker.h"
+#include "ObjectTreeCache.h"
+#include "AES70Codec.h"
+#include "AES70Schema.h"
+#include "CommandModel.h"
+#include "Trace.h"
+#include <NanoOcp1.h>
+#include <algorithm>
+
+
+static constexpr int GetMembersDefLevel = 3;        // Definition level of OcaBlock's GetMembers method.
+static constexpr int GetMembersMethodIdx = 5;       // Index of OcaBlock's GetMembers method.
+static const juce::String BlockClassId("1.1.3");    // ClassID of OcaBlock, and prefix of the ClassIDs of its subclasses.
+static constexpr int MaxMessagesPerPdu = 64;        // Number of GetMembers Commands pipelined into one PDU at most.
+static constexpr int ResponseTimeoutMs = 3000;      // Time without any Response after which a walk is given up.
+static constexpr std::uint32_t DeviceManagerOno = 1;  // ONo of the OcaDeviceManager, which AES70 reserves for it.
+static constexpr int DeviceManagerDefLevel = 3;     // Definition level of OcaDeviceManager's methods.
+static constexpr int IdentityMethodIndices[] = { 2, 3, 20 }; // GetModelGUID, GetSerialNumber and GetDeviceRevisionID.
+static constexpr int ModelGuidField = 0;            // Index of the model GUID within the device identity fields.
+static constexpr int SerialNumberField = 1;         // Index of the serial number within the device identity fields.
+
+
+/**
+ * Helper method to check whether a ClassID is that of OcaBlock or of one of its subclasses.
+ *
+ * @param[in] classId   Dotted ClassID.
+ * @return  True if objects of the class have members.
+ */
+static bool IsBlockClassId(const juce::String& classId)
+{
+    return classId.startsWith(BlockClassId) 
+           && ((classId.length() == BlockClassId.length()) || (classId[BlockClassId.length()] == '.'));
+}
+
+/**
+ * Helper method to decode a field of the device identity from the Response to an OcaDeviceManager getter.
+ *
+ * @param[in] field     Index of the field, i.e. ModelGuidField.
+ * @param[in] response  Response to the getter.
+ * @return  The field as string, or an empty string if it could not be decoded.
+ */
+static juce::String DecodeIdentityField(int field, const AES70::ResponseView& response)
+{
+    if ((response.m_status != 0 /* OCASTATUS_OK */) || (response.m_paramCount != 1))
+        return {};
+
+    // OcaModelGUID is a fixed-size struct of blobs, all other fields are strings.
+    if (field == ModelGuidField)
+        return juce::String::toHexString(response.m_paramData, static_cast<int>(response.m_paramDataSize), 0);
+
+    juce::String value;
+    auto pos = response.m_paramData;
+    if (!AES70::Codec<juce::String>::Decode(pos, response.m_paramData + response.m_paramDataSize, value))
+        return {};
+
+    return value;
+}
+
+/**
+ * Helper method to hash the identification of an object, i.e. for ObjectTreeWalker::MemberSignature.
+ *
+ * @param[in] object    The object.
+ * @return  64-bit FNV-1a hash of the object's ONo, ClassID and ClassVersion.
+ */
+static std::uint64_t GetObjectHash(const ObjectTreeWalker::DiscoveredObject& object)
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+    auto addByte = [&hash](std::uint8_t value)
+    {
+        hash ^= value;
+        hash *= 1099511628211ULL;
+    };
+
+    for (int shift = 0; shift < 32; shift += 8)
+        addByte(static_cast<std::uint8_t>(object.m_ono >> shift));
+    for (auto pos = object.m_classId.toRawUTF8(); *pos != 0; pos++)
+        addByte(static_cast<std::uint8_t>(*pos));
+    addByte(static_cast<std::uint8_t>(object.m_classVersion));
+    addByte(static_cast<std::uint8_t>(object.m_classVersion >> 8));
+
+    return hash;
+}
+
+
+//==============================================================================
+// Struct ObjectTreeWalker::MemberSignature
+//==============================================================================
+
+void ObjectTreeWalker::MemberSignature::Add(const DiscoveredObject& member)
+{
+    m_numMembers++;
+    m_hashSum += GetObjectHash(member);
+}
+
+bool ObjectTreeWalker::MemberSignature::operator==(const MemberSignature& other) const
+{
+    return (m_numMembers == other.m_numMembers) && (m_hashSum == other.m_hashSum);
+}
+
+
+//==============================================================================
+// Class ObjectTreeWalker
+//==============================================================================
+
+ObjectTreeWalker::ObjectTreeWalker(SendFunction sendFunction)
+    :   m_sendFunction(std::move(sendFunction)),
+        m_numRoundTrips(0),
+        m_numChangedBlocks(0),
+        m_isRevalidation(false),
+        m_isComplete(false),
+        m_hasFinished(false)
+{
+    jassert(m_sendFunction != nullptr);
+}
+
+ObjectTreeWalker::~ObjectTreeWalker()
+{
+    stopTimer();
+}
+
+bool ObjectTreeWalker::Start(std::uint32_t rootOno)
+{
+    AES70_TRACE_SCOPE("ObjectTreeWalker::Start");
+
+    m_objects.clear();
+    m_pendingRequests.clear();
+    m_failedBlocks.clear();
+    m_blockSignatures.clear();
+    m_numRoundTrips = 0;
+    m_numChangedBlocks = 0;
+    m_isRevalidation = false;
+    m_isComplete = true;
+    m_hasFinished = false;
+
+    // The root block is not a member of any block, so its class is not returned by any GetMembers.
+    DiscoveredObject root;
+    root.m_ono = rootOno;
+    root.m_classId = BlockClassId;
+    root.m_classIdx = AES70::Schema::GetInstance().GetClassIdxFromClassId(BlockClassId);
+    m_objects[rootOno] = root;
+    m_nextLevelBlocks = { rootOno };
+
+    RequestNextLevel();
+
+    return IsRunning();
+}
+
+void ObjectTreeWalker::Cancel()
+{
+    if (IsRunning())
+        Finish(false);
+}
+
+void ObjectTreeWalker::OnConnectionEstablished()
+{
+    m_identityRequests.clear();
+    m_identityFields.clear();
+    m_deviceIdentity.clear();
+
+    bool sent(true);
+    AES70::PduPipeline pipeline([this, &sent](const juce::MemoryBlock& pdu) 
+        { 
+            sent = m_sendFunction(pdu) && sent;
+            return sent;
+        });
+
+    for (int field = 0; field < juce::numElementsInArray(IdentityMethodIndices); field++)
+    {
+        NanoOcp1::Ocp1CommandDefinition commandDefinition(DeviceManagerOno, NanoOcp1::OCP1DATATYPE_BLOB, DeviceManagerDefLevel, IdentityMethodIndices[field]);
+        std::uint32_t handle(0); // Auto-generated by Ocp1CommandResponseRequired, replaced by an internal one.
+        NanoOcp1::Ocp1CommandResponseRequired command(commandDefinition, handle);
+        handle = AES70::NextInternalHandle();
+        command.SetHandle(handle);
+        pipeline.Add(command.GetMemoryBlock());
+        m_identityRequests[handle] = field;
+        m_identityFields.add({});
+    }
+    pipeline.Flush();
+
+    if (!sent)
+    {
+        m_identityRequests.clear();
+        return;
+    }
+
+    if (!IsRunning())
+        startTimer(ResponseTimeoutMs);
+}
+
+void ObjectTreeWalker::OnConnectionLost()
+{
+    m_identityRequests.clear();
+    m_deviceIdentity.clear();
+
+    if (IsRunning())
+        Finish(false);
+    else
+        stopTimer();
+}
+
+bool ObjectTreeWalker::IsRunning() const
+{
+    return !m_pendingRequests.empty();
+}
+
+bool ObjectTreeWalker::IsAwaitingResponses() const
+{
+    return IsRunning() || !m_identityRequests.empty();
+}
+
+const juce::String& ObjectTreeWalker::GetDeviceIdentity() const
+{
+    return m_deviceIdentity;
+}
+
+bool ObjectTreeWalker::HandleResponse(const AES70::ResponseView& response)
+{
+    auto identityIter = m_identityRequests.find(response.m_handle);
+    if (identityIter != m_identityRequests.end())
+    {
+        m_identityFields.set(identityIter->second, DecodeIdentityField(identityIter->second, response));
+        m_identityRequests.erase(identityIter);
+        if (m_identityRequests.empty())
+            OnDeviceIdentified();
+
+        return true;
+    }
+
+    auto requestIter = m_pendingRequests.find(response.m_handle);
+    if (requestIter == m_pendingRequests.end())
+        return false;
+
+    auto containerOno = requestIter->second;
+    m_pendingRequests.erase(requestIter);
+
+    // A block whose members can not be retrieved does not stop the walk, but leaves it incomplete.
+    if ((response.m_status != 0 /* OCASTATUS_OK */) || !AddMembers(containerOno, response))
+        m_failedBlocks.push_back(containerOno);
+
+    if (m_pendingRequests.empty())
+        RequestNextLevel();
+    else
+        startTimer(ResponseTimeoutMs);
+
+    return true;
+}
+
+const std::map<std::uint32_t, ObjectTreeWalker::DiscoveredObject>& ObjectTreeWalker::GetObjects() const
+{
+    return m_objects;
+}
+
+int ObjectTreeWalker::GetNumRoundTrips() const
+{
+    return m_numRoundTrips;
+}
+
+bool ObjectTreeWalker::IsRevalidation() const
+{
+    return m_isRevalidation;
+}
+
+int ObjectTreeWalker::GetNumChangedBlocks() const
+{
+    return m_numChangedBlocks;
+}
+
+ObjectTreeWalker::Validation ObjectTreeWalker::Validate(const juce::ValueTree& command) const
+{
+    if (!m_hasFinished)
+        return Validation::Unknown;
+
+    const auto& schema = AES70::Schema::GetInstance();
+    int commandClassIdx = schema.GetClassIdxFromText(command.getProperty(CommandModel::Class).toString());
+    if (commandClassIdx == 0)
+        return Validation::Unknown;
+
+    auto objectIter = m_objects.find(static_cast<std::uint32_t>(command.getProperty(CommandModel::Ono).toString().getLargeIntValue()));
+    if (objectIter == m_objects.end())
+        return m_isComplete ? Validation::Mismatch : Validation::Unknown;
+
+    // Objects of proprietary classes can not be checked, unless the classes were loaded from a schema file.
+    if (objectIter->second.m_classIdx == 0)
+        return Validation::Unknown;
+
+    // An object of a subclass offers all properties and methods of the command's class.
+    for (int classIdx = objectIter->second.m_classIdx; classIdx != 0; )
+    {
+        if (classIdx == commandClassIdx)
+            return Validation::Match;
+
+        auto classDefinition = schema.GetClass(classIdx);
+        classIdx = (classDefinition != nullptr) ? classDefinition->m_parentIdx : 0;
+    }
+
+    return Validation::Mismatch;
+}
+
+void ObjectTreeWalker::timerCallback()
+{
+    // The device does not answer, i.e. because it does not implement GetMembers.
+    m_identityRequests.clear();
+    if (IsRunning())
+        Finish(false);
+    else
+        stopTimer();
+}
+
+void ObjectTreeWalker::RequestNextLevel()
+{
+    AES70_TRACE_SCOPE("ObjectTreeWalker::RequestNextLevel");
+
+    if (m_nextLevelBlocks.empty())
+    {
+        // Blocks which were removed from the device fail to return their members, 
+        // which does not leave the tree incomplete.
+        PruneRemovedObjects();
+        Finish(std::none_of(m_failedBlocks.begin(), m_failedBlocks.end(), 
+                            [this](std::uint32_t blockOno) { return m_objects.count(blockOno) > 0; }));
+        return;
+    }
+
+    // The GetMembers Commands for all blocks of the level are sent at once.
+    bool sent(true);
+    AES70::PduPipeline pipeline([this, &sent](const juce::MemoryBlock& pdu) 
+        { 
+            sent = m_sendFunction(pdu) && sent;
+            return sent;
+        }, MaxMessagesPerPdu);
+
+    for (auto blockOno : m_nextLevelBlocks)
+    {
+        // The member list is not converted by NanoOcp1, so its data type does not matter.
+        NanoOcp1::Ocp1CommandDefinition commandDefinition(blockOno, NanoOcp1::OCP1DATATYPE_BLOB, GetMembersDefLevel, GetMembersMethodIdx);
+        std::uint32_t handle(0); // Auto-generated by Ocp1CommandResponseRequired, replaced by an internal one.
+        NanoOcp1::Ocp1CommandResponseRequired command(commandDefinition, handle);
+        handle = AES70::NextInternalHandle();
+        command.SetHandle(handle);
+        pipeline.Add(command.GetMemoryBlock());
+        m_pendingRequests[handle] = blockOno;
+    }
+    pipeline.Flush();
+
+    m_nextLevelBlocks.clear();
+    m_numRoundTrips++;
+
+    if (!sent)
+    {
+        Finish(false);
+        return;
+    }
+
+    startTimer(ResponseTimeoutMs);
+}
+
+bool ObjectTreeWalker::AddMembers(std::uint32_t containerOno, const AES70::ResponseView& response)
+{
+    // OcaList<OcaObjectIdentification>, where each item holds ONo (Uint32) and OcaClassIdentification, 
+    // i.e. ClassID (Uint16 field count, followed by Uint16 fields) and ClassVersion (Uint16).
+    auto pos = response.m_paramData;
+    auto end = response.m_paramData + response.m_paramDataSize;
+    std::uint16_t numMembers(0);
+    if ((response.m_paramCount != 1) || !AES70::Codec<std::uint16_t>::Decode(pos, end, numMembers))
+        return false;
+
+    const auto& schema = AES70::Schema::GetInstance();
+    std::vector<DiscoveredObject> members;
+    members.reserve(numMembers);
+    for (std::uint16_t i = 0; i < numMembers; i++)
+    {
+        DiscoveredObject member;
+        member.m_containerOno = containerOno;
+
+        std::uint16_t numFields(0);
+        if (!AES70::Codec<std::uint32_t>::Decode(pos, end, member.m_ono))
+            return false;
+
+        auto binaryClassId = pos;
+        if (!AES70::Codec<std::uint16_t>::Decode(pos, end, numFields))
+            return false;
+
+        for (std::uint16_t field = 0; field < numFields; field++)
+        {
+            std::uint16_t fieldValue(0);
+            if (!AES70::Codec<std::uint16_t>::Decode(pos, end, fieldValue))
+                return false;
+
+            member.m_classId << ((field > 0) ? "." : "") << juce::String(fieldValue);
+        }
+
+        member.m_classIdx = schema.GetClassIdxFromBinaryClassId(binaryClassId, static_cast<std::size_t>(pos - binaryClassId));
+        if (!AES70::Codec<std::uint16_t>::Decode(pos, end, member.m_classVersion))
+            return false;
+
+        members.push_back(member);
+    }
+
+    // During revalidation, the members of a block only need to be processed if they changed.
+    auto signatureIter = m_blockSignatures.find(containerOno);
+    if (signatureIter != m_blockSignatures.end())
+    {
+        MemberSignature signature;
+        for (const auto& member : members)
+            signature.Add(member);
+
+        bool isUnchanged = (signature == signatureIter->second);
+        m_blockSignatures.erase(signatureIter);
+        if (isUnchanged)
+            return true;
+
+        // Replace the block's cached members. Those of removed sub-blocks are pruned once the walk has finished.
+        for (auto objectIter = m_objects.begin(); objectIter != m_objects.end(); )
+            objectIter = (objectIter->second.m_containerOno == containerOno) ? m_objects.erase(objectIter) : std::next(objectIter);
+        m_numChangedBlocks++;
+    }
+
+    for (const auto& member : members)
+    {
+        // Each block is walked once, even if the device reports it as member of several blocks.
+        bool isNew = m_objects.emplace(member.m_ono, member).second;
+        if (isNew && IsBlockClassId(member.m_classId))
+            m_nextLevelBlocks.push_back(member.m_ono);
+    }
+
+    return true;
+}
+
+void ObjectTreeWalker::OnDeviceIdentified()
+{
+    if (!IsRunning())
+        stopTimer();
+
+    // Without a serial number, devices of the same model can not be told apart.
+    if (m_identityFields[SerialNumberField].isEmpty())
+        return;
+
+    m_deviceIdentity = m_identityFields.joinIntoString("_");
+
+    // A walk started in the meantime is cached once it has finished.
+    if (IsRunning())
+        return;
+
+    std::map<std::uint32_t, DiscoveredObject> objects;
+    ObjectTreeCache cache(ObjectTreeCache::GetCacheFile(m_deviceIdentity));
+    if (cache.ReadAll(objects) && !objects.empty())
+        Revalidate(std::move(objects));
+}
+
+void ObjectTreeWalker::Revalidate(std::map<std::uint32_t, DiscoveredObject>&& objects)
+{
+    AES70_TRACE_SCOPE("ObjectTreeWalker::Revalidate");
+
+    m_objects = std::move(objects);
+    m_pendingRequests.clear();
+    m_failedBlocks.clear();
+    m_blockSignatures.clear();
+    m_nextLevelBlocks.clear();
+    m_numRoundTrips = 0;
+    m_numChangedBlocks = 0;
+    m_isRevalidation = true;
+
+    // The cached tree can be used right away.
+    m_isComplete = true;
+    m_hasFinished = true;
+
+    // All cached blocks are requested on the first level, regardless of their depth within the tree.
+    for (const auto& onoAndObject : m_objects)
+    {
+        if (IsBlockClassId(onoAndObject.second.m_classId))
+        {
+            m_blockSignatures.emplace(onoAndObject.first, MemberSignature());
+            m_nextLevelBlocks.push_back(onoAndObject.first);
+        }
+    }
+
+    for (const auto& onoAndObject : m_objects)
+    {
+        auto signatureIter = m_blockSignatures.find(onoAndObject.second.m_containerOno);
+        if (signatureIter != m_blockSignatures.end())
+            signatureIter->second.Add(onoAndObject.second);
+    }
+
+    RequestNextLevel();
+}
+
+void ObjectTreeWalker::PruneRemovedObjects()
+{
+    // Repeated until nothing is removed, since removing a block orphans its own members.
+    bool removed(true);
+    while (removed)
+    {
+        removed = false;
+        for (auto objectIter = m_objects.begin(); objectIter != m_objects.end(); )
+        {
+            auto containerOno = objectIter->second.m_containerOno;
+            if ((containerOno != 0) && (m_objects.count(containerOno) == 0))
+            {
+                objectIter = m_objects.erase(objectIter);
+                removed = true;
+            }
+            else
+            {
+                objectIter++;
+            }
+        }
+    }
+}
+
+void ObjectTreeWalker::Finish(bool success)
+{
+    stopTimer();
+    m_pendingRequests.clear();
+    m_nextLevelBlocks.clear();
+    m_blockSignatures.clear();
+    m_isComplete = success;
+    m_hasFinished = true;
+
+    // Cache the tree for later sessions, unless it was revalidated without any changes.
+    // Only encoding the tree happens here, the file is written on a background thread.
+    if (success && m_deviceIdentity.isNotEmpty() && (!m_isRevalidation || (m_numChangedBlocks > 0)))
+    {
+        m_cacheWriter.reset(); // Waits for the previous write, if still ongoing.
+        m_cacheWriter = std::make_unique<ObjectTreeCacheWriter>(m_objects, ObjectTreeCache::GetCacheFile(m_deviceIdentity));
+        m_cacheWriter->startThread();
+    }
+
+    if (OnWalkFinished)
+        OnWalkFinished(success);
+}
@@ -0,0 +1,298 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <map>
+#include <unordered_map>
+
+
+/**
+ * Forward declarations.
+ */
+namespace AES70
+{
+    struct ResponseView;
+}
+class ObjectTreeCacheWriter;
+
+/**
+ * Discovers the objects of the connected device, by walking its tree of OcaBlocks starting from the root block.
+ * The members of all blocks found on one level of the tree are requested with OcaBlock's GetMembers, pipelined 
+ * into as few PDUs as possible, so that the walk takes one network round trip per level instead of one per block. 
+ * GetMembers returns the ClassID of each member along with its ONo, so no further requests per object are needed.
+ * The result is an index from ONo to class, which can be used to create or to validate StringGeneratorPages.
+ * 
+ * Whenever a connection is established, the device's model, serial number and firmware revision are requested.
+ * Walked trees are cached per device identity (See ObjectTreeCache), so that reconnecting to a known device 
+ * makes its cached tree available right away. The cached tree is then revalidated, by requesting the members of 
+ * all its blocks at once and only walking further where a block's members differ from the cached ones.
+ */
+class ObjectTreeWalker : private juce::Timer
+{
+public:
+    /**
+     * ONo of the root block, which AES70 reserves for it.
+     */
+    static constexpr std::uint32_t RootBlockOno = 100;
+
+    /**
+     * An object found on the device.
+     */
+    struct DiscoveredObject
+    {
+        std::uint32_t m_ono = 0;
+        std::uint32_t m_containerOno = 0;   // ONo of the block containing the object. Zero for the root block.
+        juce::String m_classId;             // Dotted ClassID, i.e. "1.1.1.5".
+        std::uint16_t m_classVersion = 0;
+        int m_classIdx = 0;                 // Index of the class within the Schema, or zero if the class is unknown.
+    };
+
+    /**
+     * Result of comparing a command node with the discovered objects (See Validate).
+     */
+    enum class Validation
+    {
+        Unknown = 0,    // The command's ONo or class can not be checked, i.e. no walk has finished yet.
+        Match,          // An object of the command's class exists under the command's ONo.
+        Mismatch,       // The device has no object with the command's ONo, or it is of another class.
+    };
+
+    /**
+     * Function used to send a PDU to the device.
+     *
+     * @param[in] data  The PDU.
+     * @return  True if the PDU could be sent.
+     */
+    using SendFunction = std::function<bool(const juce::MemoryBlock& data)>;
+
+    /**
+     * @param[in] sendFunction  Function used to send PDUs to the device.
+     */
+    explicit ObjectTreeWalker(SendFunction sendFunction);
+    ~ObjectTreeWalker() override;
+
+    /**
+     * Start a new walk, discarding the result of any previous one.
+     *
+     * @param[in] rootOno   ONo of the block to start from.
+     * @return  True if the first request could be sent.
+     */
+    bool Start(std::uint32_t rootOno = RootBlockOno);
+
+    /**
+     * Stop the ongoing walk. The objects found so far are kept.
+     */
+    void Cancel();
+
+    /**
+     * Request the identity of the newly connected device. If a tree of the device is cached, 
+     * it is loaded once the identity is known, and revalidated.
+     */
+    void OnConnectionEstablished();
+
+    /**
+     * Stop the ongoing walk, and forget the identity of the device. The objects found so far are kept.
+     */
+    void OnConnectionLost();
+
+    /**
+     * Check whether a walk is ongoing.
+     *
+     * @return  True while Responses to GetMembers are awaited.
+     */
+    bool IsRunning() const;
+
+    /**
+     * Check whether any Responses are awaited, i.e. also those to the requests identifying the device.
+     *
+     * @return  True if Responses should be passed to HandleResponse.
+     */
+    bool IsAwaitingResponses() const;
+
+    /**
+     * Get the identity of the connected device, under which its tree is cached.
+     *
+     * @return  Model GUID, serial number and firmware revision of the device, or an empty string if unknown.
+     */
+    const juce::String& GetDeviceIdentity() const;
+
+    /**
+     * Process a Response received from the device.
+     *
+     * @param[in] response  The Response.
+     * @return  True if the Response belongs to the walk, false if it should be processed elsewhere.
+     */
+    bool HandleResponse(const AES70::ResponseView& response);
+
+    /**
+     * Get all objects found so far.
+     *
+     * @return  The discovered objects, by ONo.
+     */
+    const std::map<std::uint32_t, DiscoveredObject>& GetObjects() const;
+
+    /**
+     * Get the number of network round trips the last walk took, one per level of the tree.
+     *
+     * @return  Number of round trips.
+     */
+    int GetNumRoundTrips() const;
+
+    /**
+     * Check whether the current or last walk revalidated a cached tree, instead of walking the whole tree.
+     *
+     * @return  True if the objects were loaded from the device's ObjectTreeCache.
+     */
+    bool IsRevalidation() const;
+
+    /**
+     * Get the number of blocks whose members differed from the cached ones during revalidation.
+     *
+     * @return  Number of changed blocks. Zero if the last walk was no revalidation.
+     */
+    int GetNumChangedBlocks() const;
+
+    /**
+     * Compare the ONo and class of a command node with the discovered objects.
+     *
+     * @param[in] command   Node of type CommandModel::CommandType.
+     * @return  The result of the comparison.
+     */
+    Validation Validate(const juce::ValueTree& command) const;
+
+    /**
+     * Callback method that is triggered once a walk has finished.
+     *
+     * @param[in] success   False if the walk was cancelled or timed out, in which case not all objects were found.
+     */
+    std::function<void(bool success)> OnWalkFinished;
+
+
+private:
+    /**
+     * Order-independent summary of the members of a block, used to detect changes during revalidation.
+     */
+    struct MemberSignature
+    {
+        int m_numMembers = 0;
+        std::uint64_t m_hashSum = 0;    // Sum of the hashes of all members' ONo, ClassID and ClassVersion.
+
+        void Add(const DiscoveredObject& member);
+        bool operator==(const MemberSignature& other) const;
+    };
+
+    // Reimplemented from juce::Timer
+
+    void timerCallback() override;
+
+
+    /**
+     * Request the members of all blocks found on the previous level of the tree, or finish the walk if there are none.
+     */
+    void RequestNextLevel();
+
+    /**
+     * Add the members returned by GetMembers to m_objects, and remember the blocks among them for the next level.
+     *
+     * @param[in] containerOno  ONo of the block whose members were requested.
+     * @param[in] response      Response to GetMembers.
+     * @return  False if the Response could not be decoded.
+     */
+    bool AddMembers(std::uint32_t containerOno, const AES70::ResponseView& response);
+
+    /**
+     * Called once all Responses to the requests sent by OnConnectionEstablished have arrived.
+     * Loads and revalidates the device's cached tree, if any.
+     */
+    void OnDeviceIdentified();
+
+    /**
+     * Start revalidating a cached tree, which is used for Validate until revalidation tells otherwise.
+     *
+     * @param[in] objects   Cached objects, by ONo.
+     */
+    void Revalidate(std::map<std::uint32_t, DiscoveredObject>&& objects);
+
+    /**
+     * Remove all objects whose containing block no longer exists, i.e. after a changed block's members were replaced.
+     */
+    void PruneRemovedObjects();
+
+    /**
+     * Stop the walk and notify OnWalkFinished.
+     *
+     * @param[in] success   True if the whole tree was walked.
+     */
+    void Finish(bool success);
+
+    // Function used to send PDUs to the device.
+    SendFunction m_sendFunction;
+
+    // Objects found so far, by ONo.
+    std::map<std::uint32_t, DiscoveredObject> m_objects;
+
+    // Blocks whose members are requested on the next level.
+    std::vector<std::uint32_t> m_nextLevelBlocks;
+
+    // Blocks whose members have been requested, by the handle of the GetMembers Command.
+    std::unordered_map<std::uint32_t, std::uint32_t> m_pendingRequests;
+
+    // Blocks whose members could not be retrieved during the current walk.
+    std::vector<std::uint32_t> m_failedBlocks;
+
+    // Fields of the device identity which have been requested, by the handle of the Command.
+    std::unordered_map<std::uint32_t, int> m_identityRequests;
+
+    // Fields of the device identity received so far.
+    juce::StringArray m_identityFields;
+
+    // See GetDeviceIdentity.
+    juce::String m_deviceIdentity;
+
+    // Members of each cached block which has not been revalidated yet.
+    std::unordered_map<std::uint32_t, MemberSignature> m_blockSignatures;
+
+    // Number of levels requested during the current or last walk.
+    int m_numRoundTrips;
+
+    // See GetNumChangedBlocks.
+    int m_numChangedBlocks;
+
+    // See IsRevalidation.
+    bool m_isRevalidation;
+
+    // True if all blocks found could be walked.
+    bool m_isComplete;
+
+    // True if the current or last walk has finished, so that its result can be used for Validate.
+    bool m_hasFinished;
+
+    // Writes the tree to the device's cache file after a walk, on a background thread.
+    std::unique_ptr<ObjectTreeCacheWriter> m_cacheWriter;
+
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ObjectTreeWalker)
+};
@@ -0,0 +1,191 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#include "ResponseDispatcher.h"
+#include "AES70Codec.h"
+#include "Metrics.h"
+#include "Trace.h"
+#include <unordered_set>
+
+
+static constexpr int TimingWheelTickMs = 10;    // Resolution of the Command deadlines.
+static constexpr int TimeoutCheckIntervalMs = 50; // Interval in which expired deadlines are checked while Commands are pending.
+
+
+/**
+ * Helper method to get the current time on the clock used for the Command deadlines.
+ *
+ * @return  Milliseconds since the system was started.
+ */
+static std::uint64_t GetNowMs()
+{
+    return static_cast<std::uint64_t>(juce::Time::getMillisecondCounterHiRes());
+}
+
+
+//==============================================================================
+// Class ResponseDispatcher
+//==============================================================================
+
+ResponseDispatcher::ResponseDispatcher(SendFunction sendFunction)
+    :   m_sendFunction(std::move(sendFunction)),
+        m_timingWheel(TimingWheelTickMs, GetNowMs())
+{
+    jassert(m_sendFunction != nullptr);
+}
+
+ResponseDispatcher::~ResponseDispatcher()
+{
+    stopTimer();
+}
+
+int ResponseDispatcher::Send(const juce::MemoryBlock& pdu, ResponseCallback callback, int timeoutMs)
+{
+    AES70_TRACE_SCOPE("ResponseDispatcher::Send");
+
+    // Only PDUs which are well-formed as a whole are sent.
+    std::vector<std::uint32_t> handles;
+    if (!AES70::ForEachCommandHandle(pdu.getData(), pdu.getSize(), [&handles](std::uint32_t handle) { handles.push_back(handle); })
+        || handles.empty())
+    {
+        jassertfalse;
+        return 0;
+    }
+
+    // A Response to a handle used twice could not be attributed to the right Command.
+    std::unordered_set<std::uint32_t> uniqueHandles;
+    for (auto handle : handles)
+    {
+        if (IsPending(handle) || !uniqueHandles.insert(handle).second)
+            return 0;
+    }
+
+    if (!m_sendFunction(pdu))
+        return 0;
+
+    // The wheel is not advanced while no Commands are pending, so it is caught up before it is used again.
+    if (m_timingWheel.GetNumTimers() == 0)
+        m_timingWheel.Advance(GetNowMs(), nullptr);
+
+    auto sharedCallback = std::make_shared<const ResponseCallback>(std::move(callback));
+    auto deadlineMs = GetNowMs() + static_cast<std::uint64_t>(juce::jmax(0, timeoutMs));
+    for (auto handle : handles)
+    {
+        PendingRequest request;
+        request.m_callback = sharedCallback;
+        request.m_timerId = m_timingWheel.Schedule(handle, deadlineMs);
+        m_pendingRequests[handle] = std::move(request);
+    }
+
+    UpdateState();
+
+    return static_cast<int>(handles.size());
+}
+
+bool ResponseDispatcher::Cancel(std::uint32_t handle)
+{
+    bool resolved = Resolve(handle, Outcome::Cancelled, nullptr);
+    UpdateState();
+
+    return resolved;
+}
+
+bool ResponseDispatcher::IsPending(std::uint32_t handle) const
+{
+    return m_pendingRequests.find(handle) != m_pendingRequests.end();
+}
+
+bool ResponseDispatcher::HandleResponse(const AES70::ResponseView& response)
+{
+    if (!Resolve(response.m_handle, Outcome::Response, &response))
+        return false;
+
+    UpdateState();
+
+    return true;
+}
+
+int ResponseDispatcher::GetNumPendingRequests() const
+{
+    return static_cast<int>(m_pendingRequests.size());
+}
+
+void ResponseDispatcher::OnConnectionLost()
+{
+    // Callbacks may send new Commands, which fail while offline, so the handles are collected first.
+    std::vector<std::uint32_t> handles;
+    handles.reserve(m_pendingRequests.size());
+    for (const auto& handleAndRequest : m_pendingRequests)
+        handles.push_back(handleAndRequest.first);
+
+    for (auto handle : handles)
+        Resolve(handle, Outcome::ConnectionLost, nullptr);
+
+    UpdateState();
+}
+
+void ResponseDispatcher::timerCallback()
+{
+    AES70_TRACE_SCOPE("ResponseDispatcher::timerCallback");
+
+    int numTimeouts = m_timingWheel.Advance(GetNowMs(), [this](std::uint64_t handle)
+        {
+            Resolve(static_cast<std::uint32_t>(handle), Outcome::Timeout, nullptr);
+        });
+
+    if (numTimeouts > 0)
+        Metrics::GetInstance().Increment(Metrics::REQUEST_TIMEOUTS, numTimeouts);
+
+    UpdateState();
+}
+
+bool ResponseDispatcher::Resolve(std::uint32_t handle, Outcome outcome, const AES70::ResponseView* response)
+{
+    auto requestIter = m_pendingRequests.find(handle);
+    if (requestIter == m_pendingRequests.end())
+        return false;
+
+    // The Command is removed before its callback is called, which may send or cancel Commands itself.
+    // An expired timer has already been removed from the wheel, in which case Cancel does nothing.
+    auto callback = std::move(requestIter->second.m_callback);
+    m_timingWheel.Cancel(requestIter->second.m_timerId);
+    m_pendingRequests.erase(requestIter);
+
+    AES70::ResponseView handleOnly;
+    handleOnly.m_handle = handle;
+    if (callback && *callback)
+        (*callback)(outcome, (response != nullptr) ? *response : handleOnly);
+
+    return true;
+}
+
+void ResponseDispatcher::UpdateState()
+{
+    Metrics::GetInstance().Set(Metrics::REQUESTS_IN_FLIGHT, static_cast<juce::int64>(m_pendingRequests.size()));
+
+    if (m_pendingRequests.empty())
+        stopTimer();
+    else if (!isTimerRunning())
+        startTimer(TimeoutCheckIntervalMs);
+}
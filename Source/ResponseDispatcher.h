@@ -0,0 +1,185 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <unordered_map>
+
+#include "TimingWheel.h"
+
+
+/**
+ * Forward declarations.
+ */
+namespace AES70
+{
+    struct ResponseView;
+}
+
+/**
+ * Sends Commands requiring a Response to the device, and resolves each of them exactly once: with the decoded
+ * Response, with a timeout, with cancellation, or because the connection was lost. Deadlines of all outstanding 
+ * Commands are tracked by a single TimingWheel driven by one juce::Timer, so that many thousands of Commands can 
+ * be in flight at once, i.e. for load tests or when restoring many property values.
+ *
+ * All methods are expected to be called on the message thread, on which the callbacks are called as well.
+ */
+class ResponseDispatcher : private juce::Timer
+{
+public:
+    /**
+     * How a Command was resolved.
+     */
+    enum class Outcome
+    {
+        Response = 0,   // The device's Response was received.
+        Timeout,        // No Response was received in time.
+        Cancelled,      // The Command was cancelled (See Cancel).
+        ConnectionLost, // The connection was lost before the Response was received.
+    };
+
+    /**
+     * Function called once per Command.
+     *
+     * @param[in] outcome   How the Command was resolved.
+     * @param[in] response  The Response if outcome is Outcome::Response, only valid during the call. 
+     *                      Otherwise only its m_handle is set.
+     */
+    using ResponseCallback = std::function<void(Outcome outcome, const AES70::ResponseView& response)>;
+
+    /**
+     * Function used to send a PDU to the device.
+     *
+     * @param[in] data  The PDU.
+     * @return  True if the PDU could be sent.
+     */
+    using SendFunction = std::function<bool(const juce::MemoryBlock& data)>;
+
+    /**
+     * Time after which Commands are resolved with Outcome::Timeout, unless specified otherwise.
+     */
+    static constexpr int DefaultTimeoutMs = 3000;
+
+    /**
+     * @param[in] sendFunction  Function used to send PDUs to the device.
+     */
+    explicit ResponseDispatcher(SendFunction sendFunction);
+    ~ResponseDispatcher() override;
+
+    /**
+     * Send a PDU of Commands requiring a Response, i.e. one pipelined by AES70::PduPipeline.
+     * The callback is called once for each Command of the PDU. Since Responses are only told apart by their handle,
+     * the PDU is not sent if any of its handles occurs twice or is still pending (See IsPending), rather than 
+     * taking over the pending Command.
+     *
+     * @param[in] pdu           PDU of type AES70::PduTypeCommandResponseRequired.
+     * @param[in] callback      Function called once per Command.
+     * @param[in] timeoutMs     Time after which a Command without Response is resolved with Outcome::Timeout.
+     * @return  Number of Commands sent. Zero if the PDU is malformed, holds a handle already in use 
+     *          or could not be sent, in which case the callback is never called.
+     */
+    int Send(const juce::MemoryBlock& pdu, ResponseCallback callback, int timeoutMs = DefaultTimeoutMs);
+
+    /**
+     * Resolve a pending Command with Outcome::Cancelled. A Response arriving later is ignored.
+     *
+     * @param[in] handle    Handle of the Command.
+     * @return  True if the Command was pending.
+     */
+    bool Cancel(std::uint32_t handle);
+
+    /**
+     * Check whether a Command is awaiting its Response.
+     *
+     * @param[in] handle    Handle of the Command.
+     * @return  True if the Command is pending.
+     */
+    bool IsPending(std::uint32_t handle) const;
+
+    /**
+     * Process a Response received from the device.
+     *
+     * @param[in] response  The Response.
+     * @return  True if the Response resolved a pending Command.
+     */
+    bool HandleResponse(const AES70::ResponseView& response);
+
+    /**
+     * Get the number of Commands awaiting their Response.
+     *
+     * @return  Number of pending Commands.
+     */
+    int GetNumPendingRequests() const;
+
+    /**
+     * To be called whenever the connection to the device has been lost.
+     * Resolves all pending Commands with Outcome::ConnectionLost.
+     */
+    void OnConnectionLost();
+
+
+private:
+    /**
+     * A Command awaiting its Response.
+     */
+    struct PendingRequest
+    {
+        std::shared_ptr<const ResponseCallback> m_callback;  // Shared by all Commands of the same PDU.
+        TimingWheel::TimerId m_timerId = TimingWheel::InvalidTimerId;
+    };
+
+
+    // Reimplemented from juce::Timer
+
+    void timerCallback() override;
+
+
+    /**
+     * Remove a pending Command and call its callback.
+     *
+     * @param[in] handle    Handle of the Command.
+     * @param[in] outcome   How the Command was resolved.
+     * @param[in] response  The Response, or nullptr unless outcome is Outcome::Response.
+     * @return  True if the Command was pending.
+     */
+    bool Resolve(std::uint32_t handle, Outcome outcome, const AES70::ResponseView* response);
+
+    /**
+     * Update the metrics and the timer, after Commands have been added or resolved.
+     */
+    void UpdateState();
+
+    // Function used to send PDUs to the device.
+    SendFunction m_sendFunction;
+
+    // Deadlines of all pending Commands, keyed by handle.
+    TimingWheel m_timingWheel;
+
+    // Pending Commands, by handle.
+    std::unordered_map<std::uint32_t, PendingRequest> m_pendingRequests;
+
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ResponseDispatcher)
+};
@@ -26,17 +26,22 @@
 #include "MainTabbedComponent.h"
 #include "Common.h"
 #include "AES70.h"
+#include "AES70Codec.h"
+#include "AES70Components.h"
+#include "AES70Schema.h"
+#include "CommandModel.h"
+#include "SubscriptionManager.h"
+#include "Trace.h"
 
 
-/**
- * Command index used for AddSubscription.
- */
-static constexpr int MethodIndexForAddSubscription = 256;
+static_assert(ClassIndexForCustomClass > AES70::Schema::MaxClassIdx, "Custom class index collides with Schema class indexes");
 
-/**
- * Index used for custom (aka proprietary, non-standard) AES70 classes.
- */
-static constexpr int ClassIndexForCustomClass = 256;
+// Texts shown by the binary string TextEditors while they are empty, unless a value cannot be encoded.
+static const juce::String CommandPlaceholderText("This field will show the specified Command string "
+                                                 "which can be transmitted to a device.");
+static const juce::String ResponsePlaceholderText("This field will show the expected Response "
+                                                  "from the device as a result of the above Command.");
+static const juce::String NotificationPlaceholderText("The following Notification can be expected, ...TODO");
 
 /**
  * Expected user workflow, separated in discrete steps.
@@ -52,6 +57,85 @@ enum WorkflowSteps
     WORKFLOW_STEP_ENTER_RESPONSE_VALUE,
 };
 
+/**
+ * Flags defining which parts of the generated binary strings need to be updated.
+ */
+enum PduUpdateFlags
+{
+    PDU_UPDATE_NONE                 = 0x00,
+    PDU_UPDATE_COMMAND_VALUE        = 0x01, // Only the value bytes of the Command changed.
+    PDU_UPDATE_RESPONSE_VALUE       = 0x02, // Only the value bytes of the Response changed.
+    PDU_UPDATE_NOTIFICATION_VALUE   = 0x04, // Only the value bytes of the Notification changed.
+    PDU_UPDATE_ALL                  = 0x08, // All binary strings need to be re-created.
+};
+
+/**
+ * Interval at which pending binary string updates are applied to the GUI. About one display frame at 60Hz.
+ */
+static constexpr int BinaryStringsUpdateIntervalMs = 16;
+
+/**
+ * Data types offered for the property of the custom AES70 class, in the order shown on its Param Type ComboBox.
+ */
+static constexpr int CustomClassDataTypes[] = {
+    NanoOcp1::OCP1DATATYPE_BOOLEAN, NanoOcp1::OCP1DATATYPE_INT32, NanoOcp1::OCP1DATATYPE_UINT8,
+    NanoOcp1::OCP1DATATYPE_UINT16, NanoOcp1::OCP1DATATYPE_UINT32, NanoOcp1::OCP1DATATYPE_FLOAT32,
+    NanoOcp1::OCP1DATATYPE_STRING, NanoOcp1::OCP1DATATYPE_BLOB,
+    AES70::MakeListDataType(NanoOcp1::OCP1DATATYPE_STRING),     // i.e. position names of an OcaSwitch.
+    AES70::MakeListDataType(NanoOcp1::OCP1DATATYPE_UINT32),     // i.e. ONos of the members of an OcaBlock.
+    AES70::MakeMapDataType(NanoOcp1::OCP1DATATYPE_UINT16, NanoOcp1::OCP1DATATYPE_STRING)
+};
+
+/**
+ * Rows of GUI controls, from top to bottom. Used as bit positions to define which rows need to be re-layouted.
+ */
+enum GuiRows
+{
+    ROW_TITLE = 0,
+    ROW_HYPERLINK,
+    ROW_CLASS,
+    ROW_PROPERTY,
+    ROW_PARAMTYPE,
+    ROW_COMMAND,
+    ROW_SET_VALUE,
+    ROW_COMMAND_STRING,
+    ROW_RESPONSE_VALUE,
+    ROW_RESPONSE_STRING,
+    ROW_NOTIF_VALUE,
+    ROW_NOTIF_STRING,
+    ROW_MAX,
+};
+
+/**
+ * Rows containing value components, which are re-created when the property or command changes.
+ */
+static constexpr int ValueRowsFlags = (1 << ROW_SET_VALUE) | (1 << ROW_RESPONSE_VALUE) | (1 << ROW_NOTIF_VALUE);
+
+/**
+ * All rows of GUI controls.
+ */
+static constexpr int AllRowsFlags = (1 << ROW_MAX) - 1;
+
+/**
+ * CommandModel properties which change when the class, property or command selection changes,
+ * since all controls of the subsequent workflow steps are reset. See StringGeneratorContainer::StoreState.
+ */
+static const std::vector<juce::Identifier> CommandStepProperties = { 
+    CommandModel::Command, CommandModel::CmdDefLevel, CommandModel::Status, 
+    CommandModel::CmdValue, CommandModel::RspValue, CommandModel::NotifValue 
+};
+static const std::vector<juce::Identifier> PropertyStepProperties = { 
+    CommandModel::Property, CommandModel::PropDefLevel, CommandModel::Type, 
+    CommandModel::Command, CommandModel::CmdDefLevel, CommandModel::Status, 
+    CommandModel::CmdValue, CommandModel::RspValue, CommandModel::NotifValue 
+};
+static const std::vector<juce::Identifier> ClassStepProperties = { 
+    CommandModel::Class, CommandModel::Property, CommandModel::PropDefLevel, CommandModel::Type, 
+    CommandModel::Command, CommandModel::CmdDefLevel, CommandModel::Status, 
+    CommandModel::CmdValue, CommandModel::RspValue, CommandModel::NotifValue 
+};
+
+
 /**
  * Indeces of juce::Label components used on the GUI.
  */
@@ -95,11 +179,11 @@ static const std::vector<juce::String> GuiLabelsText = {
 
 
 //==============================================================================
-// Class StringGeneratorPage
+// Class StringGeneratorContainer
 //==============================================================================
 
-StringGeneratorPage::StringGeneratorPage(MainTabbedComponent* const parent)
-    :   AbstractPage(parent), 
+StringGeneratorContainer::StringGeneratorContainer(StringGeneratorPage* const page)
+    :   m_page(page), 
         m_ocaONoTextEditor(juce::TextEditor("OCA ONo")), 
         m_ocaClassComboBox(juce::ComboBox("OCA Class")),
         m_ocaPropertyComboBox(juce::ComboBox("OCA Property Idx")),
@@ -110,27 +194,34 @@ StringGeneratorPage::StringGeneratorPage(MainTabbedComponent* const parent)
         m_ocaCommandHandleTextEditor(juce::TextEditor("OCA Command Handle")),
         m_ocaCommandTextEditor(juce::TextEditor("OCA Command String")),
         m_ocaResponseStatusComboBox(juce::ComboBox("OCA Response Status")),
+        m_ocaReadBackValueLabel(juce::Label("OCA ReadBack Value")),
         m_ocaResponseTextEditor(juce::TextEditor("OCA Response String")),
         m_ocaNotificationTextEditor(juce::TextEditor("OCA Notification String")),
         m_sendButton(juce::TextButton("String Test Button")),
-        m_hyperlink(juce::HyperlinkButton(ProjectHostShortURL, juce::URL(ProjectHostLongURL)))
+        m_hyperlink(juce::HyperlinkButton(ProjectHostShortURL, juce::URL(ProjectHostLongURL))),
+        m_pendingUpdates(PDU_UPDATE_NONE),
+        m_rowBounds(ROW_MAX),
+        m_columnWidth(0),
+        m_startHereImage(juce::ImageCache::getFromMemory(BinaryData::StartHere_png, BinaryData::StartHere_pngSize)),
+        m_applyingState(false)
 {
-    jassert(parent != nullptr);
-
-    m_container.addAndMakeVisible(&m_hyperlink);
-    m_container.addAndMakeVisible(&m_ocaONoTextEditor);
-    m_container.addAndMakeVisible(&m_ocaClassComboBox);
-    m_container.addAndMakeVisible(&m_ocaPropertyComboBox);
-    m_container.addAndMakeVisible(&m_ocaPropertyDefLevelComboBox);
-    m_container.addAndMakeVisible(&m_ocaPropertyParamTypeComboBox);
-    m_container.addAndMakeVisible(&m_ocaCommandComboBox);
-    m_container.addAndMakeVisible(&m_ocaCommandDefLevelComboBox);
-    m_container.addAndMakeVisible(&m_ocaCommandHandleTextEditor);
-    m_container.addAndMakeVisible(&m_ocaCommandTextEditor);
-    m_container.addAndMakeVisible(&m_sendButton);
-    m_container.addAndMakeVisible(&m_ocaResponseStatusComboBox);
-    m_container.addAndMakeVisible(&m_ocaResponseTextEditor);
-    m_container.addChildComponent(&m_ocaNotificationTextEditor); // Invisible until AddSubscription Cmd selected
+    jassert(page != nullptr);
+
+    addAndMakeVisible(&m_hyperlink);
+    addAndMakeVisible(&m_ocaONoTextEditor);
+    addAndMakeVisible(&m_ocaClassComboBox);
+    addAndMakeVisible(&m_ocaPropertyComboBox);
+    addAndMakeVisible(&m_ocaPropertyDefLevelComboBox);
+    addAndMakeVisible(&m_ocaPropertyParamTypeComboBox);
+    addAndMakeVisible(&m_ocaCommandComboBox);
+    addAndMakeVisible(&m_ocaCommandDefLevelComboBox);
+    addAndMakeVisible(&m_ocaCommandHandleTextEditor);
+    addAndMakeVisible(&m_ocaCommandTextEditor);
+    addAndMakeVisible(&m_sendButton);
+    addAndMakeVisible(&m_ocaResponseStatusComboBox);
+    addAndMakeVisible(&m_ocaResponseTextEditor);
+    addChildComponent(&m_ocaNotificationTextEditor); // Invisible until AddSubscription Cmd selected
+    addChildComponent(&m_ocaReadBackValueLabel); // Invisible until a Response was received
 
     m_ocaONoTextEditor.setHasFocusOutline(true);
     m_ocaONoTextEditor.setInputRestrictions(0, "0123456789");
@@ -147,7 +238,7 @@ StringGeneratorPage::StringGeneratorPage(MainTabbedComponent* const parent)
     m_ocaResponseStatusComboBox.setHasFocusOutline(true);
 
     m_ocaCommandHandleTextEditor.setHasFocusOutline(true);
-    m_ocaCommandHandleTextEditor.setInputRestrictions(0, "0123456789");
+    m_ocaCommandHandleTextEditor.setInputRestrictions(10, "0123456789"); // Enough digits for AES70::LastUserHandle.
     m_ocaCommandHandleTextEditor.setIndents(m_ocaCommandHandleTextEditor.getLeftIndent(), 0); // Hack for JUCE justification bug
     m_ocaCommandHandleTextEditor.setJustification(juce::Justification(juce::Justification::centredRight));
     m_ocaCommandHandleTextEditor.setText("1", false);
@@ -156,9 +247,7 @@ StringGeneratorPage::StringGeneratorPage(MainTabbedComponent* const parent)
     m_ocaCommandTextEditor.setReadOnly(true);
     m_ocaCommandTextEditor.setCaretVisible(false);
     m_ocaCommandTextEditor.setMultiLine(true, true);
-    m_ocaCommandTextEditor.setTextToShowWhenEmpty("This field will show the specified Command string "
-        "which can be transmitted to a device.", 
-        LabelEnabledTextColour);
+    m_ocaCommandTextEditor.setTextToShowWhenEmpty(CommandPlaceholderText, LabelEnabledTextColour);
 
     m_sendButton.setButtonText("Test");
     m_sendButton.setHasFocusOutline(true);
@@ -166,20 +255,21 @@ StringGeneratorPage::StringGeneratorPage(MainTabbedComponent* const parent)
     m_sendButton.setColour(juce::TextButton::ColourIds::textColourOffId, LabelEnabledTextColour);
     m_sendButton.setTooltip("Test by transmitting the string to the device."); // TODO: tooltips don't work
 
+    m_ocaReadBackValueLabel.setJustificationType(juce::Justification::centredLeft);
+    m_ocaReadBackValueLabel.setTooltip("Value returned by the device");
+
     m_ocaResponseTextEditor.setHasFocusOutline(true);
     m_ocaResponseTextEditor.setReadOnly(true);
     m_ocaResponseTextEditor.setCaretVisible(false);
     m_ocaResponseTextEditor.setMultiLine(true, true);
-    m_ocaResponseTextEditor.setTextToShowWhenEmpty("This field will show the expected Response "
-        "from the device as a result of the above Command.", 
-        LabelEnabledTextColour);
+    m_ocaResponseTextEditor.setTextToShowWhenEmpty(ResponsePlaceholderText, LabelEnabledTextColour);
 
     m_ocaNotificationTextEditor.setHasFocusOutline(true);
     m_ocaNotificationTextEditor.setReadOnly(true);
     m_ocaNotificationTextEditor.setCaretVisible(false);
     m_ocaNotificationTextEditor.setMultiLine(true, true);
     m_ocaNotificationTextEditor.setVisible(false); // Invisible until AddSubscription Cmd selected
-    m_ocaNotificationTextEditor.setTextToShowWhenEmpty("The following Notification can be expected, ...TODO", LabelEnabledTextColour);
+    m_ocaNotificationTextEditor.setTextToShowWhenEmpty(NotificationPlaceholderText, LabelEnabledTextColour);
 
     // Add all OCA status and status strings to m_ocaResponseStatusComboBox
     for (int statusIdx = 0; statusIdx < 16; statusIdx++)
@@ -201,7 +291,8 @@ StringGeneratorPage::StringGeneratorPage(MainTabbedComponent* const parent)
             m_ocaLabels.at(labelIdx)->setColour(juce::Label::textColourId, LabelEnabledTextColour);
 
         m_ocaLabels.at(labelIdx)->setText(GuiLabelsText.at(labelIdx), juce::dontSendNotification);
-        m_container.addAndMakeVisible(m_ocaLabels.back().get());
+        m_ocaLabels.at(labelIdx)->setBufferedToImage(true); // Labels rarely change, so avoid re-rendering their text.
+        addAndMakeVisible(m_ocaLabels.back().get());
     }
 
     // Set same font as the labels.
@@ -209,16 +300,22 @@ StringGeneratorPage::StringGeneratorPage(MainTabbedComponent* const parent)
     m_hyperlink.setJustificationType(juce::Justification::topRight);
     m_hyperlink.setTooltip(ProjectHostLongURL); // TODO: get tooltip to work
 
-    for (int classIdx = AES70::OCA_ROOT; classIdx < AES70::OCA_MAX_CLASS_IDX; classIdx++)
+    // Standard classes first, then any proprietary classes loaded from a schema file.
+    const auto& schema = AES70::Schema::GetInstance();
+    for (int classIdx = AES70::OCA_ROOT; classIdx <= schema.GetNumClasses(); classIdx++)
     {
-        m_ocaClassComboBox.addItem(AES70::MapOfClassNamesAndIds.at(classIdx), classIdx);
+        if (classIdx == schema.GetNumStandardClasses() + 1)
+            m_ocaClassComboBox.addSeparator();
+
+        m_ocaClassComboBox.addItem(schema.GetClassText(classIdx), classIdx);
     }
     m_ocaClassComboBox.addSeparator();
     m_ocaClassComboBox.addItem("Custom", ClassIndexForCustomClass);
 
     m_ocaONoTextEditor.onTextChange = [=]()
     {
-        UpdateBinaryStrings();
+        StoreState({ CommandModel::Ono });
+        ScheduleBinaryStringsUpdate(PDU_UPDATE_ALL);
     };
 
     m_ocaClassComboBox.onChange = [=]()
@@ -259,6 +356,8 @@ StringGeneratorPage::StringGeneratorPage(MainTabbedComponent* const parent)
 
         // Remove StartHere icon
         repaint();
+
+        StoreState(ClassStepProperties);
     };
 
     m_ocaPropertyComboBox.onChange = [=]()
@@ -276,16 +375,19 @@ StringGeneratorPage::StringGeneratorPage(MainTabbedComponent* const parent)
                 const auto& propertyList = m_ocaObject->GetProperties();
                 const auto& prop = propertyList.at(propIdx - 1);
 
-                // Update m_ocaCommandComboBox to contain the standard Get and Set methods, 
-                // which "most" AES70 classes have at indexes 1 and 2, resp.
+                // Update m_ocaCommandComboBox to contain the Get and Set methods of the property,
+                // named as in the Schema, i.e. "1: GetGain".
+                const auto& schema = AES70::Schema::GetInstance();
+                auto getMethod = schema.GetMethodDefinition(m_ocaObject->GetClassIdx(), prop.m_defLevel, prop.m_getMethodIdx);
+                auto setMethod = schema.GetMethodDefinition(m_ocaObject->GetClassIdx(), prop.m_defLevel, prop.m_setMethodIdx);
                 if (prop.m_getMethodIdx != 0)
                 {
-                    m_ocaCommandComboBox.addItem(juce::String(prop.m_getMethodIdx) + ": GetValue", 
+                    m_ocaCommandComboBox.addItem(juce::String(prop.m_getMethodIdx) + ": " + (getMethod ? getMethod->m_name : "GetValue"), 
                                                  prop.m_getMethodIdx);
                 }
                 if (prop.m_setMethodIdx != 0)
                 {
-                    m_ocaCommandComboBox.addItem(juce::String(prop.m_setMethodIdx) + ": SetValue",
+                    m_ocaCommandComboBox.addItem(juce::String(prop.m_setMethodIdx) + ": " + (setMethod ? setMethod->m_name : "SetValue"),
                                                  prop.m_setMethodIdx);
                 }
 
@@ -296,7 +398,7 @@ StringGeneratorPage::StringGeneratorPage(MainTabbedComponent* const parent)
 
                 // Update m_ocaPropertyParamTypeComboBox to display the data type
                 // of the selected Property (Read-only!)
-                m_ocaPropertyParamTypeComboBox.addItem(NanoOcp1::DataTypeToString(prop.m_type), prop.m_type);
+                m_ocaPropertyParamTypeComboBox.addItem(AES70::Schema::GetDataTypeName(prop.m_type), prop.m_type);
                 m_ocaPropertyParamTypeComboBox.setSelectedId(prop.m_type, juce::dontSendNotification);
             }
 
@@ -323,14 +425,9 @@ StringGeneratorPage::StringGeneratorPage(MainTabbedComponent* const parent)
                 m_ocaPropertyDefLevelComboBox.setEnabled(true);
                 m_ocaLabels.at(LABELIDX_PROP_DEFLEVEL)->setColour(juce::Label::textColourId, LabelEnabledTextColour);
 
-                // Add supported data types defined in NanoOcp1 to m_ocaPropertyParamTypeComboBox and allow user changes.
-                m_ocaPropertyParamTypeComboBox.addItem(NanoOcp1::DataTypeToString(NanoOcp1::OCP1DATATYPE_BOOLEAN), NanoOcp1::OCP1DATATYPE_BOOLEAN);
-                m_ocaPropertyParamTypeComboBox.addItem(NanoOcp1::DataTypeToString(NanoOcp1::OCP1DATATYPE_INT32), NanoOcp1::OCP1DATATYPE_INT32);
-                m_ocaPropertyParamTypeComboBox.addItem(NanoOcp1::DataTypeToString(NanoOcp1::OCP1DATATYPE_UINT8), NanoOcp1::OCP1DATATYPE_UINT8);
-                m_ocaPropertyParamTypeComboBox.addItem(NanoOcp1::DataTypeToString(NanoOcp1::OCP1DATATYPE_UINT16), NanoOcp1::OCP1DATATYPE_UINT16);
-                m_ocaPropertyParamTypeComboBox.addItem(NanoOcp1::DataTypeToString(NanoOcp1::OCP1DATATYPE_UINT32), NanoOcp1::OCP1DATATYPE_UINT32);
-                m_ocaPropertyParamTypeComboBox.addItem(NanoOcp1::DataTypeToString(NanoOcp1::OCP1DATATYPE_FLOAT32), NanoOcp1::OCP1DATATYPE_FLOAT32);
-                m_ocaPropertyParamTypeComboBox.addItem(NanoOcp1::DataTypeToString(NanoOcp1::OCP1DATATYPE_STRING), NanoOcp1::OCP1DATATYPE_STRING);
+                // Add supported data types to m_ocaPropertyParamTypeComboBox and allow user changes.
+                for (auto dataType : CustomClassDataTypes)
+                    m_ocaPropertyParamTypeComboBox.addItem(AES70::Schema::GetDataTypeName(dataType), dataType);
                 m_ocaPropertyParamTypeComboBox.setSelectedId(NanoOcp1::OCP1DATATYPE_BOOLEAN, juce::dontSendNotification);
                 m_ocaPropertyParamTypeComboBox.setEnabled(true);
                 m_ocaLabels.at(LABELIDX_PROP_PARAMTYPE)->setColour(juce::Label::textColourId, LabelEnabledTextColour);
@@ -350,6 +447,8 @@ StringGeneratorPage::StringGeneratorPage(MainTabbedComponent* const parent)
             m_ocaCommandComboBox.addItem("AddSubscription", MethodIndexForAddSubscription);
             m_ocaCommandComboBox.setEnabled(true);
         }
+
+        StoreState(PropertyStepProperties);
     };
 
     m_ocaPropertyDefLevelComboBox.onChange = [=]()
@@ -360,7 +459,8 @@ StringGeneratorPage::StringGeneratorPage(MainTabbedComponent* const parent)
             auto customObj = static_cast<AES70::OcaCustomClass*>(m_ocaObject.get());
             customObj->m_customProp.m_defLevel = m_ocaPropertyDefLevelComboBox.getSelectedId();
 
-            UpdateBinaryStrings();
+            StoreState({ CommandModel::PropDefLevel });
+            ScheduleBinaryStringsUpdate(PDU_UPDATE_ALL);
         }
     };
 
@@ -373,7 +473,8 @@ StringGeneratorPage::StringGeneratorPage(MainTabbedComponent* const parent)
             customObj->m_customProp.m_type = m_ocaPropertyParamTypeComboBox.getSelectedId();
 
             CreateValueComponents();
-            UpdateBinaryStrings();
+            StoreState({ CommandModel::Type, CommandModel::CmdValue, CommandModel::RspValue, CommandModel::NotifValue });
+            ScheduleBinaryStringsUpdate(PDU_UPDATE_ALL);
         }
     };
 
@@ -426,202 +527,306 @@ StringGeneratorPage::StringGeneratorPage(MainTabbedComponent* const parent)
             }
 
             CreateValueComponents();
-            UpdateBinaryStrings();
+            ScheduleBinaryStringsUpdate(PDU_UPDATE_ALL);
         }
+
+        StoreState(CommandStepProperties);
     };
 
     m_ocaCommandDefLevelComboBox.onChange = [=]()
     {
-        UpdateBinaryStrings();
+        StoreState({ CommandModel::CmdDefLevel });
+        ScheduleBinaryStringsUpdate(PDU_UPDATE_ALL);
     };
 
     m_ocaCommandHandleTextEditor.onTextChange = [=]()
     {
-        UpdateBinaryStrings();
+        StoreState({ CommandModel::Handle });
+        ScheduleBinaryStringsUpdate(PDU_UPDATE_ALL);
     };
 
     m_ocaResponseStatusComboBox.onChange = [=]()
     {
-        UpdateBinaryStrings();
+        StoreState({ CommandModel::Status });
+        ScheduleBinaryStringsUpdate(PDU_UPDATE_ALL);
     };
 
     m_sendButton.onClick = [=]()
     {
         DBG("m_sendButton.onClick");
         
+        // The page's CommandModel node is always up to date, even if the displayed strings are not yet.
         juce::MemoryBlock commandMemBlock;
         juce::MemoryBlock responseMemBlock;
         juce::MemoryBlock notificationMemBlock;
-        CreateBinaryStrings(commandMemBlock, responseMemBlock, notificationMemBlock);
+        juce::String encodeError;
+        if (!CommandModel::CreateBinaryStrings(m_page->GetState(), commandMemBlock, responseMemBlock, notificationMemBlock, nullptr, &encodeError))
+        {
+            ShowEncodeError(encodeError);
+            return;
+        }
 
-        // Pass command MemoryBlock to the parent MainTabbedComponent.
-        GetMainComponent()->SendCommandToDevice(commandMemBlock);
+        // Pass command MemoryBlock to the parent MainTabbedComponent, which passes the Response back.
+        auto mainComponent = m_page->GetMainComponent();
+        if (!mainComponent->SendCommandToDevice(commandMemBlock, m_page))
+            return;
+
+        // Have subscriptions re-established after reconnecting, and removed on exit.
+        std::uint32_t ono(0);
+        int defLevel(0), propIndex(0), dataType(0);
+        if (CommandModel::GetSubscribedProperty(m_page->GetState(), ono, defLevel, propIndex, dataType))
+            mainComponent->GetSubscriptionManager().Add(ono, defLevel, propIndex, dataType, false);
     };
 
     setSize(AppWindowDefaultWidth, AppWindowDefaultHeight);
-    setViewedComponent(&m_container, false);
 
     ResetComponents(WORKFLOW_STEP_SELECT_CLASS);
 }
 
-StringGeneratorPage::~StringGeneratorPage()
+StringGeneratorContainer::~StringGeneratorContainer()
 {
+    stopTimer();
 }
 
-StringGeneratorPage* StringGeneratorPage::CreatePageFromXmlElement(const juce::XmlElement* const aes70CommandElement,
-                                                                   MainTabbedComponent* const parent)
+void StringGeneratorContainer::ApplyState()
 {
-    // Gatekeeper checks
-    if ((parent == nullptr) ||
-        (aes70CommandElement == nullptr) ||
-        (aes70CommandElement->getTagName() != "AES70Command"))
-        return nullptr;
-
-    // Create an empty page
-    StringGeneratorPage* pPage = new StringGeneratorPage(parent);
-    if (pPage == nullptr)
-        return nullptr;
-
-    // Set the new page's component name, which will be used as its tab name.
-    juce::String pageName("Page " + juce::String(parent->getNumTabs()));
-    if (aes70CommandElement->hasAttribute("name"))
-        pageName = aes70CommandElement->getStringAttribute("name");
-    pPage->setName(pageName);
+    // Pages which were released before any selection was made contain empty properties,
+    // which must not be applied (an empty string would match the first item of any ComboBox).
+    auto state = m_page->GetState();
+    auto hasProperty = [&state](const juce::Identifier& property)
+    {
+        return state.getProperty(property).toString().isNotEmpty();
+    };
+    auto getProperty = [&state](const juce::Identifier& property)
+    {
+        return state.getProperty(property).toString();
+    };
 
     // Simulating the user's workflow, we set component values synchronously to ensure that items are added
     // to the ComboBoxes BEFORE the value of those ComboBoxes are set programatically.
     juce::NotificationType notification = juce::sendNotificationSync;
 
+    // The intermediate configurations while applying must not overwrite the page's state.
+    const juce::ScopedValueSetter<bool> applyingState(m_applyingState, true);
+
     // class
-    if (aes70CommandElement->hasAttribute("class"))
+    if (hasProperty(CommandModel::Class))
     {
-        SelectComboBoxItemByText(pPage->m_ocaClassComboBox,
-                                 aes70CommandElement->getStringAttribute("class"),
-                                 notification);
+        // Class item ids are the class indexes, so that Schema classes need no search through the items.
+        auto classIdx = AES70::OcaRoot::GetClassIdxFromName(getProperty(CommandModel::Class));
+        if (classIdx != 0)
+            m_ocaClassComboBox.setSelectedId(classIdx, notification);
+        else
+            SelectComboBoxItemByText(m_ocaClassComboBox,
+                                     getProperty(CommandModel::Class),
+                                     notification);
     }
 
     // ono
-    if (aes70CommandElement->hasAttribute("ono"))
+    if (hasProperty(CommandModel::Ono))
     {
-        int onoInt = jmax<int>(0, aes70CommandElement->getStringAttribute("ono").getIntValue());
-        pPage->m_ocaONoTextEditor.setText(juce::String(onoInt), true);
+        int onoInt = jmax<int>(0, getProperty(CommandModel::Ono).getIntValue());
+        m_ocaONoTextEditor.setText(juce::String(onoInt), true);
     }
 
     // property
-    if (aes70CommandElement->hasAttribute("property"))
+    if (hasProperty(CommandModel::Property))
     {
-        SelectComboBoxItemByText(pPage->m_ocaPropertyComboBox,
-                                 aes70CommandElement->getStringAttribute("property"),
+        SelectComboBoxItemByText(m_ocaPropertyComboBox,
+                                 getProperty(CommandModel::Property),
                                  notification);
     }
 
     // propDefLevel
-    if (aes70CommandElement->hasAttribute("propDefLevel"))
+    if (hasProperty(CommandModel::PropDefLevel))
     {
-        SelectComboBoxItemByText(pPage->m_ocaPropertyDefLevelComboBox,
-                                 aes70CommandElement->getStringAttribute("propDefLevel"),
+        SelectComboBoxItemByText(m_ocaPropertyDefLevelComboBox,
+                                 getProperty(CommandModel::PropDefLevel),
                                  notification);
     }
 
     // type
-    if (aes70CommandElement->hasAttribute("type"))
+    if (hasProperty(CommandModel::Type))
     {
-        SelectComboBoxItemByText(pPage->m_ocaPropertyParamTypeComboBox,
-                                 aes70CommandElement->getStringAttribute("type"),
+        SelectComboBoxItemByText(m_ocaPropertyParamTypeComboBox,
+                                 getProperty(CommandModel::Type),
                                  notification);
     }
 
     // command
-    if (aes70CommandElement->hasAttribute("command"))
+    if (hasProperty(CommandModel::Command))
     {
-        SelectComboBoxItemByText(pPage->m_ocaCommandComboBox,
-                                 aes70CommandElement->getStringAttribute("command"),
-                                 notification);
+        // Commands of Schema classes are selected by their method index, so that config files  
+        // written before the methods were named, i.e. "2: SetValue" instead of "2: SetGain", still load.
+        auto methodIdx = getProperty(CommandModel::Command).getIntValue();
+        if ((m_ocaClassComboBox.getSelectedId() != ClassIndexForCustomClass) 
+            && (methodIdx > 0) && (m_ocaCommandComboBox.indexOfItemId(methodIdx) >= 0))
+            m_ocaCommandComboBox.setSelectedId(methodIdx, notification);
+        else
+            SelectComboBoxItemByText(m_ocaCommandComboBox,
+                                     getProperty(CommandModel::Command),
+                                     notification);
     }
 
     // cmdDefLevel
-    if (aes70CommandElement->hasAttribute("cmdDefLevel"))
+    if (hasProperty(CommandModel::CmdDefLevel))
     {
-        SelectComboBoxItemByText(pPage->m_ocaCommandDefLevelComboBox,
-                                 aes70CommandElement->getStringAttribute("cmdDefLevel"),
+        SelectComboBoxItemByText(m_ocaCommandDefLevelComboBox,
+                                 getProperty(CommandModel::CmdDefLevel),
                                  notification);
     }
 
     // handle
-    if (aes70CommandElement->hasAttribute("handle"))
+    if (hasProperty(CommandModel::Handle))
     {
-        int handleInt = jmax<int>(1, aes70CommandElement->getStringAttribute("handle").getIntValue());
-        pPage->m_ocaCommandHandleTextEditor.setText(juce::String(handleInt), true);
+        auto handle = AES70::ClampUserHandle(getProperty(CommandModel::Handle).toString().getLargeIntValue());
+        m_ocaCommandHandleTextEditor.setText(juce::String(handle), true);
     }
 
     // status
-    if (aes70CommandElement->hasAttribute("status"))
+    if (hasProperty(CommandModel::Status))
     {
-        SelectComboBoxItemByText(pPage->m_ocaResponseStatusComboBox,
-                                 aes70CommandElement->getStringAttribute("status"),
+        SelectComboBoxItemByText(m_ocaResponseStatusComboBox,
+                                 getProperty(CommandModel::Status),
                                  notification);
     }
 
     // cmdValue
-    if (aes70CommandElement->hasAttribute("cmdValue"))
+    if (hasProperty(CommandModel::CmdValue))
     {
-        SetComponentValueFromString(pPage->m_ocaSetCommandValueComponent.get(),
-                                    aes70CommandElement->getStringAttribute("cmdValue"),
+        SetComponentValueFromString(m_ocaSetCommandValueComponent.get(),
+                                    getProperty(CommandModel::CmdValue),
                                     notification);
     }
 
     // rspValue
-    if (aes70CommandElement->hasAttribute("rspValue"))
+    if (hasProperty(CommandModel::RspValue))
     {
-        SetComponentValueFromString(pPage->m_ocaResponseValueComponent.get(),
-                                    aes70CommandElement->getStringAttribute("rspValue"),
+        SetComponentValueFromString(m_ocaResponseValueComponent.get(),
+                                    getProperty(CommandModel::RspValue),
                                     notification);
     }
 
     // notifValue
-    if (aes70CommandElement->hasAttribute("notifValue"))
+    if (hasProperty(CommandModel::NotifValue))
     {
-        SetComponentValueFromString(pPage->m_ocaNotificationValueComponent.get(),
-                                    aes70CommandElement->getStringAttribute("notifValue"),
+        SetComponentValueFromString(m_ocaNotificationValueComponent.get(),
+                                    getProperty(CommandModel::NotifValue),
                                     notification);
     }
-
-    return pPage;
 }
 
-XmlElement* StringGeneratorPage::CreateXmlElementFromPage() const
+void StringGeneratorContainer::StoreState(const std::vector<juce::Identifier>& properties)
 {
-    XmlElement* element = new XmlElement("AES70Command");
-
-    element->setAttribute("name", getName());
-    element->setAttribute("class", m_ocaClassComboBox.getText());
-    element->setAttribute("ono", m_ocaONoTextEditor.getText());
-    element->setAttribute("property", m_ocaPropertyComboBox.getText());
-    element->setAttribute("propDefLevel", m_ocaPropertyDefLevelComboBox.getText());
-    element->setAttribute("type", m_ocaPropertyParamTypeComboBox.getText());
-    element->setAttribute("command", m_ocaCommandComboBox.getText());
-    element->setAttribute("cmdDefLevel", m_ocaCommandDefLevelComboBox.getText());
-    element->setAttribute("handle", m_ocaCommandHandleTextEditor.getText());
-    element->setAttribute("status", m_ocaResponseStatusComboBox.getText());
-
-    // Add cmdValue, rspValue or notifValue attributes depending on which components are available.
-    if (m_ocaSetCommandValueComponent)
+    if (m_applyingState)
+        return;
+
+    auto state = m_page->GetState();
+    for (const auto& property : properties)
     {
-        element->setAttribute("cmdValue", GetComponentValueAsString(m_ocaSetCommandValueComponent.get()));
+        auto value = GetControlValue(property);
+        if (value.isVoid())
+            state.removeProperty(property, nullptr);
+        else
+            state.setProperty(property, value, nullptr);
     }
-    if (m_ocaResponseValueComponent)
+}
+
+juce::var StringGeneratorContainer::GetControlValue(const juce::Identifier& property) const
+{
+    if (property == CommandModel::Class)
+        return m_ocaClassComboBox.getText();
+    else if (property == CommandModel::Ono)
+        return m_ocaONoTextEditor.getText();
+    else if (property == CommandModel::Property)
+        return m_ocaPropertyComboBox.getText();
+    else if (property == CommandModel::PropDefLevel)
+        return m_ocaPropertyDefLevelComboBox.getText();
+    else if (property == CommandModel::Type)
+        return m_ocaPropertyParamTypeComboBox.getText();
+    else if (property == CommandModel::Command)
+        return m_ocaCommandComboBox.getText();
+    else if (property == CommandModel::CmdDefLevel)
+        return m_ocaCommandDefLevelComboBox.getText();
+    else if (property == CommandModel::Handle)
+        return juce::String(AES70::ClampUserHandle(m_ocaCommandHandleTextEditor.getText().getLargeIntValue()));
+    else if (property == CommandModel::Status)
+        return m_ocaResponseStatusComboBox.getText();
+
+    // Value properties only exist while the corresponding value components do.
+    else if ((property == CommandModel::CmdValue) && m_ocaSetCommandValueComponent)
+        return GetComponentValueAsString(m_ocaSetCommandValueComponent.get());
+    else if ((property == CommandModel::RspValue) && m_ocaResponseValueComponent)
+        return GetComponentValueAsString(m_ocaResponseValueComponent.get());
+    else if ((property == CommandModel::NotifValue) && m_ocaNotificationValueComponent)
+        return GetComponentValueAsString(m_ocaNotificationValueComponent.get());
+
+    return juce::var();
+}
+
+void StringGeneratorContainer::ShowReadBackValue(const AES70::CommandHeader& command, const AES70::ResponseView& response)
+{
+    AES70_TRACE_SCOPE("StringGeneratorContainer::ShowReadBackValue");
+
+    // Only the Responses to Get commands contain a value.
+    AES70::Property prop;
+    if (!m_ocaResponseValueComponent || !GetSelectedProperty(prop))
+        return;
+
+    // The page may have been switched to another object or property since the Command was sent.
+    AES70::CommandHeader currentCommand;
+    if (!AES70::GetCommandHeader(m_commandPdu.m_memBlock.getData(), m_commandPdu.m_memBlock.getSize(), currentCommand)
+        || !currentCommand.HasSameMethod(command))
+        return;
+
+    juce::String readBackText;
+    bool matchesExpected(false);
+    if (response.m_status != 0 /* OCASTATUS_OK */)
     {
-        element->setAttribute("rspValue", GetComponentValueAsString(m_ocaResponseValueComponent.get()));
+        readBackText = NanoOcp1::StatusToString(response.m_status);
     }
-    if (m_ocaNotificationValueComponent)
+    else
     {
-        element->setAttribute("notifValue", GetComponentValueAsString(m_ocaNotificationValueComponent.get()));
+        // The value is the first parameter, possibly followed by further ones (i.e. minimum and maximum).
+        auto codec = AES70::GetValueCodec(prop.m_type);
+        auto valueData = response.m_paramData;
+        if ((codec == nullptr) || (response.m_paramCount == 0)
+            || !codec->m_decode(valueData, response.m_paramData + response.m_paramDataSize, readBackText))
+        {
+            readBackText = "Invalid value";
+        }
+        else
+        {
+            // Compare the received value bytes with those of the generated Response, in place.
+            auto valueSize = static_cast<std::size_t>(valueData - response.m_paramData);
+            const auto& expectedPdu = m_responsePdu;
+            matchesExpected = (expectedPdu.m_paramDataSize == valueSize)
+                && (std::memcmp(static_cast<const std::uint8_t*>(expectedPdu.m_memBlock.getData()) + expectedPdu.m_paramDataOffset,
+                                response.m_paramData, valueSize) == 0);
+        }
     }
 
-    return element;
+    ShowReadBackText(readBackText, matchesExpected ? ReadBackMatchColour : ReadBackMismatchColour);
 }
 
-void StringGeneratorPage::UpdateConnectionStatus(ConnectionStatus status)
+void StringGeneratorContainer::ShowReadBackMessage(const juce::String& message)
+{
+    if (m_ocaResponseValueComponent)
+        ShowReadBackText(message, ReadBackMismatchColour);
+}
+
+void StringGeneratorContainer::ShowReadBackText(const juce::String& text, const juce::Colour& colour)
+{
+    m_ocaReadBackValueLabel.setText(text, juce::dontSendNotification);
+    m_ocaReadBackValueLabel.setColour(juce::Label::textColourId, colour);
+    if (!m_ocaReadBackValueLabel.isVisible())
+    {
+        m_ocaReadBackValueLabel.setVisible(true);
+        LayoutRows(1 << ROW_RESPONSE_VALUE);
+    }
+}
+
+void StringGeneratorContainer::UpdateConnectionStatus(ConnectionStatus status)
 {
     bool testButtonEnabled(false);
     switch (status)
@@ -639,14 +844,22 @@ void StringGeneratorPage::UpdateConnectionStatus(ConnectionStatus status)
     m_sendButton.setEnabled(testButtonEnabled);
 }
 
-void StringGeneratorPage::ResetComponents(int step)
+void StringGeneratorContainer::ResetComponents(int step)
 {
+    AES70_TRACE_SCOPE("StringGeneratorContainer::ResetComponents");
     DBG("ResetComponents step " + juce::String(step));
 
     bool resizeNeeded(false);
     m_ocaCommandTextEditor.clear();
     m_ocaResponseTextEditor.clear();
     m_sendButton.setEnabled(false);
+
+    // Discard the previously generated strings, and any updates still pending for them.
+    stopTimer();
+    m_pendingUpdates = PDU_UPDATE_NONE;
+    m_commandPdu.Clear();
+    m_responsePdu.Clear();
+    m_notificationPdu.Clear();
     if (step < WORKFLOW_STEP_ENTER_SET_VALUE)
     {
         // Reset status back to OK
@@ -673,6 +886,12 @@ void StringGeneratorPage::ResetComponents(int step)
         m_ocaLabels.at(LABELIDX_RESP_VALUE)->setVisible(false);
         m_ocaLabels.at(LABELIDX_NOTIF_VALUE)->setVisible(false);
 
+        if (m_ocaReadBackValueLabel.isVisible())
+        {
+            m_ocaReadBackValueLabel.setVisible(false);
+            resizeNeeded = true;
+        }
+
         m_ocaCommandDefLevelComboBox.clear();
         m_ocaCommandDefLevelComboBox.setEnabled(false);
 
@@ -710,13 +929,15 @@ void StringGeneratorPage::ResetComponents(int step)
         m_ocaClassComboBox.setEnabled(false);
     }
 
-    // Hiding or removing components may change the size of the m_container in the Viewport.
+    // Hiding or removing components may change the size of the container in the Viewport.
     if (resizeNeeded)
-        resized();
+        UpdateSize(ValueRowsFlags);
 }
 
-void StringGeneratorPage::CreateValueComponents()
+void StringGeneratorContainer::CreateValueComponents()
 {
+    AES70_TRACE_SCOPE("StringGeneratorContainer::CreateValueComponents");
+
     int propIdx = m_ocaPropertyComboBox.getSelectedId();
     int methodIdx = m_ocaCommandComboBox.getSelectedId();
     if ((propIdx <= 0) || (methodIdx <= 0))
@@ -749,13 +970,37 @@ void StringGeneratorPage::CreateValueComponents()
         setMethodSelected = (methodIdx > 8) && (methodIdx <= 16);
     }
 
+    // Value changes only affect the value bytes of the binary string containing that value.
+    int valueUpdateFlag(PDU_UPDATE_ALL);
+    juce::Identifier valueId;
+    if (getMethodSelected)
+    {
+        valueUpdateFlag = PDU_UPDATE_RESPONSE_VALUE;
+        valueId = CommandModel::RspValue;
+    }
+    else if (setMethodSelected)
+    {
+        valueUpdateFlag = PDU_UPDATE_COMMAND_VALUE;
+        valueId = CommandModel::CmdValue;
+    }
+    else if (methodIdx == MethodIndexForAddSubscription)
+    {
+        valueUpdateFlag = PDU_UPDATE_NOTIFICATION_VALUE;
+        valueId = CommandModel::NotifValue;
+    }
+
+    // Any value read back so far belongs to the previous command or data type.
+    m_ocaReadBackValueLabel.setVisible(false);
+
     // Create a component appropriate for displaying this properties value.
-    auto pComponent = m_ocaObject->CreateComponentForProperty(prop, 
-        [this] {
-            UpdateBinaryStrings();
+    auto pComponent = AES70Components::CreateComponentForProperty(*m_ocaObject, prop, 
+        [this, valueUpdateFlag, valueId] {
+            if (valueId.isValid())
+                StoreState({ valueId });
+            ScheduleBinaryStringsUpdate(valueUpdateFlag);
         });
     jassert(pComponent); // Missing implementation!
-    m_container.addAndMakeVisible(pComponent);
+    addAndMakeVisible(pComponent);
 
     // Depending on whether the Get, Set, or AddSubscription commands are selected, assign this new component 
     // to the correct member variable. The old component, if any, will be deleted automatically.
@@ -782,30 +1027,63 @@ void StringGeneratorPage::CreateValueComponents()
     m_ocaLabels.at(LABELIDX_RESP_STATUS)->setColour(juce::Label::textColourId, LabelEnabledTextColour);
     m_ocaLabels.at(LABELIDX_CMD_HANDLE)->setColour(juce::Label::textColourId, LabelEnabledTextColour);
 
-    resized();
+    UpdateSize(ValueRowsFlags);
+}
+
+void StringGeneratorContainer::ScheduleBinaryStringsUpdate(int updateFlags)
+{
+    m_pendingUpdates |= updateFlags;
+
+    // Further changes until the timer fires will be merged into the same update.
+    if (!isTimerRunning())
+        startTimer(BinaryStringsUpdateIntervalMs);
 }
 
-void StringGeneratorPage::UpdateBinaryStrings()
+void StringGeneratorContainer::timerCallback()
 {
+    stopTimer();
+
+    int updateFlags = m_pendingUpdates;
+    m_pendingUpdates = PDU_UPDATE_NONE;
+
+    if ((updateFlags & PDU_UPDATE_ALL) != 0)
+        UpdateBinaryStrings();
+    else if (updateFlags != PDU_UPDATE_NONE)
+        UpdateBinaryStringValues(updateFlags);
+}
+
+void StringGeneratorContainer::UpdateBinaryStrings()
+{
+    AES70_TRACE_SCOPE("StringGeneratorContainer::UpdateBinaryStrings");
     DBG("UpdateBinaryStrings");
 
+    // The strings are generated from the page's CommandModel node only, exactly like for pages 
+    // which are not materialized (See CommandTablePage).
     juce::MemoryBlock commandMemBlock;
     juce::MemoryBlock responseMemBlock;
     juce::MemoryBlock notificationMemBlock;
-    CreateBinaryStrings(commandMemBlock, responseMemBlock, notificationMemBlock);
-
-    // Convert juce::MemoryBlock to juce::String
+    CommandModel::ValueRanges valueRanges;
+    juce::String encodeError;
+    CommandModel::CreateBinaryStrings(m_page->GetState(), commandMemBlock, responseMemBlock, notificationMemBlock, &valueRanges, &encodeError);
+    ShowEncodeError(encodeError);
+
+    // Remember the strings and where their value bytes are, so that 
+    // subsequent value changes can be patched in by UpdateBinaryStringValues.
+    CachePdu(m_commandPdu, commandMemBlock, valueRanges.m_command);
+    CachePdu(m_responsePdu, responseMemBlock, valueRanges.m_response);
+    CachePdu(m_notificationPdu, notificationMemBlock, valueRanges.m_notification);
+
+    // Only touch the TextEditors whose content actually changed.
     // TODO: add support for user-defined byte-separators
-    juce::String commandString = juce::String::toHexString(commandMemBlock.getData(), static_cast<int>(commandMemBlock.getSize()));
-    juce::String responseString = juce::String::toHexString(responseMemBlock.getData(), static_cast<int>(responseMemBlock.getSize()));
-    juce::String notificationString = juce::String::toHexString(notificationMemBlock.getData(), static_cast<int>(notificationMemBlock.getSize()));
-
-    m_ocaCommandTextEditor.setText(commandString, false);
-    m_ocaResponseTextEditor.setText(responseString, false);
-    m_ocaNotificationTextEditor.setText(notificationString, false);
+    if (m_ocaCommandTextEditor.getText() != m_commandPdu.m_hexString)
+        m_ocaCommandTextEditor.setText(m_commandPdu.m_hexString, false);
+    if (m_ocaResponseTextEditor.getText() != m_responsePdu.m_hexString)
+        m_ocaResponseTextEditor.setText(m_responsePdu.m_hexString, false);
+    if (m_ocaNotificationTextEditor.getText() != m_notificationPdu.m_hexString)
+        m_ocaNotificationTextEditor.setText(m_notificationPdu.m_hexString, false);
 
     // If NanoOcpClient is Online and there is an OCP.1 command to send, enable m_sendButton.
-    switch (GetMainComponent()->GetConnectionStatus())
+    switch (m_page->GetMainComponent()->GetConnectionStatus())
     {
         case ConnectionStatus::Online:
             m_sendButton.setEnabled(true);
@@ -818,228 +1096,301 @@ void StringGeneratorPage::UpdateBinaryStrings()
     }
 }
 
-bool StringGeneratorPage::CreateBinaryStrings(juce::MemoryBlock& commandMemBlock, juce::MemoryBlock& responseMemBlock, juce::MemoryBlock& notificationMemBlock)
+void StringGeneratorContainer::UpdateBinaryStringValues(int updateFlags)
 {
-    int propIdx = m_ocaPropertyComboBox.getSelectedId();
-    int methodIdx = m_ocaCommandComboBox.getSelectedId();
-    if ((propIdx <= 0) || (methodIdx <= 0))
-        return false;
-
-    if (!m_ocaObject)
-        return false;
+    AES70_TRACE_SCOPE("StringGeneratorContainer::UpdateBinaryStringValues");
 
     AES70::Property prop;
-    int commandDefLevel;
-    bool getMethodSelected(false);
-    bool setMethodSelected(false);
+    if (!GetSelectedProperty(prop))
+        return;
 
-    // Usual case: a standard AES70 class (not proprietary) was selected.
-    if (m_ocaClassComboBox.getSelectedId() != ClassIndexForCustomClass)
+    // Each flag corresponds to exactly one value property and one binary string.
+    struct ValueUpdate
     {
-        auto propertyList = m_ocaObject->GetProperties();
-        if (propertyList.size() < propIdx)
-            return false;
+        int m_flag;
+        const juce::Identifier& m_valueId;
+        GeneratedPdu& m_pdu;
+        juce::TextEditor& m_textEditor;
+    };
+    ValueUpdate valueUpdates[] = {
+        { PDU_UPDATE_COMMAND_VALUE,         CommandModel::CmdValue,     m_commandPdu,       m_ocaCommandTextEditor },
+        { PDU_UPDATE_RESPONSE_VALUE,        CommandModel::RspValue,     m_responsePdu,      m_ocaResponseTextEditor },
+        { PDU_UPDATE_NOTIFICATION_VALUE,    CommandModel::NotifValue,   m_notificationPdu,  m_ocaNotificationTextEditor },
+    };
 
-        prop = propertyList.at(propIdx - 1);
-        commandDefLevel = prop.m_defLevel;
-        getMethodSelected = (methodIdx == prop.m_getMethodIdx);
-        setMethodSelected = (methodIdx == prop.m_setMethodIdx);
+    auto state = m_page->GetState();
+    for (auto& valueUpdate : valueUpdates)
+    {
+        if (((updateFlags & valueUpdate.m_flag) == 0) || !state.hasProperty(valueUpdate.m_valueId))
+            continue;
+
+        auto paramData = AES70::OcaRoot::CreateParamDataFromString(state.getProperty(valueUpdate.m_valueId).toString(), prop.m_type);
+        if (!valueUpdate.m_pdu.PatchParamData(paramData))
+        {
+            // Value does not fit into the existing string (i.e. a text of different length). 
+            UpdateBinaryStrings();
+            return;
+        }
+
+        if (valueUpdate.m_textEditor.getText() != valueUpdate.m_pdu.m_hexString)
+            valueUpdate.m_textEditor.setText(valueUpdate.m_pdu.m_hexString, false);
     }
+}
+
+bool StringGeneratorContainer::GetSelectedProperty(AES70::Property& prop) const
+{
+    int propIdx = m_ocaPropertyComboBox.getSelectedId();
+    if ((propIdx <= 0) || !m_ocaObject)
+        return false;
 
     // Custom AES70 class is selected. NOTE: GetProperties will return exactly one entry.
-    else
+    if (m_ocaClassComboBox.getSelectedId() == ClassIndexForCustomClass)
     {
         prop = m_ocaObject->GetProperties().back();
-        commandDefLevel = m_ocaCommandDefLevelComboBox.getSelectedId();
-        getMethodSelected = (methodIdx <= 8);
-        setMethodSelected = (methodIdx > 8) && (methodIdx <= 16);
+        return true;
     }
 
-    std::uint32_t targetOno = static_cast<std::uint32_t>(m_ocaONoTextEditor.getText().getIntValue());
-    std::uint8_t responseStatus = static_cast<std::uint8_t>(m_ocaResponseStatusComboBox.getSelectedId() - 1);
+    auto propertyList = m_ocaObject->GetProperties();
+    if (propertyList.size() < propIdx)
+        return false;
 
-    std::uint8_t responseParamCount(0);
-    std::vector<std::uint8_t> responseParamData;
-    NanoOcp1::Ocp1CommandDefinition commandDefinition;
-    notificationMemBlock.reset();
+    prop = propertyList.at(propIdx - 1);
+    return true;
+}
 
-    // Depending on whether the Get, Set, or AddSubscription commands are selected,
-    // the commandDefinition will be defined differently.
-    if (getMethodSelected)
-    {
-        // A response will only contain data if the status is OK.
-        if (responseStatus == 0 /* OCASTATUS_OK */)
-        {
-            responseParamCount = 1;
-            responseParamData = m_ocaObject->CreateParamDataForComponent(m_ocaResponseValueComponent.get(), prop);
-            jassert(responseParamData.size() > 0);
-        }
+void StringGeneratorContainer::CachePdu(GeneratedPdu& pdu, const juce::MemoryBlock& memBlock, const CommandModel::ValueRange& valueRange)
+{
+    pdu.Clear();
+    pdu.m_memBlock = memBlock;
+    pdu.m_hexString = juce::String::toHexString(memBlock.getData(), static_cast<int>(memBlock.getSize()));
 
-        commandDefinition = NanoOcp1::Ocp1CommandDefinition(targetOno, 
-                                                            static_cast<std::uint16_t>(prop.m_type),
-                                                            static_cast<std::uint16_t>(commandDefLevel),
-                                                            static_cast<std::uint16_t>(methodIdx));
-    }
-    else if (setMethodSelected)
+    // The position of the value bytes was recorded while encoding the string.
+    if ((valueRange.m_size == 0) || (valueRange.m_offset + valueRange.m_size > memBlock.getSize()))
+        return;
+
+    pdu.m_paramDataOffset = valueRange.m_offset;
+    pdu.m_paramDataSize = valueRange.m_size;
+}
+
+void StringGeneratorContainer::ShowEncodeError(const juce::String& errorMessage)
+{
+    if (errorMessage == m_encodeError)
+        return;
+
+    m_encodeError = errorMessage;
+
+    // The binary strings are empty if a value cannot be encoded, so the error is shown in their place.
+    if (m_encodeError.isNotEmpty())
     {
-        auto commandParamData = m_ocaObject->CreateParamDataForComponent(m_ocaSetCommandValueComponent.get(), prop);
-        jassert(commandParamData.size() > 0);
-
-        commandDefinition = NanoOcp1::Ocp1CommandDefinition(targetOno, 
-                                                            static_cast<std::uint16_t>(prop.m_type), 
-                                                            static_cast<std::uint16_t>(commandDefLevel),
-                                                            static_cast<std::uint16_t>(methodIdx),
-                                                            1, /* paramCount */ 
-                                                            commandParamData);
+        auto errorText = "Cannot encode value: " + m_encodeError;
+        m_ocaCommandTextEditor.setTextToShowWhenEmpty(errorText, EncodeErrorColour);
+        m_ocaResponseTextEditor.setTextToShowWhenEmpty(errorText, EncodeErrorColour);
+        m_ocaNotificationTextEditor.setTextToShowWhenEmpty(errorText, EncodeErrorColour);
     }
-    else if (methodIdx == MethodIndexForAddSubscription)
+    else
     {
-        commandDefinition = NanoOcp1::Ocp1CommandDefinition(targetOno,
-                                                            static_cast<std::uint16_t>(prop.m_type),
-                                                            static_cast<std::uint16_t>(prop.m_defLevel),
-                                                            static_cast<std::uint16_t>(prop.m_index)).AddSubscriptionCommand();
-
-        auto notificationParamData = m_ocaObject->CreateParamDataForComponent(m_ocaNotificationValueComponent.get(), prop);
-        notificationMemBlock = NanoOcp1::Ocp1Notification(targetOno, 
-                                                          static_cast<std::uint16_t>(prop.m_defLevel),
-                                                          static_cast<std::uint16_t>(prop.m_index),
-                                                          1 /* paramCount */, 
-                                                          notificationParamData).GetMemoryBlock();
+        m_ocaCommandTextEditor.setTextToShowWhenEmpty(CommandPlaceholderText, LabelEnabledTextColour);
+        m_ocaResponseTextEditor.setTextToShowWhenEmpty(ResponsePlaceholderText, LabelEnabledTextColour);
+        m_ocaNotificationTextEditor.setTextToShowWhenEmpty(NotificationPlaceholderText, LabelEnabledTextColour);
     }
 
-    std::uint32_t dummyHandle; // Auto-generated by Ocp1CommandResponseRequired, will be thrown away.
-    NanoOcp1::Ocp1CommandResponseRequired ocp1Command(commandDefinition, dummyHandle);
+    m_ocaCommandTextEditor.repaint();
+    m_ocaResponseTextEditor.repaint();
+    m_ocaNotificationTextEditor.repaint();
+}
 
-    // Replace the auto-generated handle with the user-defined one.
-    std::uint32_t userHandle(static_cast<std::uint32_t>(m_ocaCommandHandleTextEditor.getText().getIntValue()));
-    ocp1Command.SetHandle(userHandle);
+int StringGeneratorContainer::GetRequiredHeight() const
+{
+    // The height of the container component within the Viewport depends on how much 
+    // content needs to be displayed. So the container grows as more components are required. 
+    int containerHeight = AppWindowDefaultHeight;
+    if (m_ocaCommandComboBox.getSelectedId() == MethodIndexForAddSubscription)
+        containerHeight += 140;
 
-    commandMemBlock = ocp1Command.GetMemoryBlock();
-    responseMemBlock = NanoOcp1::Ocp1Response(userHandle, responseStatus, responseParamCount, responseParamData).GetMemoryBlock();
+    return containerHeight;
+}
 
-    return true;
+void StringGeneratorContainer::UpdateSize(int rowFlags)
+{
+    // A change of size will trigger resized(), and let the owning Viewport update its scrollbars.
+    if (getHeight() != GetRequiredHeight())
+        setSize(getWidth(), GetRequiredHeight());
+    else
+        LayoutRows(rowFlags);
 }
 
-void StringGeneratorPage::paint(juce::Graphics& g)
+void StringGeneratorContainer::paint(juce::Graphics& g)
 {
-    g.fillAll(AppBackgroundColour);
+    AES70_TRACE_SCOPE("StringGeneratorContainer::paint");
 
-    if (m_ocaClassComboBox.getSelectedId() == 0)
+    if ((m_ocaClassComboBox.getSelectedId() == 0) && m_startHereImage.isValid())
     {
-        std::unique_ptr<Drawable> startHereIcon = Drawable::createFromImageData(BinaryData::StartHere_png, BinaryData::StartHere_pngSize);
         float startHereIconXPos = (float)(m_ocaPropertyComboBox.getBounds().getCentreX() - 50);
-        startHereIcon->drawWithin(g, Rectangle<float>(startHereIconXPos, 15.0f, 90.0f, 45.0f), 
-            RectanglePlacement::stretchToFit, 0.75f);
+        g.setOpacity(0.75f);
+        g.drawImage(m_startHereImage, Rectangle<float>(startHereIconXPos, 15.0f, 90.0f, 45.0f), 
+            RectanglePlacement::stretchToFit);
     }
 }
 
-void StringGeneratorPage::resized()
+void StringGeneratorContainer::resized()
 {
-    // The height of the container component within the Viewport depends on how much 
-    // content needs to be displayed. So m_container grows as more components are required. 
-    int containerHeight = AppWindowDefaultHeight;
-    if (m_ocaCommandComboBox.getSelectedId() == MethodIndexForAddSubscription)
-        containerHeight += 140;
+    AES70_TRACE_SCOPE("StringGeneratorContainer::resized");
 
-    // Remove a margin to account for the vertical scrollbar.
-    m_container.setBounds(0, 0, getLocalBounds().getWidth() - 8, containerHeight);
-    auto bounds = m_container.getLocalBounds();
+    UpdateRowBounds();
+    LayoutRows(AllRowsFlags);
+}
+
+void StringGeneratorContainer::UpdateRowBounds()
+{
+    auto bounds = getLocalBounds();
     bounds.removeFromLeft(4); // Left margin
 
-    int margin = 2;
     int controlHeight = 40;
-    int comboBoxWidth = bounds.getWidth() / 5; // 5 columns. 
+    m_columnWidth = bounds.getWidth() / 5; // 5 columns. 
 
     // Row 1
-    auto rowBounds = bounds.removeFromTop(static_cast<int>(controlHeight * 0.75));
-    rowBounds.removeFromLeft(comboBoxWidth); // Horizontal spacer
-    m_ocaLabels.at(LABELIDX_TITLE)->setBounds(rowBounds.reduced(margin));
-    rowBounds = bounds.removeFromTop(static_cast<int>(controlHeight * 0.5));
-    m_hyperlink.changeWidthToFitText();
-    m_hyperlink.setBounds(rowBounds.removeFromRight(m_hyperlink.getWidth()).reduced(margin));
+    m_rowBounds[ROW_TITLE] = bounds.removeFromTop(static_cast<int>(controlHeight * 0.75));
+    m_rowBounds[ROW_HYPERLINK] = bounds.removeFromTop(static_cast<int>(controlHeight * 0.5));
 
     // Vertical spacer
     bounds.removeFromTop(controlHeight / 2);
 
-    // Row 2
-    rowBounds = bounds.removeFromTop(controlHeight);
-    m_ocaLabels.at(LABELIDX_CLASS)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
-    m_ocaClassComboBox.setBounds(rowBounds.removeFromLeft(comboBoxWidth * 2).reduced(margin));
-    m_ocaLabels.at(LABELIDX_ONO)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
-    m_ocaONoTextEditor.setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
-
-    // Row 3
-    rowBounds = bounds.removeFromTop(controlHeight);
-    m_ocaLabels.at(LABELIDX_PROP)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
-    m_ocaPropertyComboBox.setBounds(rowBounds.removeFromLeft(comboBoxWidth * 2).reduced(margin));
-    m_ocaLabels.at(LABELIDX_PROP_DEFLEVEL)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
-    m_ocaPropertyDefLevelComboBox.setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
-
-    // Row 4
-    rowBounds = bounds.removeFromTop(controlHeight);
-    rowBounds.removeFromLeft(comboBoxWidth * 3); // Horizontal spacer
-    m_ocaLabels.at(LABELIDX_PROP_PARAMTYPE)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
-    m_ocaPropertyParamTypeComboBox.setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
-
-    // Row 5
-    rowBounds = bounds.removeFromTop(controlHeight);
-    m_ocaLabels.at(LABELIDX_CMD)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
-    m_ocaCommandComboBox.setBounds(rowBounds.removeFromLeft(comboBoxWidth * 2).reduced(margin));
-    m_ocaLabels.at(LABELIDX_CMD_DEFLEVEL)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
-    m_ocaCommandDefLevelComboBox.setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
+    // Rows 2 to 5
+    m_rowBounds[ROW_CLASS] = bounds.removeFromTop(controlHeight);
+    m_rowBounds[ROW_PROPERTY] = bounds.removeFromTop(controlHeight);
+    m_rowBounds[ROW_PARAMTYPE] = bounds.removeFromTop(controlHeight);
+    m_rowBounds[ROW_COMMAND] = bounds.removeFromTop(controlHeight);
 
     // Vertical spacer
     bounds.removeFromTop(controlHeight / 2);
 
-    // Row 6
-    rowBounds = bounds.removeFromTop(controlHeight);
-    m_ocaLabels.at(LABELIDX_CMD_SET_VALUE)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
-    if (m_ocaSetCommandValueComponent)
-        m_ocaSetCommandValueComponent->setBounds(rowBounds.removeFromLeft(comboBoxWidth * 2).reduced(margin));
-    else
-        rowBounds.removeFromLeft(comboBoxWidth * 2); // Horizontal spacer
-    m_ocaLabels.at(LABELIDX_CMD_HANDLE)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
-    m_ocaCommandHandleTextEditor.setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
-
-    // Row 7
-    rowBounds = bounds.removeFromTop(static_cast<int>(controlHeight * 1.5f));
-    m_sendButton.setBounds(rowBounds.removeFromRight(static_cast<int>(comboBoxWidth * 0.5f)).reduced(margin));
-    m_ocaCommandTextEditor.setBounds(rowBounds.reduced(margin));
+    // Rows 6 and 7
+    m_rowBounds[ROW_SET_VALUE] = bounds.removeFromTop(controlHeight);
+    m_rowBounds[ROW_COMMAND_STRING] = bounds.removeFromTop(static_cast<int>(controlHeight * 1.5f));
 
     // Vertical spacer
     bounds.removeFromTop(controlHeight / 2); 
 
-    // Row 8
-    rowBounds = bounds.removeFromTop(controlHeight);
-    m_ocaLabels.at(LABELIDX_RESP_VALUE)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
-    if (m_ocaResponseValueComponent)
-        m_ocaResponseValueComponent->setBounds(rowBounds.removeFromLeft(comboBoxWidth * 2).reduced(margin));
-    else
-        rowBounds.removeFromLeft(comboBoxWidth * 2); // Horizontal spacer
-    m_ocaLabels.at(LABELIDX_RESP_STATUS)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
-    m_ocaResponseStatusComboBox.setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
-
-    // Row 9
-    rowBounds = bounds.removeFromTop(static_cast<int>(controlHeight * 1.5f));
-    m_ocaResponseTextEditor.setBounds(rowBounds.reduced(margin));
+    // Rows 8 and 9
+    m_rowBounds[ROW_RESPONSE_VALUE] = bounds.removeFromTop(controlHeight);
+    m_rowBounds[ROW_RESPONSE_STRING] = bounds.removeFromTop(static_cast<int>(controlHeight * 1.5f));
 
     // Row 10 and 11: Notification only relevant if AddSubscription command selected.
+    m_rowBounds[ROW_NOTIF_VALUE] = juce::Rectangle<int>();
+    m_rowBounds[ROW_NOTIF_STRING] = juce::Rectangle<int>();
     if (m_ocaCommandComboBox.getSelectedId() == MethodIndexForAddSubscription)
     {
         bounds.removeFromTop(controlHeight / 2); // Vertical spacer
-        rowBounds = bounds.removeFromTop(controlHeight); // Row 10
-        m_ocaLabels.at(LABELIDX_NOTIF_VALUE)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
-        m_ocaNotificationValueComponent->setBounds(rowBounds.removeFromLeft(comboBoxWidth * 2).reduced(margin));
-
-        rowBounds = bounds.removeFromTop(static_cast<int>(controlHeight * 1.5f)); // Row 11
-        m_ocaNotificationTextEditor.setBounds(rowBounds.reduced(margin));
+        m_rowBounds[ROW_NOTIF_VALUE] = bounds.removeFromTop(controlHeight);
+        m_rowBounds[ROW_NOTIF_STRING] = bounds.removeFromTop(static_cast<int>(controlHeight * 1.5f));
     }
+}
 
-    // Call base class implementation which takes care of updating scrollbars etc.
-    return juce::Viewport::resized();
+void StringGeneratorContainer::LayoutRows(int rowFlags)
+{
+    AES70_TRACE_SCOPE("StringGeneratorContainer::LayoutRows");
+
+    int margin = 2;
+    int comboBoxWidth = m_columnWidth;
+
+    for (int rowIdx = 0; rowIdx < ROW_MAX; rowIdx++)
+    {
+        // Skip unchanged rows, and rows which are currently not shown.
+        auto rowBounds = m_rowBounds.at(rowIdx);
+        if (((rowFlags & (1 << rowIdx)) == 0) || rowBounds.isEmpty())
+            continue;
+
+        switch (rowIdx)
+        {
+            case ROW_TITLE:
+                rowBounds.removeFromLeft(comboBoxWidth); // Horizontal spacer
+                m_ocaLabels.at(LABELIDX_TITLE)->setBounds(rowBounds.reduced(margin));
+                break;
+
+            case ROW_HYPERLINK:
+                m_hyperlink.changeWidthToFitText();
+                m_hyperlink.setBounds(rowBounds.removeFromRight(m_hyperlink.getWidth()).reduced(margin));
+                break;
+
+            case ROW_CLASS:
+                m_ocaLabels.at(LABELIDX_CLASS)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
+                m_ocaClassComboBox.setBounds(rowBounds.removeFromLeft(comboBoxWidth * 2).reduced(margin));
+                m_ocaLabels.at(LABELIDX_ONO)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
+                m_ocaONoTextEditor.setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
+                break;
+
+            case ROW_PROPERTY:
+                m_ocaLabels.at(LABELIDX_PROP)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
+                m_ocaPropertyComboBox.setBounds(rowBounds.removeFromLeft(comboBoxWidth * 2).reduced(margin));
+                m_ocaLabels.at(LABELIDX_PROP_DEFLEVEL)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
+                m_ocaPropertyDefLevelComboBox.setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
+                break;
+
+            case ROW_PARAMTYPE:
+                rowBounds.removeFromLeft(comboBoxWidth * 3); // Horizontal spacer
+                m_ocaLabels.at(LABELIDX_PROP_PARAMTYPE)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
+                m_ocaPropertyParamTypeComboBox.setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
+                break;
+
+            case ROW_COMMAND:
+                m_ocaLabels.at(LABELIDX_CMD)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
+                m_ocaCommandComboBox.setBounds(rowBounds.removeFromLeft(comboBoxWidth * 2).reduced(margin));
+                m_ocaLabels.at(LABELIDX_CMD_DEFLEVEL)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
+                m_ocaCommandDefLevelComboBox.setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
+                break;
+
+            case ROW_SET_VALUE:
+                m_ocaLabels.at(LABELIDX_CMD_SET_VALUE)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
+                if (m_ocaSetCommandValueComponent)
+                    m_ocaSetCommandValueComponent->setBounds(rowBounds.removeFromLeft(comboBoxWidth * 2).reduced(margin));
+                else
+                    rowBounds.removeFromLeft(comboBoxWidth * 2); // Horizontal spacer
+                m_ocaLabels.at(LABELIDX_CMD_HANDLE)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
+                m_ocaCommandHandleTextEditor.setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
+                break;
+
+            case ROW_COMMAND_STRING:
+                m_sendButton.setBounds(rowBounds.removeFromRight(static_cast<int>(comboBoxWidth * 0.5f)).reduced(margin));
+                m_ocaCommandTextEditor.setBounds(rowBounds.reduced(margin));
+                break;
+
+            case ROW_RESPONSE_VALUE:
+                m_ocaLabels.at(LABELIDX_RESP_VALUE)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
+                if (m_ocaResponseValueComponent && m_ocaReadBackValueLabel.isVisible())
+                {
+                    // Share the space with the value read back from the device, to compare both side by side.
+                    m_ocaResponseValueComponent->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
+                    m_ocaReadBackValueLabel.setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
+                }
+                else if (m_ocaResponseValueComponent)
+                    m_ocaResponseValueComponent->setBounds(rowBounds.removeFromLeft(comboBoxWidth * 2).reduced(margin));
+                else
+                    rowBounds.removeFromLeft(comboBoxWidth * 2); // Horizontal spacer
+                m_ocaLabels.at(LABELIDX_RESP_STATUS)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
+                m_ocaResponseStatusComboBox.setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
+                break;
+
+            case ROW_RESPONSE_STRING:
+                m_ocaResponseTextEditor.setBounds(rowBounds.reduced(margin));
+                break;
+
+            case ROW_NOTIF_VALUE:
+                m_ocaLabels.at(LABELIDX_NOTIF_VALUE)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
+                if (m_ocaNotificationValueComponent)
+                    m_ocaNotificationValueComponent->setBounds(rowBounds.removeFromLeft(comboBoxWidth * 2).reduced(margin));
+                break;
+
+            case ROW_NOTIF_STRING:
+                m_ocaNotificationTextEditor.setBounds(rowBounds.reduced(margin));
+                break;
+
+            default:
+                break;
+        }
+    }
 }
 
-bool StringGeneratorPage::SelectComboBoxItemByText(juce::ComboBox& comboBox, 
+bool StringGeneratorContainer::SelectComboBoxItemByText(juce::ComboBox& comboBox, 
                                                    const juce::String& itemText, 
                                                    juce::NotificationType notification)
 {
@@ -1056,7 +1407,7 @@ bool StringGeneratorPage::SelectComboBoxItemByText(juce::ComboBox& comboBox,
     return false;
 }
 
-juce::String StringGeneratorPage::GetComponentValueAsString(const juce::Component* const component)
+juce::String StringGeneratorContainer::GetComponentValueAsString(const juce::Component* const component)
 {
     if (component == nullptr)
         return juce::String();
@@ -1083,7 +1434,7 @@ juce::String StringGeneratorPage::GetComponentValueAsString(const juce::Componen
     return juce::String();
 }
 
-bool StringGeneratorPage::SetComponentValueFromString(juce::Component* const component, 
+bool StringGeneratorContainer::SetComponentValueFromString(juce::Component* const component, 
                                                       const juce::String& valueString,
                                                       juce::NotificationType notification)
 {
@@ -1112,4 +1463,191 @@ bool StringGeneratorPage::SetComponentValueFromString(juce::Component* const com
 
     jassertfalse; // Missing implementation for component type!
     return false;
-}
\ No newline at end of file
+}
+
+
+//==============================================================================
+// Class StringGeneratorPage
+//==============================================================================
+
+StringGeneratorPage::StringGeneratorPage(MainTabbedComponent* const parent, juce::ValueTree state)
+    :   AbstractPage(parent),
+        m_state(state.isValid() ? state : juce::ValueTree(CommandModel::CommandType)),
+        m_lastVisibleTime(juce::Time::getMillisecondCounter())
+{
+    jassert(parent != nullptr);
+    jassert(m_state.hasType(CommandModel::CommandType));
+
+    auto commandModel = parent->GetCommandModel();
+    if (m_state.getParent() != commandModel)
+        commandModel.appendChild(m_state, nullptr);
+
+    setSize(AppWindowDefaultWidth, AppWindowDefaultHeight);
+}
+
+StringGeneratorPage::~StringGeneratorPage()
+{
+    setViewedComponent(nullptr, false);
+    m_container.reset();
+
+    auto commandModel = m_state.getParent();
+    if (commandModel.isValid())
+        commandModel.removeChild(m_state, nullptr);
+}
+
+StringGeneratorPage* StringGeneratorPage::CreatePageFromValueTree(juce::ValueTree command,
+                                                                  MainTabbedComponent* const parent)
+{
+    AES70_TRACE_SCOPE("StringGeneratorPage::CreatePageFromValueTree");
+
+    // Gatekeeper checks
+    if ((parent == nullptr) || !command.hasType(CommandModel::CommandType))
+        return nullptr;
+
+    // Create a page holding the configuration. GUI controls will be created once the page is shown.
+    StringGeneratorPage* pPage = new StringGeneratorPage(parent, command);
+    if (pPage == nullptr)
+        return nullptr;
+
+    // Set the new page's component name, which will be used as its tab name.
+    juce::String pageName("Page " + juce::String(parent->GetCommandModel().getNumChildren()));
+    if (command.hasProperty(CommandModel::Name))
+        pageName = command.getProperty(CommandModel::Name).toString();
+    pPage->setName(pageName);
+
+    return pPage;
+}
+
+XmlElement* StringGeneratorPage::CreateXmlElementFromPage() const
+{
+    return m_state.createXml().release();
+}
+
+juce::ValueTree StringGeneratorPage::GetState() const
+{
+    return m_state;
+}
+
+void StringGeneratorPage::Materialize()
+{
+    if (m_container)
+        return;
+
+    AES70_TRACE_SCOPE("StringGeneratorPage::Materialize");
+
+    m_container = std::make_unique<StringGeneratorContainer>(this);
+    m_container->ApplyState();
+
+    // Controls which were not configured by the state show their default values, which the state needs to reflect.
+    for (const auto& property : { CommandModel::Ono, CommandModel::Handle })
+    {
+        if (!m_state.hasProperty(property))
+            m_container->StoreState({ property });
+    }
+
+    m_container->UpdateConnectionStatus(GetMainComponent()->GetConnectionStatus());
+    setViewedComponent(m_container.get(), false);
+    resized();
+}
+
+bool StringGeneratorPage::Release()
+{
+    if (!m_container || isVisible())
+        return false;
+
+    setViewedComponent(nullptr, false);
+    m_container.reset();
+
+    return true;
+}
+
+bool StringGeneratorPage::IsMaterialized() const
+{
+    return (m_container != nullptr);
+}
+
+juce::uint32 StringGeneratorPage::GetLastVisibleTime() const
+{
+    return m_lastVisibleTime;
+}
+
+void StringGeneratorPage::ShowReadBackValue(const AES70::CommandHeader& command, const AES70::ResponseView& response)
+{
+    if (m_container)
+        m_container->ShowReadBackValue(command, response);
+}
+
+void StringGeneratorPage::ShowReadBackMessage(const juce::String& message)
+{
+    if (m_container)
+        m_container->ShowReadBackMessage(message);
+}
+
+void StringGeneratorPage::UpdateConnectionStatus(ConnectionStatus status)
+{
+    if (m_container)
+        m_container->UpdateConnectionStatus(status);
+}
+
+void StringGeneratorPage::paint(juce::Graphics& g)
+{
+    g.fillAll(AppBackgroundColour);
+}
+
+void StringGeneratorPage::resized()
+{
+    // Remove a margin to account for the vertical scrollbar.
+    if (m_container)
+        m_container->setBounds(0, 0, getLocalBounds().getWidth() - 8, m_container->GetRequiredHeight());
+
+    // Call base class implementation which takes care of updating scrollbars etc.
+    return juce::Viewport::resized();
+}
+
+void StringGeneratorPage::setName(const juce::String& newName)
+{
+    m_state.setProperty(CommandModel::Name, newName, nullptr);
+
+    juce::Component::setName(newName);
+}
+
+void StringGeneratorPage::visibilityChanged()
+{
+    // GUI controls are only created once the page is shown for the first time, 
+    // or after they were released due to the page being hidden for too long.
+    if (isVisible())
+        Materialize();
+
+    m_lastVisibleTime = juce::Time::getMillisecondCounter();
+}
+
+//==============================================================================
+// Struct StringGeneratorContainer::GeneratedPdu
+//==============================================================================
+
+bool StringGeneratorContainer::GeneratedPdu::PatchParamData(const std::vector<std::uint8_t>& paramData)
+{
+    if ((m_paramDataSize == 0) || (paramData.size() != m_paramDataSize))
+        return false;
+
+    jassert(m_paramDataOffset + m_paramDataSize <= m_memBlock.getSize());
+    auto pduData = static_cast<std::uint8_t*>(m_memBlock.getData()) + m_paramDataOffset;
+    if (std::memcmp(pduData, paramData.data(), m_paramDataSize) == 0)
+        return true; // Nothing to do.
+
+    std::memcpy(pduData, paramData.data(), m_paramDataSize);
+
+    // juce::String::toHexString represents each byte with two characters, separated by a space.
+    auto paramHexString = juce::String::toHexString(paramData.data(), static_cast<int>(m_paramDataSize));
+    m_hexString = m_hexString.replaceSection(static_cast<int>(m_paramDataOffset) * 3, paramHexString.length(), paramHexString);
+
+    return true;
+}
+
+void StringGeneratorContainer::GeneratedPdu::Clear()
+{
+    m_memBlock.reset();
+    m_hexString.clear();
+    m_paramDataOffset = 0;
+    m_paramDataSize = 0;
+}
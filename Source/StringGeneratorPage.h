@@ -35,42 +35,83 @@ namespace AES70
 {
     struct Property;
     struct OcaRoot;
+    struct ResponseView;
+    struct CommandHeader;
 }
+namespace CommandModel
+{
+    struct ValueRange;
+}
+class StringGeneratorPage;
 
 
 /**
- * Component for configuring and generating OCP.1 binary strings.
+ * Component containing all GUI controls for configuring and generating OCP.1 binary strings.
+ * The controls are bound to the page's CommandModel node: every change made by the user is written
+ * to the node right away (See StoreState), and the binary strings are generated from the node only,
+ * at most once per display frame (See ScheduleBinaryStringsUpdate).
+ * NOTE: A StringGeneratorContainer is only created by its StringGeneratorPage while needed,
+ * see StringGeneratorPage::Materialize and StringGeneratorPage::Release.
  */
-class StringGeneratorPage : public AbstractPage
+class StringGeneratorContainer : public juce::Component, 
+                                 private juce::Timer
 {
 public:
-    StringGeneratorPage(MainTabbedComponent* const parent);
-    ~StringGeneratorPage() override;
+    StringGeneratorContainer(StringGeneratorPage* const page);
+    ~StringGeneratorContainer() override;
 
     /**
-     * Factory method used to create a new StringGeneratorPage based on the "AES70Command"
-     * element of an XML configuration file.
+     * Apply the properties of the page's CommandModel node to the GUI controls.
+     * This simulates the user's workflow, selecting class, property, command etc. in that order.
+     * The node itself is not modified while applying.
+     */
+    void ApplyState();
+
+    /**
+     * Write the values of the GUI controls bound to the given properties into the page's CommandModel node.
+     * GUI controls call this whenever the user changes them, so that the node is always up to date.
+     * Only properties whose value actually changed trigger ValueTree::Listener callbacks.
      *
-     * @param[in] aes70CommandElement   AES70Command XML node containing the attributes to be applied to the page.
-     * @param[in] parent                Parent component which will take ownership of this page.
-     * @return  Pointer to a new StringGeneratorPage object or nullptr if the XmlElement could not be parsed.
-     */    
-    static StringGeneratorPage* CreatePageFromXmlElement(const juce::XmlElement* const aes70CommandElement,
-                                                         MainTabbedComponent* const parent);
+     * @param[in] properties    CommandModel properties to write. Value properties (i.e. CommandModel::CmdValue) 
+     *                          are removed from the node if the corresponding value component does not exist.
+     */
+    void StoreState(const std::vector<juce::Identifier>& properties);
 
     /**
-     * Creates an "AES70Command" XmlElement containing this page's current configuration. 
+     * Update any GUI elements which depend on the current ConnectionStatus 
+     * with the remote test devce.
      *
-     * @return  Pointer to a new XmlElement object. Ownership of this pointer should be taken 
-     *          by the root XmlElement.
+     * @param[in] status ConnectionStatus of the internal NanoOcpClient.
      */
-    XmlElement* CreateXmlElementFromPage() const;
+    void UpdateConnectionStatus(ConnectionStatus status);
 
+    /**
+     * Show the value returned by the device in a Response to this page's Get command next to 
+     * m_ocaResponseValueComponent, and whether it matches the value of the generated Response.
+     * Responses to other commands are ignored, as are Responses to a Command whose target object or method 
+     * differs from the page's current command, since OCP.1 Responses only identify their Command by its handle.
+     *
+     * @param[in] command   Handle, target object and method of the Command the Response belongs to.
+     * @param[in] response  The received Response. Only valid during the call.
+     */
+    void ShowReadBackValue(const AES70::CommandHeader& command, const AES70::ResponseView& response);
 
-    // Reimplemented from AbstractPage
+    /**
+     * Show a message in place of the value read back from the device, i.e. when a Response cannot be shown.
+     * Ignored unless this page's command is a Get command.
+     *
+     * @param[in] message   The text to show.
+     */
+    void ShowReadBackMessage(const juce::String& message);
+
+    /**
+     * The height of the container depends on how much content needs to be displayed. 
+     * It grows as more components are required. 
+     *
+     * @return  Height in pixels required to display all the current content.
+     */
+    int GetRequiredHeight() const;
 
-    void UpdateConnectionStatus(ConnectionStatus status) override;
-    
 
     // Reimplemented from juce::Component
 
@@ -78,6 +119,11 @@ public:
     void resized() override;
 
 
+    // Reimplemented from juce::Timer
+
+    void timerCallback() override;
+
+
 protected:
     /**
      * Reset GUI components.
@@ -94,22 +140,36 @@ protected:
     void CreateValueComponents();
 
     /**
-     * Re-create the Command and Response binary strings, and display them on both TextEditors:
-     * m_ocaCommandTextEditor and m_ocaResponseTextEditor.
+     * Mark parts of the binary strings as outdated. The actual update will take place on the next 
+     * timerCallback, so that any number of changes within one display frame (i.e. while dragging a 
+     * Slider) result in at most one update of the TextEditors.
+     *
+     * @param[in] updateFlags   Combination of PduUpdateFlags, defining which parts of which binary strings are outdated.
+     */
+    void ScheduleBinaryStringsUpdate(int updateFlags);
+
+    /**
+     * Re-create the Command, Response, and Notification binary strings, and display them on the TextEditors:
+     * m_ocaCommandTextEditor, m_ocaResponseTextEditor and m_ocaNotificationTextEditor.
      */
     void UpdateBinaryStrings();
 
     /**
-     * Re-create the Command, Response, and Notification binary strings, based on the current 
-     * configuration of the OCA class, ONo, Property, and Command GUI controls.
-     * 
-     * @parameter[out] commandMemBlock      The resulting Command binary string as a juce::MemoryBlock.
-     * @parameter[out] responseMemBlock     The resulting Response binary string as a juce::MemoryBlock.
-     * @parameter[out] notificationMemBlock The Notification binary string that would result from a PropertyChanged event in the device, 
-     *                                      as a juce::MemoryBlock. Will only be non-empty if the AddSubscription command is selected.
-     * @return  True if all strings could be generated successfully.
+     * Update only the value bytes of the previously generated binary strings, without re-creating them.
+     * Falls back to UpdateBinaryStrings if the new values do not fit into the previously generated strings
+     * (i.e. because the length of a string value changed).
+     *
+     * @param[in] updateFlags   Combination of PduUpdateFlags, defining which values have changed.
+     */
+    void UpdateBinaryStringValues(int updateFlags);
+
+    /**
+     * Get the AES70 class property currently selected on the GUI.
+     *
+     * @param[out] prop     The selected property.
+     * @return  True if a valid class and property are selected.
      */
-    bool CreateBinaryStrings(juce::MemoryBlock& commandMemBlock, juce::MemoryBlock& responseMemBlock, juce::MemoryBlock& notificationMemBlock);
+    bool GetSelectedProperty(AES70::Property& prop) const;
 
     /**
      * Helper method to select a given option of a ComboBox.
@@ -149,8 +209,86 @@ protected:
                                             juce::NotificationType notification = juce::sendNotificationAsync);
 
 private:
-    // Component inside the main juce::Viewport, set with setViewedComponent.
-    juce::Component m_container;
+    /**
+     * A generated binary string, together with the information needed to update its value bytes in-place.
+     */
+    struct GeneratedPdu
+    {
+        /**
+         * Replace the value bytes of the PDU and the corresponding characters of its hex string.
+         *
+         * @param[in] paramData Newly encoded value. 
+         * @return  True if the new value could be patched into the PDU. False if the PDU 
+         *          needs to be re-generated because the value does not fit.
+         */
+        bool PatchParamData(const std::vector<std::uint8_t>& paramData);
+
+        /**
+         * Clear the PDU, its hex string, and its value offsets.
+         */
+        void Clear();
+
+        juce::MemoryBlock m_memBlock;   // The binary string.
+        juce::String m_hexString;       // The binary string, as displayed on the GUI.
+        size_t m_paramDataOffset = 0;   // Position of the value bytes within m_memBlock.
+        size_t m_paramDataSize = 0;     // Number of value bytes within m_memBlock, zero if there are none.
+    };
+
+    /**
+     * Store a newly generated binary string along with the position of its value bytes.
+     *
+     * @param[out] pdu          GeneratedPdu to store the binary string in.
+     * @param[in] memBlock      The newly generated binary string.
+     * @param[in] valueRange    Position of the value bytes, as recorded by CommandModel::CreateBinaryStrings.
+     */
+    void CachePdu(GeneratedPdu& pdu, const juce::MemoryBlock& memBlock, const CommandModel::ValueRange& valueRange);
+
+    /**
+     * Show why the page's value cannot be encoded in place of the binary strings, which remain empty in that case.
+     *
+     * @param[in] errorMessage  Description of the error, as given by CommandModel::CreateBinaryStrings.
+     *                          Empty to show the regular placeholder texts again.
+     */
+    void ShowEncodeError(const juce::String& errorMessage);
+
+    /**
+     * Show a text in m_ocaReadBackValueLabel, which is made visible if it was not yet.
+     *
+     * @param[in] text      The text to show.
+     * @param[in] colour    Colour of the text.
+     */
+    void ShowReadBackText(const juce::String& text, const juce::Colour& colour);
+
+    /**
+     * Get the value of the GUI control bound to the given CommandModel property.
+     *
+     * @param[in] property  CommandModel property.
+     * @return  The control's value as stored in the CommandModel, or a void var if the control does not exist.
+     */
+    juce::var GetControlValue(const juce::Identifier& property) const;
+
+    /**
+     * Adjust the height of the container to GetRequiredHeight. If the height changed, this re-layouts
+     * all rows via resized(). Otherwise only the given rows are re-layouted.
+     *
+     * @param[in] rowFlags  Combination of GuiRows bits, defining which rows have changed.
+     */
+    void UpdateSize(int rowFlags);
+
+    /**
+     * Calculate the bounds of each row of GUI controls, based on the current size of the container.
+     */
+    void UpdateRowBounds();
+
+    /**
+     * Set the bounds of the GUI controls within the given rows, using the row bounds from UpdateRowBounds.
+     *
+     * @param[in] rowFlags  Combination of GuiRows bits, defining which rows to layout.
+     */
+    void LayoutRows(int rowFlags);
+
+    // Page which owns this container.
+    StringGeneratorPage* m_page;
 
     // Hyperlink to the project webpage.
     juce::HyperlinkButton m_hyperlink;
@@ -194,6 +332,9 @@ private:
     // Component to enter values for the Get method Response message
     std::unique_ptr<juce::Component> m_ocaResponseValueComponent;
 
+    // Label to display the value of the last Response received from the device, see ShowReadBackValue.
+    juce::Label m_ocaReadBackValueLabel;
+
     // TextEditor to display the AES70/OCA Response message
     juce::TextEditor m_ocaResponseTextEditor;
 
@@ -203,12 +344,151 @@ private:
     // TextEditor to display AES70/OCA Notification messages
     juce::TextEditor m_ocaNotificationTextEditor;
 
+    // Why the value cannot be encoded, shown in place of the binary strings. Empty if it can. See ShowEncodeError.
+    juce::String m_encodeError;
+
     // Labels on the UI. NOTE: use a vector of pointers because juce::Label is non-copyable.
     std::vector<std::unique_ptr<juce::Label>> m_ocaLabels;
 
     // AES70/OCA object representing the current configuraion on the GUI
     std::unique_ptr<AES70::OcaRoot> m_ocaObject;
 
+    // Last generated Command, Response and Notification binary strings.
+    GeneratedPdu m_commandPdu;
+    GeneratedPdu m_responsePdu;
+    GeneratedPdu m_notificationPdu;
+
+    // Combination of PduUpdateFlags, to be processed on the next timerCallback.
+    int m_pendingUpdates;
+
+    // Bounds of each row of GUI controls, indexed by GuiRows. See UpdateRowBounds.
+    std::vector<juce::Rectangle<int>> m_rowBounds;
+
+    // Width of one of the five layout columns.
+    int m_columnWidth;
+
+    // StartHere icon, shown while no class is selected. Decoded once and shared via juce::ImageCache.
+    juce::Image m_startHereImage;
+
+    // True while ApplyState is running, to prevent StoreState from writing intermediate configurations.
+    bool m_applyingState;
+
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StringGeneratorContainer)
+};
+
+
+/**
+ * Page for configuring and generating OCP.1 binary strings.
+ * The page's configuration is held by its node in the CommandModel of the MainTabbedComponent, 
+ * so that it is available to other views (See CommandTablePage) whether or not the page was ever shown. 
+ * The StringGeneratorContainer with the actual GUI controls is created on demand, and can be released 
+ * again once the page has not been shown for a while.
+ */
+class StringGeneratorPage : public AbstractPage
+{
+public:
+    /**
+     * @param[in] parent    Parent component which will take ownership of this page.
+     * @param[in] state     CommandModel::CommandType node holding the page's configuration. If invalid, 
+     *                      an empty node is created. The node is appended to the parent's CommandModel,
+     *                      unless it already belongs to it, and removed from it when the page is deleted.
+     */
+    StringGeneratorPage(MainTabbedComponent* const parent, juce::ValueTree state = juce::ValueTree());
+    ~StringGeneratorPage() override;
+
+    /**
+     * Factory method used to create a new StringGeneratorPage based on a CommandModel node, i.e. one
+     * that was read from a config file (See ConfigFileLoader).
+     * NOTE: The node's properties are only applied to GUI controls once the page is materialized.
+     *
+     * @param[in] command   CommandModel::CommandType node containing the configuration of the page.
+     * @param[in] parent    Parent component which will take ownership of this page.
+     * @return  Pointer to a new StringGeneratorPage object or nullptr if the node is not a command.
+     */
+    static StringGeneratorPage* CreatePageFromValueTree(juce::ValueTree command, 
+                                                        MainTabbedComponent* const parent);
+
+    /**
+     * Creates an "AES70Command" XmlElement containing this page's current configuration. 
+     *
+     * @return  Pointer to a new XmlElement object. Ownership of this pointer should be taken 
+     *          by the root XmlElement.
+     */
+    XmlElement* CreateXmlElementFromPage() const;
+
+    /**
+     * Get the CommandModel node holding this page's configuration.
+     *
+     * @return  The page's CommandModel::CommandType node.
+     */
+    juce::ValueTree GetState() const;
+
+    /**
+     * Create the StringGeneratorContainer with the GUI controls, and apply the page's 
+     * configuration to it. Does nothing if the page is already materialized.
+     */
+    void Materialize();
+
+    /**
+     * Store the current configuration of the GUI controls, and delete the StringGeneratorContainer.
+     * Does nothing if the page is currently visible, or not materialized.
+     *
+     * @return  True if the GUI controls were released.
+     */
+    bool Release();
+
+    /**
+     * @return  True if the StringGeneratorContainer with the GUI controls currently exists.
+     */
+    bool IsMaterialized() const;
+
+    /**
+     * @return  Value of juce::Time::getMillisecondCounter at the time the page was last visible.
+     */
+    juce::uint32 GetLastVisibleTime() const;
+
+
+    /**
+     * Pass the device's Response to a command sent from this page on to the GUI controls, if materialized.
+     * See StringGeneratorContainer::ShowReadBackValue.
+     *
+     * @param[in] command   Handle, target object and method of the Command the Response belongs to.
+     * @param[in] response  The received Response. Only valid during the call.
+     */
+    void ShowReadBackValue(const AES70::CommandHeader& command, const AES70::ResponseView& response);
+
+    /**
+     * Pass a message on to the GUI controls, if materialized. See StringGeneratorContainer::ShowReadBackMessage.
+     *
+     * @param[in] message   The text to show.
+     */
+    void ShowReadBackMessage(const juce::String& message);
+
+
+    // Reimplemented from AbstractPage
+
+    void UpdateConnectionStatus(ConnectionStatus status) override;
+    
+
+    // Reimplemented from juce::Component
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+    void visibilityChanged() override;
+    void setName(const juce::String& newName) override;
+
+
+private:
+    // Page configuration. Kept up to date by the StringGeneratorContainer while materialized.
+    juce::ValueTree m_state;
+
+    // Component inside the main juce::Viewport, set with setViewedComponent. Only exists while materialized.
+    std::unique_ptr<StringGeneratorContainer> m_container;
+
+    // Value of juce::Time::getMillisecondCounter at the time the page was last visible.
+    juce::uint32 m_lastVisibleTime;
+
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StringGeneratorPage)
 };
@@ -0,0 +1,153 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#include "SubscriptionManager.h"
+#include "LatestValueStore.h"
+#include "AES70Codec.h"
+#include "Trace.h"
+#include <NanoOcp1.h>
+
+
+static constexpr int MaxMessagesPerPdu = 64; // Number of commands pipelined into one PDU at most.
+
+
+//==============================================================================
+// Class SubscriptionManager
+//==============================================================================
+
+SubscriptionManager::SubscriptionManager(SendFunction sendFunction)
+    :   m_sendFunction(std::move(sendFunction)),
+        m_isOnline(false)
+{
+    jassert(m_sendFunction != nullptr);
+}
+
+SubscriptionManager::~SubscriptionManager()
+{
+    cancelPendingUpdate();
+}
+
+bool SubscriptionManager::Add(std::uint32_t ono, int defLevel, int propIndex, int dataType, bool subscribe)
+{
+    Subscription subscription;
+    subscription.m_ono = ono;
+    subscription.m_defLevel = static_cast<std::uint16_t>(defLevel);
+    subscription.m_propIndex = static_cast<std::uint16_t>(propIndex);
+    subscription.m_dataType = static_cast<std::uint16_t>(dataType);
+
+    auto key = LatestValueStore::MakeKey(ono, subscription.m_defLevel, subscription.m_propIndex);
+    bool isNew = (m_subscriptions.find(key) == m_subscriptions.end());
+    m_subscriptions[key] = subscription;
+
+    if (subscribe)
+        QueueCommand(subscription, true);
+
+    return isNew;
+}
+
+bool SubscriptionManager::Remove(std::uint32_t ono, int defLevel, int propIndex)
+{
+    auto iter = m_subscriptions.find(LatestValueStore::MakeKey(ono, static_cast<std::uint16_t>(defLevel), static_cast<std::uint16_t>(propIndex)));
+    if (iter == m_subscriptions.end())
+        return false;
+
+    QueueCommand(iter->second, false);
+    m_subscriptions.erase(iter);
+
+    return true;
+}
+
+void SubscriptionManager::RemoveAll()
+{
+    AES70_TRACE_SCOPE("SubscriptionManager::RemoveAll");
+
+    // Anything still queued would only be sent after the following RemoveSubscription commands.
+    m_pendingCommands.clear();
+    cancelPendingUpdate();
+
+    for (const auto& keyAndSubscription : m_subscriptions)
+        QueueCommand(keyAndSubscription.second, false);
+    m_subscriptions.clear();
+
+    SendPendingCommands();
+}
+
+int SubscriptionManager::GetNumSubscriptions() const
+{
+    return static_cast<int>(m_subscriptions.size());
+}
+
+void SubscriptionManager::OnConnectionEstablished()
+{
+    m_isOnline = true;
+
+    for (const auto& keyAndSubscription : m_subscriptions)
+        QueueCommand(keyAndSubscription.second, true);
+}
+
+void SubscriptionManager::OnConnectionLost()
+{
+    m_isOnline = false;
+    m_pendingCommands.clear();
+    cancelPendingUpdate();
+}
+
+void SubscriptionManager::handleAsyncUpdate()
+{
+    SendPendingCommands();
+}
+
+void SubscriptionManager::QueueCommand(const Subscription& subscription, bool add)
+{
+    // Subscriptions are (re-)established once the connection is, so there is no need to queue anything until then.
+    if (!m_isOnline)
+        return;
+
+    m_pendingCommands.push_back({ subscription, add });
+    triggerAsyncUpdate();
+}
+
+void SubscriptionManager::SendPendingCommands()
+{
+    AES70_TRACE_SCOPE("SubscriptionManager::SendPendingCommands");
+
+    AES70::PduPipeline pipeline(m_sendFunction, MaxMessagesPerPdu);
+    for (const auto& pendingCommand : m_pendingCommands)
+    {
+        const auto& subscription = pendingCommand.m_subscription;
+        NanoOcp1::Ocp1CommandDefinition propertyDefinition(subscription.m_ono, subscription.m_dataType, 
+                                                          subscription.m_defLevel, subscription.m_propIndex);
+        auto commandDefinition = pendingCommand.m_add ? propertyDefinition.AddSubscriptionCommand() 
+                                                      : propertyDefinition.RemoveSubscriptionCommand();
+
+        std::uint32_t handle(0); // Auto-generated by Ocp1CommandResponseRequired, replaced by an internal one.
+        NanoOcp1::Ocp1CommandResponseRequired command(commandDefinition, handle);
+        handle = AES70::NextInternalHandle();
+        command.SetHandle(handle);
+        pipeline.Add(command.GetMemoryBlock());
+    }
+    pipeline.Flush();
+
+    m_pendingCommands.clear();
+}
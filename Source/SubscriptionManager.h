@@ -0,0 +1,158 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <map>
+
+
+/**
+ * Keeps track of all properties the app has subscribed to on the connected device, i.e. with the 
+ * AddSubscription command of StringGeneratorPages or the MonitorPage. AddSubscription and RemoveSubscription 
+ * commands requested within one message loop iteration are pipelined into as few PDUs as possible. 
+ * Whenever the connection to the device is established, i.e. again after a network glitch, all tracked 
+ * subscriptions are re-established automatically. On exit, they are removed from the device (See RemoveAll).
+ */
+class SubscriptionManager : private juce::AsyncUpdater
+{
+public:
+    /**
+     * Function used to send a PDU to the device.
+     *
+     * @param[in] data  The PDU.
+     * @return  True if the PDU could be sent.
+     */
+    using SendFunction = std::function<bool(const juce::MemoryBlock& data)>;
+
+    /**
+     * @param[in] sendFunction  Function used to send PDUs to the device.
+     */
+    explicit SubscriptionManager(SendFunction sendFunction);
+    ~SubscriptionManager() override;
+
+    /**
+     * Track a subscription to a property.
+     *
+     * @param[in] ono           ONo of the object.
+     * @param[in] defLevel      Definition level of the property.
+     * @param[in] propIndex     Index of the property.
+     * @param[in] dataType      Data type of the property.
+     * @param[in] subscribe     True to send the AddSubscription command, false if it has already been sent
+     *                          by the caller, i.e. by a StringGeneratorPage.
+     * @return  True if the subscription was not tracked before.
+     */
+    bool Add(std::uint32_t ono, int defLevel, int propIndex, int dataType, bool subscribe);
+
+    /**
+     * Stop tracking a subscription to a property, and send the RemoveSubscription command.
+     *
+     * @param[in] ono           ONo of the object.
+     * @param[in] defLevel      Definition level of the property.
+     * @param[in] propIndex     Index of the property.
+     * @return  True if the subscription was tracked.
+     */
+    bool Remove(std::uint32_t ono, int defLevel, int propIndex);
+
+    /**
+     * Send the RemoveSubscription commands of all tracked subscriptions right away, i.e. before 
+     * the connection is closed on exit, and stop tracking them.
+     */
+    void RemoveAll();
+
+    /**
+     * Get the number of tracked subscriptions.
+     *
+     * @return  Number of subscribed properties.
+     */
+    int GetNumSubscriptions() const;
+
+    /**
+     * To be called whenever the connection to the device has been established. 
+     * Re-sends the AddSubscription commands of all tracked subscriptions.
+     */
+    void OnConnectionEstablished();
+
+    /**
+     * To be called whenever the connection to the device has been lost. 
+     * Commands which were not sent yet are dropped, as they are re-sent once the connection is back.
+     */
+    void OnConnectionLost();
+
+
+private:
+    /**
+     * A subscribed property.
+     */
+    struct Subscription
+    {
+        std::uint32_t m_ono = 0;
+        std::uint16_t m_defLevel = 0;
+        std::uint16_t m_propIndex = 0;
+        std::uint16_t m_dataType = 0;
+    };
+
+    /**
+     * A command waiting to be sent on the next handleAsyncUpdate.
+     */
+    struct PendingCommand
+    {
+        Subscription m_subscription;
+        bool m_add = true;  // True for AddSubscription, false for RemoveSubscription.
+    };
+
+
+    // Reimplemented from juce::AsyncUpdater
+
+    void handleAsyncUpdate() override;
+
+
+    /**
+     * Queue a command for sending on the next handleAsyncUpdate, if connected.
+     *
+     * @param[in] subscription  The subscribed property.
+     * @param[in] add           True for AddSubscription, false for RemoveSubscription.
+     */
+    void QueueCommand(const Subscription& subscription, bool add);
+
+    /**
+     * Send all queued commands, pipelined into as few PDUs as possible.
+     */
+    void SendPendingCommands();
+
+    // Function used to send PDUs to the device.
+    SendFunction m_sendFunction;
+
+    // Tracked subscriptions, by the key of the property (See LatestValueStore::MakeKey).
+    std::map<std::uint64_t, Subscription> m_subscriptions;
+
+    // Commands to send on the next handleAsyncUpdate, in order.
+    std::vector<PendingCommand> m_pendingCommands;
+
+    // True while connected to the device.
+    bool m_isOnline;
+
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SubscriptionManager)
+};
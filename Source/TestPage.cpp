@@ -25,6 +25,12 @@
 #include "TestPage.h"
 #include "MainTabbedComponent.h"
 #include "Common.h"
+#include "Metrics.h"
+#include "Trace.h"
+
+
+static constexpr int InboxFrameRateHz = 20; // Rate at which pending Notifications are displayed.
+static constexpr int MetricsSummaryUpdateFrames = InboxFrameRateHz; // Number of frames after which the metrics summary is updated.
 
 
 /**
@@ -65,6 +71,9 @@ TestPage::TestPage(MainTabbedComponent* parent)
         m_loadButton(juce::TextButton("Load config from file")),
         m_saveButton(juce::TextButton("Save config to file")),
         m_incomingMessageDisplayEdit(juce::TextEditor("MessageDisplayEdit")),
+        m_numInboxMessages(0),
+        m_nextNotificationSequence(0),
+        m_numFramesSinceSummaryUpdate(0),
         m_hyperlink(juce::HyperlinkButton(ProjectHostShortURL, juce::URL(ProjectHostLongURL)))
 {
     jassert(parent != nullptr);
@@ -73,6 +82,7 @@ TestPage::TestPage(MainTabbedComponent* parent)
     addAndMakeVisible(&m_ipAddressEdit);
     addAndMakeVisible(&m_ipPortEdit);
     addAndMakeVisible(&m_stateLed);
+    addAndMakeVisible(&m_metricsSummaryLabel);
     addAndMakeVisible(&m_incomingMessageDisplayEdit);
     addAndMakeVisible(&m_loadButton);
     addAndMakeVisible(&m_saveButton);
@@ -132,6 +142,10 @@ TestPage::TestPage(MainTabbedComponent* parent)
     m_stateLed.setToggleState(false, dontSendNotification);
     m_stateLed.setEnabled(false);
 
+    m_metricsSummaryLabel.setJustificationType(juce::Justification::centredRight);
+    m_metricsSummaryLabel.setColour(juce::Label::textColourId, LabelEnabledTextColour);
+    m_metricsSummaryLabel.setMinimumHorizontalScale(0.5f);
+
     m_incomingMessageDisplayEdit.setHasFocusOutline(true);
     m_incomingMessageDisplayEdit.setReadOnly(true);
     m_incomingMessageDisplayEdit.setCaretVisible(false);
@@ -157,24 +171,48 @@ TestPage::TestPage(MainTabbedComponent* parent)
             GetMainComponent()->SaveFileViaDialog();
         };
 
+    m_metricsSummaryLabel.setText(Metrics::GetInstance().ToSummaryString(), juce::dontSendNotification);
+    startTimerHz(InboxFrameRateHz);
+
     setSize(10, 10);
 }
 
 TestPage::~TestPage()
 {
-
+    stopTimer();
 }
 
 void TestPage::AddMessage(const juce::MemoryBlock& message)
 {
+    AES70_TRACE_SCOPE("TestPage::AddMessage");
+
+    // Notifications which arrived before this message must not be displayed after it.
+    FlushPendingNotifications();
+
     juce::String incomingString = juce::String::toHexString(message.getData(), static_cast<int>(message.getSize()));
 
     // TODO: make addition of timestamp optional
     String timestamp = Time::getCurrentTime().toString(true, true, true, true);
     incomingString = timestamp + juce::String(": ") + incomingString + juce::String("\r\n");
 
-    m_incomingMessageDisplayEdit.moveCaretToEnd();
-    m_incomingMessageDisplayEdit.insertTextAtCaret(incomingString);
+    AppendToInbox(incomingString, 1);
+}
+
+void TestPage::AddNotification(std::uint64_t key, const juce::MemoryBlock& message)
+{
+    auto& pending = m_pendingNotifications[key];
+    if (pending.m_isPending)
+    {
+        // Replace the Notification which has not been displayed yet. 
+        // Reuses the memory of the previous one, as Notifications for the same property have the same size, mostly.
+        pending.m_numCoalesced++;
+        Metrics::GetInstance().Increment(Metrics::NOTIFICATIONS_COALESCED);
+    }
+
+    pending.m_message = message;
+    pending.m_time = juce::Time::getCurrentTime();
+    pending.m_sequence = m_nextNotificationSequence++;
+    pending.m_isPending = true;
 }
 
 void TestPage::UpdateConnectionStatus(ConnectionStatus status)
@@ -201,6 +239,68 @@ void TestPage::UpdateConnectionStatus(ConnectionStatus status)
     DBG("SetConnectionStatus: " + statusString);
 }
 
+void TestPage::timerCallback()
+{
+    FlushPendingNotifications();
+
+    // The Metrics keep counting regardless, so the summary only needs updating while visible.
+    if (++m_numFramesSinceSummaryUpdate >= MetricsSummaryUpdateFrames)
+    {
+        m_numFramesSinceSummaryUpdate = 0;
+        if (isShowing())
+            m_metricsSummaryLabel.setText(Metrics::GetInstance().ToSummaryString(), juce::dontSendNotification);
+    }
+}
+
+void TestPage::FlushPendingNotifications()
+{
+    AES70_TRACE_SCOPE("TestPage::FlushPendingNotifications");
+
+    // The map is ordered by property, so the pending Notifications are sorted by arrival first.
+    m_notificationsToFlush.clear();
+    for (auto& keyAndPending : m_pendingNotifications)
+    {
+        if (keyAndPending.second.m_isPending)
+            m_notificationsToFlush.push_back(&keyAndPending.second);
+    }
+    if (m_notificationsToFlush.empty())
+        return;
+
+    std::sort(m_notificationsToFlush.begin(), m_notificationsToFlush.end(), [](const PendingNotification* a, const PendingNotification* b)
+    {
+        return a->m_sequence < b->m_sequence;
+    });
+
+    juce::String incomingString;
+    int numMessages(0);
+    for (auto pendingPtr : m_notificationsToFlush)
+    {
+        auto& pending = *pendingPtr;
+        incomingString << pending.m_time.toString(true, true, true, true) << ": "
+                       << juce::String::toHexString(pending.m_message.getData(), static_cast<int>(pending.m_message.getSize()));
+        if (pending.m_numCoalesced > 0)
+            incomingString << " (" << juce::String(pending.m_numCoalesced) << " coalesced)";
+        incomingString << "\r\n";
+
+        pending.m_numCoalesced = 0;
+        pending.m_isPending = false;
+        numMessages++;
+    }
+
+    // All Notifications of one frame are inserted at once.
+    if (numMessages > 0)
+        AppendToInbox(incomingString, numMessages);
+}
+
+void TestPage::AppendToInbox(const juce::String& text, int numMessages)
+{
+    m_incomingMessageDisplayEdit.moveCaretToEnd();
+    m_incomingMessageDisplayEdit.insertTextAtCaret(text);
+
+    m_numInboxMessages += numMessages;
+    Metrics::GetInstance().Set(Metrics::INBOX_SIZE, m_numInboxMessages);
+}
+
 void TestPage::paint(juce::Graphics& g)
 {
     // TODO: anything to do here? Just call base implementation for now.
@@ -246,8 +346,9 @@ void TestPage::resized()
     m_ocaLabels.at(LABELIDX_IP_STATUS)->setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
     m_stateLed.setBounds(rowBounds.removeFromLeft(comboBoxWidth).reduced(margin));
 
-    // Vertical spacer
-    bounds.removeFromTop(controlHeight / 2);
+    // Row 4
+    rowBounds = bounds.removeFromTop(controlHeight / 2);
+    m_metricsSummaryLabel.setBounds(rowBounds.reduced(margin, 0));
 
     // Row 7
     rowBounds = bounds.removeFromTop(bounds.getHeight() - margin * 2);
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <map>
 #include "AbstractPage.h"
 
 
@@ -32,21 +33,34 @@
 /**
  * Component for testing the generated OCP.1 binary strings against real AES70-capable
  * devices via TCP/IP. This page provides GUI elements for TCP connection configuration,
- * as well as fields for monitoring the incoming OCP.1 Notifications and Responses.
+ * as well as fields for monitoring the incoming OCP.1 Notifications and Responses,
+ * and a live summary of the app's Metrics.
  */
-class TestPage : public AbstractPage
+class TestPage : public AbstractPage,
+                 private juce::Timer
 {
 public:
     TestPage(MainTabbedComponent* parent);
     ~TestPage() override;
 
     /**
-     * Display an incoming message on the m_incomingMessageDisplayEdit
+     * Display an incoming message on the m_incomingMessageDisplayEdit. Any pending Notifications, 
+     * which arrived before the message, are displayed first.
      * 
      * @param[in] message   Message which will be converted to String for displaying.
      */
     void AddMessage(const juce::MemoryBlock& message);
 
+    /**
+     * Queue an incoming Notification for displaying on the m_incomingMessageDisplayEdit. Notifications are
+     * displayed once per frame (See timerCallback). If further Notifications for the same property arrive
+     * in the meantime, only the latest one is displayed, along with the number of Notifications it replaced.
+     *
+     * @param[in] key       Key of the notified property (See LatestValueStore::MakeKey).
+     * @param[in] message   Notification PDU which will be converted to String for displaying.
+     */
+    void AddNotification(std::uint64_t key, const juce::MemoryBlock& message);
+
     /**
      * Callback method that is triggered whenever the IP address or port are changed on the GUI by the user.
      *
@@ -67,8 +81,36 @@ public:
     void resized() override;
 
 
+    // Reimplemented from juce::Timer
+
+    void timerCallback() override;
+
+
 protected:
+    /**
+     * Latest Notification received for a property, which has not been displayed yet.
+     */
+    struct PendingNotification
+    {
+        juce::MemoryBlock m_message;    // The Notification PDU.
+        juce::Time m_time;              // Time of arrival of m_message.
+        std::uint64_t m_sequence = 0;   // Order of arrival of m_message, among all pending Notifications.
+        int m_numCoalesced = 0;         // Number of Notifications replaced by m_message.
+        bool m_isPending = false;       // False once m_message has been displayed.
+    };
 
+    /**
+     * Display all pending Notifications on the m_incomingMessageDisplayEdit at once, in order of arrival.
+     */
+    void FlushPendingNotifications();
+
+    /**
+     * Append text to the m_incomingMessageDisplayEdit, and update the inbox size.
+     *
+     * @param[in] text          Text with one line per message.
+     * @param[in] numMessages   Number of messages within the text.
+     */
+    void AppendToInbox(const juce::String& text, int numMessages);
 
 
 private:
@@ -84,9 +126,28 @@ private:
     // TextButton misused as LED for displaying the connection status with the remote test device.
     juce::TextButton m_stateLed;
 
+    // Live summary of the app's Metrics, shown below m_stateLed.
+    juce::Label m_metricsSummaryLabel;
+
     // TextEditor to display incoming messages (Responses and Notifications).
     juce::TextEditor m_incomingMessageDisplayEdit;
 
+    // Number of messages shown on m_incomingMessageDisplayEdit.
+    int m_numInboxMessages;
+
+    // Latest Notification of each property, by the key of the property. See AddNotification.
+    // Entries are kept after being displayed, so that no memory is allocated for properties notified repeatedly.
+    std::map<std::uint64_t, PendingNotification> m_pendingNotifications;
+
+    // Sequence number of the next Notification passed to AddNotification.
+    std::uint64_t m_nextNotificationSequence;
+
+    // Pending Notifications sorted by arrival, reused by each FlushPendingNotifications to avoid allocations.
+    std::vector<PendingNotification*> m_notificationsToFlush;
+
+    // Number of frames since the m_metricsSummaryLabel was last updated.
+    int m_numFramesSinceSummaryUpdate;
+
     // Labels on the UI. NOTE: use a vector of pointers because juce::Label is non-copyable.
     std::vector<std::unique_ptr<juce::Label>> m_ocaLabels;
 
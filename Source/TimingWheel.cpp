@@ -0,0 +1,199 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#include "TimingWheel.h"
+
+
+static constexpr std::uint32_t NoEntry = 0; // Index marking the end of a slot list or of the free list.
+
+
+//==============================================================================
+// Class TimingWheel
+//==============================================================================
+
+TimingWheel::TimingWheel(int tickMs, std::uint64_t nowMs)
+    :   m_tickMs(static_cast<std::uint64_t>(juce::jmax(1, tickMs))),
+        m_currentTick(nowMs / m_tickMs),
+        m_entries(1),
+        m_slotHeads(static_cast<std::size_t>(NumLevels * NumSlots), NoEntry),
+        m_freeHead(NoEntry),
+        m_numTimers(0)
+{
+}
+
+TimingWheel::~TimingWheel()
+{
+}
+
+TimingWheel::TimerId TimingWheel::Schedule(std::uint64_t key, std::uint64_t deadlineMs)
+{
+    std::uint32_t entryIdx = m_freeHead;
+    if (entryIdx != NoEntry)
+    {
+        m_freeHead = m_entries[entryIdx].m_next;
+    }
+    else
+    {
+        entryIdx = static_cast<std::uint32_t>(m_entries.size());
+        m_entries.emplace_back();
+    }
+
+    // Round up, so that no timer expires before its deadline, and clamp to the range of the highest level.
+    static constexpr std::uint64_t MaxDeltaTicks = (std::uint64_t(1) << (NumSlotsBits * NumLevels)) - 1;
+    auto deadlineTick = (deadlineMs + m_tickMs - 1) / m_tickMs;
+    deadlineTick = juce::jlimit(m_currentTick + 1, m_currentTick + MaxDeltaTicks, deadlineTick);
+
+    auto& entry = m_entries[entryIdx];
+    entry.m_key = key;
+    entry.m_deadlineTick = deadlineTick;
+    Link(entryIdx);
+    m_numTimers++;
+
+    return (static_cast<TimerId>(entry.m_generation) << 32) | entryIdx;
+}
+
+bool TimingWheel::Cancel(TimerId timerId)
+{
+    auto entryIdx = static_cast<std::uint32_t>(timerId & 0xFFFFFFFF);
+    auto generation = static_cast<std::uint32_t>(timerId >> 32);
+    if ((entryIdx == NoEntry) || (entryIdx >= m_entries.size()) || (m_entries[entryIdx].m_generation != generation))
+        return false;
+
+    Unlink(entryIdx);
+    Release(entryIdx);
+    m_numTimers--;
+
+    return true;
+}
+
+int TimingWheel::GetNumTimers() const
+{
+    return m_numTimers;
+}
+
+int TimingWheel::Advance(std::uint64_t nowMs, const std::function<void(std::uint64_t key)>& onExpired)
+{
+    auto targetTick = nowMs / m_tickMs;
+
+    // Without any timers, there is nothing to cascade or expire on the way.
+    if (m_numTimers == 0)
+    {
+        m_currentTick = juce::jmax(m_currentTick, targetTick);
+        return 0;
+    }
+
+    int numExpired(0);
+    while ((m_currentTick < targetTick) && (m_numTimers > 0))
+    {
+        m_currentTick++;
+
+        // Whenever a level completes a revolution, the due slot of the level above is cascaded. 
+        // Higher levels go first, since their timers may end up in the due slot of the level below.
+        int numLevelsDue(1);
+        while ((numLevelsDue < NumLevels) && ((m_currentTick & ((std::uint64_t(1) << (NumSlotsBits * numLevelsDue)) - 1)) == 0))
+            numLevelsDue++;
+
+        for (int level = numLevelsDue - 1; level > 0; level--)
+            Cascade(level, static_cast<int>((m_currentTick >> (NumSlotsBits * level)) & (NumSlots - 1)));
+
+        // Each timer is unlinked before its callback is called, which may therefore modify the wheel.
+        auto& head = m_slotHeads[static_cast<std::size_t>(m_currentTick & (NumSlots - 1))];
+        while (head != NoEntry)
+        {
+            auto entryIdx = head;
+            auto key = m_entries[entryIdx].m_key;
+            jassert(m_entries[entryIdx].m_deadlineTick == m_currentTick);
+
+            Unlink(entryIdx);
+            Release(entryIdx);
+            m_numTimers--;
+            numExpired++;
+
+            if (onExpired)
+                onExpired(key);
+        }
+    }
+
+    m_currentTick = juce::jmax(m_currentTick, targetTick);
+
+    return numExpired;
+}
+
+void TimingWheel::Link(std::uint32_t entryIdx)
+{
+    auto& entry = m_entries[entryIdx];
+    jassert(entry.m_deadlineTick >= m_currentTick);
+
+    // The lowest level whose range covers the remaining ticks.
+    auto deltaTicks = entry.m_deadlineTick - m_currentTick;
+    int level(0);
+    while ((level < NumLevels - 1) && (deltaTicks >= (std::uint64_t(1) << (NumSlotsBits * (level + 1)))))
+        level++;
+
+    auto slot = static_cast<std::uint32_t>((entry.m_deadlineTick >> (NumSlotsBits * level)) & (NumSlots - 1));
+    entry.m_slot = static_cast<std::uint32_t>(level * NumSlots) + slot;
+    entry.m_prev = NoEntry;
+    entry.m_next = m_slotHeads[entry.m_slot];
+    if (entry.m_next != NoEntry)
+        m_entries[entry.m_next].m_prev = entryIdx;
+    m_slotHeads[entry.m_slot] = entryIdx;
+}
+
+void TimingWheel::Unlink(std::uint32_t entryIdx)
+{
+    const auto& entry = m_entries[entryIdx];
+    if (entry.m_prev != NoEntry)
+        m_entries[entry.m_prev].m_next = entry.m_next;
+    else
+        m_slotHeads[entry.m_slot] = entry.m_next;
+
+    if (entry.m_next != NoEntry)
+        m_entries[entry.m_next].m_prev = entry.m_prev;
+}
+
+void TimingWheel::Release(std::uint32_t entryIdx)
+{
+    auto& entry = m_entries[entryIdx];
+    entry.m_generation++;
+    entry.m_prev = NoEntry;
+    entry.m_next = m_freeHead;
+    m_freeHead = entryIdx;
+}
+
+void TimingWheel::Cascade(int level, int slot)
+{
+    jassert(level > 0);
+
+    // Detach the whole list first, since its timers are re-linked into lower levels.
+    auto& head = m_slotHeads[static_cast<std::size_t>(level * NumSlots + slot)];
+    auto entryIdx = head;
+    head = NoEntry;
+
+    while (entryIdx != NoEntry)
+    {
+        auto nextIdx = m_entries[entryIdx].m_next;
+        Link(entryIdx);
+        entryIdx = nextIdx;
+    }
+}
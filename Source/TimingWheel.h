@@ -0,0 +1,169 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+
+/**
+ * Hierarchical timing wheel, tracking the deadlines of many timers at constant cost per timer, 
+ * instead of running one juce::Timer per timer.
+ * 
+ * Time advances in ticks of fixed length. Level 0 has one slot per tick of the next NumSlots ticks, and each 
+ * further level has one slot per full revolution of the level below. A timer is put into the lowest level whose 
+ * range covers its deadline, and moved down one level ("cascaded") whenever the slot it is in comes due, until it 
+ * expires from level 0. Scheduling, cancelling and expiring a timer are therefore O(1), regardless of how many 
+ * timers are pending. Timers are kept in a pool with a free list, and linked into their slot by index, so no 
+ * allocation takes place once the pool has grown to the maximum number of concurrent timers.
+ *
+ * Not thread-safe. All methods are expected to be called on the same thread, i.e. the message thread.
+ */
+class TimingWheel
+{
+public:
+    /**
+     * Identifies a scheduled timer, i.e. to cancel it. Ids of expired or cancelled timers are never reused.
+     */
+    using TimerId = std::uint64_t;
+
+    /**
+     * Id which is never returned by Schedule.
+     */
+    static constexpr TimerId InvalidTimerId = 0;
+
+    /**
+     * Number of slots per level, and number of levels. Deadlines beyond the range of the highest level,
+     * i.e. 64^4 ticks, are clamped to it.
+     */
+    static constexpr int NumSlotsBits = 6;
+    static constexpr int NumSlots = 1 << NumSlotsBits;
+    static constexpr int NumLevels = 4;
+
+    /**
+     * @param[in] tickMs    Length of one tick in milliseconds, i.e. the resolution of the deadlines.
+     * @param[in] nowMs     Current time in milliseconds, from the same clock which is passed to Advance.
+     */
+    explicit TimingWheel(int tickMs, std::uint64_t nowMs = 0);
+    ~TimingWheel();
+
+    /**
+     * Schedule a timer.
+     *
+     * @param[in] key           Value passed back to Advance's callback once the timer expires, i.e. a Command handle.
+     * @param[in] deadlineMs    Time at which the timer expires, on the clock passed to Advance. Deadlines which 
+     *                          have passed already expire with the next tick.
+     * @return  Id of the new timer.
+     */
+    TimerId Schedule(std::uint64_t key, std::uint64_t deadlineMs);
+
+    /**
+     * Cancel a timer.
+     *
+     * @param[in] timerId   Id returned by Schedule.
+     * @return  True if the timer was still pending, false if it expired or was cancelled before.
+     */
+    bool Cancel(TimerId timerId);
+
+    /**
+     * Get the number of pending timers.
+     *
+     * @return  Number of timers which have neither expired nor been cancelled.
+     */
+    int GetNumTimers() const;
+
+    /**
+     * Advance the wheel to the given time, expiring all timers whose deadline has been reached.
+     * The callback may schedule and cancel timers itself.
+     *
+     * @param[in] nowMs         Current time in milliseconds.
+     * @param[in] onExpired     Function called with the key of each expired timer, in order of expiry.
+     * @return  Number of expired timers.
+     */
+    int Advance(std::uint64_t nowMs, const std::function<void(std::uint64_t key)>& onExpired);
+
+private:
+    /**
+     * A timer, which is either linked into a slot or into the free list.
+     */
+    struct Entry
+    {
+        std::uint64_t m_key = 0;
+        std::uint64_t m_deadlineTick = 0;
+        std::uint32_t m_generation = 0;     // Incremented whenever the entry is released, to invalidate old TimerIds.
+        std::uint32_t m_slot = 0;           // Index into m_slotHeads, level * NumSlots + slot.
+        std::uint32_t m_prev = 0;
+        std::uint32_t m_next = 0;
+    };
+
+    /**
+     * Link an entry into the slot covering its deadline.
+     *
+     * @param[in] entryIdx  Index of the entry in m_entries.
+     */
+    void Link(std::uint32_t entryIdx);
+
+    /**
+     * Unlink an entry from its slot.
+     *
+     * @param[in] entryIdx  Index of the entry in m_entries.
+     */
+    void Unlink(std::uint32_t entryIdx);
+
+    /**
+     * Return an entry to the free list.
+     *
+     * @param[in] entryIdx  Index of the entry in m_entries, which must not be linked into any slot.
+     */
+    void Release(std::uint32_t entryIdx);
+
+    /**
+     * Move all timers of the given slot down to the level(s) below, i.e. once the slot has come due.
+     *
+     * @param[in] level Level of the slot, greater than zero.
+     * @param[in] slot  Index of the slot within the level.
+     */
+    void Cascade(int level, int slot);
+
+    // Length of one tick in milliseconds.
+    std::uint64_t m_tickMs;
+
+    // Number of ticks elapsed, up to which all timers have expired.
+    std::uint64_t m_currentTick;
+
+    // Pool of timers. Index 0 is unused, so that it can mark the end of a list.
+    std::vector<Entry> m_entries;
+
+    // First entry of each slot, level by level, or zero if the slot is empty.
+    std::vector<std::uint32_t> m_slotHeads;
+
+    // First entry of the free list, or zero if all entries of the pool are in use.
+    std::uint32_t m_freeHead;
+
+    // See GetNumTimers.
+    int m_numTimers;
+
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TimingWheel)
+};
@@ -0,0 +1,201 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#include "Trace.h"
+
+#if AES70_ENABLE_TRACING
+
+#include <mutex>
+
+
+static constexpr size_t TraceEventsPerThread = 16384; // Capacity of the ring buffer of each thread.
+
+
+namespace Trace
+{
+
+/**
+ * One recorded scope.
+ */
+struct Event
+{
+    const char* m_name;
+    juce::int64 m_startTicks;
+    juce::int64 m_endTicks;
+};
+
+/**
+ * Ring buffer of the events of one thread. Only written by its own thread.
+ */
+struct ThreadBuffer
+{
+    juce::String m_threadName;
+    int m_threadIdx = 0;
+    std::atomic<juce::uint64> m_numRecorded{ 0 };
+    std::array<Event, TraceEventsPerThread> m_events;
+};
+
+/**
+ * Buffers of all threads which ever recorded an event. Buffers are kept after their thread has ended,
+ * so that its events can still be written. The mutex is only locked when a thread records its first event, 
+ * and while writing.
+ */
+static std::mutex ThreadBuffersMutex;
+static std::vector<std::unique_ptr<ThreadBuffer>> ThreadBuffers;
+
+/**
+ * Time at which tracing started, as origin of all timestamps.
+ */
+static const juce::int64 TraceStartTicks = juce::Time::getHighResolutionTicks();
+
+/**
+ * Buffer of the calling thread.
+ */
+static thread_local ThreadBuffer* CurrentThreadBuffer = nullptr;
+
+/**
+ * Helper method to get the buffer of the calling thread, which is created on first use.
+ *
+ * @return  The buffer of the calling thread.
+ */
+static ThreadBuffer& GetCurrentThreadBuffer()
+{
+    if (CurrentThreadBuffer != nullptr)
+        return *CurrentThreadBuffer;
+
+    auto buffer = std::make_unique<ThreadBuffer>();
+    if (juce::MessageManager::existsAndIsCurrentThread())
+        buffer->m_threadName = "Message thread";
+    else if (auto thread = juce::Thread::getCurrentThread())
+        buffer->m_threadName = thread->getThreadName();
+    else
+        buffer->m_threadName = "Thread " + juce::String::toHexString(reinterpret_cast<juce::pointer_sized_int>(juce::Thread::getCurrentThreadId()));
+
+    std::lock_guard<std::mutex> lock(ThreadBuffersMutex);
+    buffer->m_threadIdx = static_cast<int>(ThreadBuffers.size()) + 1;
+    CurrentThreadBuffer = buffer.get();
+    ThreadBuffers.push_back(std::move(buffer));
+
+    return *CurrentThreadBuffer;
+}
+
+/**
+ * Helper method to convert high resolution ticks to microseconds since TraceStartTicks.
+ *
+ * @param[in] ticks Ticks as returned by juce::Time::getHighResolutionTicks.
+ * @return  Microseconds since TraceStartTicks.
+ */
+static double TicksToMicroseconds(juce::int64 ticks)
+{
+    return juce::Time::highResolutionTicksToSeconds(ticks - TraceStartTicks) * 1e6;
+}
+
+
+//==============================================================================
+// Class ScopedEvent
+//==============================================================================
+
+ScopedEvent::ScopedEvent(const char* name)
+    :   m_name(name),
+        m_startTicks(juce::Time::getHighResolutionTicks())
+{
+}
+
+ScopedEvent::~ScopedEvent()
+{
+    auto endTicks = juce::Time::getHighResolutionTicks();
+    auto& buffer = GetCurrentThreadBuffer();
+
+    // Only this thread writes the buffer. Publish the event after it is complete.
+    auto numRecorded = buffer.m_numRecorded.load(std::memory_order_relaxed);
+    buffer.m_events[numRecorded % TraceEventsPerThread] = { m_name, m_startTicks, endTicks };
+    buffer.m_numRecorded.store(numRecorded + 1, std::memory_order_release);
+}
+
+
+//==============================================================================
+// Public methods
+//==============================================================================
+
+void WriteChromeJson(juce::OutputStream& stream)
+{
+    std::lock_guard<std::mutex> lock(ThreadBuffersMutex);
+
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first(true);
+    auto separator = [&stream, &first]()
+        {
+            if (!first)
+                stream << ",";
+            stream << juce::newLine;
+            first = false;
+        };
+
+    for (const auto& buffer : ThreadBuffers)
+    {
+        separator();
+        stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->m_threadIdx
+               << ",\"args\":{\"name\":" << juce::JSON::toString(juce::var(buffer->m_threadName)) << "}}";
+
+        auto numRecorded = buffer->m_numRecorded.load(std::memory_order_acquire);
+        auto firstIdx = (numRecorded > TraceEventsPerThread) ? (numRecorded - TraceEventsPerThread) : 0;
+        for (auto eventIdx = firstIdx; eventIdx < numRecorded; eventIdx++)
+        {
+            auto event = buffer->m_events[eventIdx % TraceEventsPerThread];
+
+            // Skip the event if its thread has started overwriting it meanwhile.
+            if (buffer->m_numRecorded.load(std::memory_order_acquire) - eventIdx >= TraceEventsPerThread)
+                continue;
+
+            auto startUs = TicksToMicroseconds(event.m_startTicks);
+            auto durationUs = juce::jmax(0.0, TicksToMicroseconds(event.m_endTicks) - startUs);
+
+            separator();
+            stream << "{\"name\":" << juce::JSON::toString(juce::var(event.m_name)) 
+                   << ",\"cat\":\"aes70\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->m_threadIdx
+                   << ",\"ts\":" << juce::String(startUs, 3) << ",\"dur\":" << juce::String(durationUs, 3) << "}";
+        }
+    }
+
+    stream << juce::newLine << "]}" << juce::newLine;
+}
+
+bool WriteChromeJson(const juce::File& file)
+{
+    juce::FileOutputStream stream(file);
+    if (!stream.openedOk())
+        return false;
+
+    stream.setPosition(0);
+    stream.truncate();
+    WriteChromeJson(stream);
+    stream.flush();
+
+    return stream.getStatus().wasOk();
+}
+
+} // namespace Trace
+
+#endif
@@ -0,0 +1,91 @@
+/*
+===============================================================================
+
+ Copyright (C) 2024 Bernardo Escalona. All Rights Reserved.
+
+  This file is part of AES70_OCP1_StringGenerator, found at:
+  https://github.com/escalonely/AES70_OCP1_StringGenerator
+
+ This library is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License version 3.0 as published
+ by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License
+ along with this library; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Common.h"
+
+
+#if AES70_ENABLE_TRACING
+
+/**
+ * Lightweight tracing of wall time spent in marked scopes (See AES70_TRACE_SCOPE).
+ * Each thread records its events into its own fixed-size ring buffer, so recording takes no locks,
+ * and only the most recent TraceEventsPerThread events of each thread are kept.
+ * All recorded events can be written in the Chrome trace event format, which can be 
+ * opened with Perfetto (https://ui.perfetto.dev) or chrome://tracing.
+ */
+namespace Trace
+{
+
+/**
+ * Records the time from its construction until its destruction as one complete trace event.
+ */
+class ScopedEvent
+{
+public:
+    /**
+     * @param[in] name  Name of the event. Must be a string literal, as only the pointer is stored.
+     */
+    explicit ScopedEvent(const char* name);
+    ~ScopedEvent();
+
+private:
+    const char* m_name;
+    juce::int64 m_startTicks;
+
+    JUCE_DECLARE_NON_COPYABLE(ScopedEvent)
+};
+
+/**
+ * Write all events recorded so far, of all threads, as Chrome trace JSON.
+ * Threads may keep recording meanwhile. Events which their thread overwrites
+ * while they are being written are skipped.
+ *
+ * @param[in] stream    Stream to write to.
+ */
+void WriteChromeJson(juce::OutputStream& stream);
+
+/**
+ * Write all events recorded so far as Chrome trace JSON to the given file, replacing its content.
+ *
+ * @param[in] file  File to write.
+ * @return  True if the file was written successfully.
+ */
+bool WriteChromeJson(const juce::File& file);
+
+} // namespace Trace
+
+/**
+ * Mark the enclosing scope as a trace event with the given name.
+ * Compiles to nothing unless AES70_ENABLE_TRACING is defined as 1.
+ */
+#define AES70_TRACE_SCOPE(name) Trace::ScopedEvent JUCE_JOIN_MACRO(traceScopedEvent, __LINE__)(name)
+
+#else
+
+#define AES70_TRACE_SCOPE(name)
+
+#endif